@@ -0,0 +1,127 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2007 INRIA
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Authors: 
+ *  Mathieu Lacage <mathieu.lacage@sophia.inria.fr>,
+ */
+#ifndef NODE_LIST_H
+#define NODE_LIST_H
+
+#include <vector>
+#include "ns3/ptr.h"
+
+namespace ns3 {
+
+class Node;
+class CallbackBase;
+class Address;
+class NetDevice;
+
+
+/**
+ * \ingroup network
+ *
+ * \brief the list of simulation nodes.
+ *
+ * Every Node created is automatically added to this list.
+ */
+class NodeList
+{
+public:
+  /// Node container iterator
+  typedef std::vector< Ptr<Node> >::const_iterator Iterator;
+
+  /**
+   * \param node node to add
+   * \returns index of node in list.
+   *
+   * This method is called automatically from Node::Node so
+   * the user has little reason to call it himself.
+   */
+  static uint32_t Add (Ptr<Node> node);
+  /**
+   * \returns a C++ iterator located at the beginning of this
+   *          list.
+   */
+  static Iterator Begin (void);
+  /**
+   * \returns a C++ iterator located at the end of this
+   *          list.
+   */
+  static Iterator End (void);
+  /**
+   * \param n index of requested node.
+   * \returns the Node associated to index n.
+   */
+  static Ptr<Node> GetNode (uint32_t n);
+  /**
+   * \returns the number of nodes currently in the list.
+   */
+  static uint32_t GetNNodes (void);
+
+  /**
+   * \param address the address owned by the node
+   * \param node the node
+   *
+   * Record that the given node owns the given (e.g., IP) address, so
+   * that the node can be found by GetNodeByAddress. This method is
+   * called automatically when an address is added to an IPv4 or IPv6
+   * interface, except for the loopback and link-local addresses, which
+   * are shared by all the nodes.
+   */
+  static void AddAddress (const Address &address, Ptr<Node> node);
+  /**
+   * \param address the address no longer owned by the node
+   * \param node the node
+   *
+   * Forget that the given node owns the given address.
+   */
+  static void RemoveAddress (const Address &address, Ptr<Node> node);
+  /**
+   * \param device a device that was just added to its node
+   *
+   * Record the address of the given device, so that its node can be
+   * found by GetNodeByAddress. Since the address of a device may not
+   * be available yet when the device is added to its node, it is
+   * recorded upon the next call to GetNodeByAddress. This method is
+   * called automatically by Node::AddDevice.
+   */
+  static void AddDevice (Ptr<NetDevice> device);
+  /**
+   * \param device a device whose address has changed
+   *
+   * Update the recorded address of the given device. This method is
+   * called by the NetDevice::SetAddress implementations; a device
+   * whose address changes otherwise (e.g., through its MAC layer) is
+   * no longer found by its new address until it calls this method.
+   */
+  static void NotifyAddressChange (Ptr<NetDevice> device);
+  /**
+   * \param address the requested address
+   * \returns the node owning the given address, or 0 if no such node
+   *          is known. If several nodes own the address (e.g., the
+   *          all-zero MAC address of the loopback devices, or an address
+   *          configured twice), the one that registered it first is
+   *          returned.
+   */
+  static Ptr<Node> GetNodeByAddress (const Address &address);
+};
+
+} // namespace ns3
+
+
+#endif /* NODE_LIST_H */
@@ -0,0 +1,121 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef TABLE_BASED_ERROR_RATE_MODEL_H
+#define TABLE_BASED_ERROR_RATE_MODEL_H
+
+#include <vector>
+#include <string>
+#include "error-rate-model.h"
+
+namespace ns3 {
+
+/**
+ * \ingroup wifi
+ *
+ * An error rate model that looks up the packet error rate (PER) of a
+ * reference frame size in precomputed SNR-to-PER tables, e.g., link-to-system
+ * mapping tables obtained from link-level simulations or measurement traces,
+ * instead of computing bit error probabilities. This abstraction is meant for
+ * system-level simulations with many nodes, where the cost of the error model
+ * matters more than the fidelity of the PHY.
+ *
+ * The tables are read from the file given by the TableFile attribute, whose
+ * lines have the format "<mode> <SNR (dB)> <PER>", where mode is the unique
+ * name of a WifiMode (e.g., OfdmRate6Mbps or VhtMcs7). Empty lines and lines
+ * starting with '#' are ignored. The PER of an SNR between two points of a
+ * table is interpolated linearly in dB, and the PER beyond the first (last)
+ * point is the PER of the first (last) point.
+ *
+ * The success rate of a chunk of nbits bits is (1 - PER)^(nbits / L), where
+ * L is the number of bits of the reference frame size. The modes without a
+ * table are handled by the fallback error rate model.
+ */
+class TableBasedErrorRateModel : public ErrorRateModel
+{
+public:
+  /**
+   * \brief Get the type ID.
+   * \return the object TypeId
+   */
+  static TypeId GetTypeId (void);
+
+  TableBasedErrorRateModel ();
+  virtual ~TableBasedErrorRateModel ();
+
+  double GetChunkSuccessRate (WifiMode mode, WifiTxVector txVector, double snr, uint64_t nbits) const;
+
+  /**
+   * Add a point to the table of the given mode.
+   *
+   * \param mode the Wi-Fi mode
+   * \param snrDb the SNR (dB)
+   * \param per the PER of a frame of the reference size at this SNR
+   */
+  void AddPoint (WifiMode mode, double snrDb, double per);
+  /**
+   * Read the tables of a file, in addition to the points already added.
+   *
+   * \param fileName the name of the file
+   */
+  void LoadTables (std::string fileName);
+  /**
+   * \param mode the Wi-Fi mode
+   * \return true if a table is available for the given mode
+   */
+  bool HasTable (WifiMode mode) const;
+  /**
+   * \param mode the Wi-Fi mode, which must have a table
+   * \param snrDb the SNR (dB)
+   * \return the interpolated PER of a frame of the reference size
+   */
+  double GetPer (WifiMode mode, double snrDb) const;
+
+private:
+  /**
+   * Discard the tables and read the tables of the given file, if any.
+   *
+   * \param fileName the name of the file to read the tables from
+   */
+  void SetTableFile (std::string fileName);
+  /**
+   * \return the name of the file the tables were read from
+   */
+  std::string GetTableFile (void) const;
+
+  /// A point of a table
+  struct Point
+  {
+    double snrDb; //!< the SNR (dB)
+    double per;   //!< the PER of a frame of the reference size
+  };
+
+  /**
+   * \param point the point
+   * \param snrDb the SNR (dB)
+   * \return true if the SNR of the point is lower than snrDb
+   */
+  static bool IsBelow (const Point &point, double snrDb);
+
+  std::vector<std::vector<Point> > m_tables; //!< the tables, sorted by SNR and indexed by the UID of the modes
+  std::string m_tableFile;                   //!< the file the tables were read from
+  uint32_t m_referenceSize;                  //!< the frame size (bytes) the PERs refer to
+  Ptr<ErrorRateModel> m_fallback;            //!< the error rate model of the modes without a table
+};
+
+} //namespace ns3
+
+#endif /* TABLE_BASED_ERROR_RATE_MODEL_H */
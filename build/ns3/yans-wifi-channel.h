@@ -0,0 +1,204 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2006,2007 INRIA
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Mathieu Lacage, <mathieu.lacage@sophia.inria.fr>
+ */
+
+#ifndef YANS_WIFI_CHANNEL_H
+#define YANS_WIFI_CHANNEL_H
+
+#include <map>
+#include "ns3/channel.h"
+#include "ns3/nstime.h"
+#include "ns3/vector.h"
+
+namespace ns3 {
+
+class NetDevice;
+class PropagationLossModel;
+class PropagationDelayModel;
+class MobilityModel;
+class YansWifiPhy;
+class Packet;
+
+/**
+ * \brief a channel to interconnect ns3::YansWifiPhy objects.
+ * \ingroup wifi
+ *
+ * This class is expected to be used in tandem with the ns3::YansWifiPhy
+ * class and supports an ns3::PropagationLossModel and an
+ * ns3::PropagationDelayModel.  By default, no propagation models are set;
+ * it is the caller's responsibility to set them before using the channel.
+ *
+ * In large scenarios, most receivers are far beyond the interference
+ * range of a transmitter. The MaxRange attribute can be used to skip them
+ * altogether: when it is set, the PHYs are kept in a grid of square cells
+ * of MaxRange meters, built from the positions of their mobility models
+ * and updated upon course changes, so that each transmission only visits
+ * the PHYs located in the neighbouring cells. The MaxLossDb attribute
+ * can be used in addition to drop the signals which are too attenuated
+ * to be of any interest to the receivers.
+ */
+class YansWifiChannel : public Channel
+{
+public:
+  /**
+   * \brief Get the type ID.
+   * \return the object TypeId
+   */
+  static TypeId GetTypeId (void);
+
+  YansWifiChannel ();
+  virtual ~YansWifiChannel ();
+
+  //inherited from Channel.
+  virtual std::size_t GetNDevices (void) const;
+  virtual Ptr<NetDevice> GetDevice (std::size_t i) const;
+
+  /**
+   * Adds the given YansWifiPhy to the PHY list
+   *
+   * \param phy the YansWifiPhy to be added to the PHY list
+   */
+  void Add (Ptr<YansWifiPhy> phy);
+
+  /**
+   * \param loss the new propagation loss model.
+   */
+  void SetPropagationLossModel (const Ptr<PropagationLossModel> loss);
+  /**
+   * \param delay the new propagation delay model.
+   */
+  void SetPropagationDelayModel (const Ptr<PropagationDelayModel> delay);
+
+  /**
+   * \param sender the phy object from which the packet is originating.
+   * \param packet the packet to send
+   * \param txPowerDbm the tx power associated to the packet, in dBm
+   * \param duration the transmission duration associated with the packet
+   *
+   * This method should not be invoked by normal users. It is
+   * currently invoked only from YansWifiPhy::StartTx.  The channel
+   * attempts to deliver the packet to all other YansWifiPhy objects
+   * on the channel (except for the sender).
+   */
+  void Send (Ptr<YansWifiPhy> sender, Ptr<const Packet> packet, double txPowerDbm, Time duration) const;
+
+  /**
+   * Assign a fixed random variable stream number to the random variables
+   * used by this model.  Return the number of streams (possibly zero) that
+   * have been assigned.
+   *
+   * \param stream first stream index to use
+   *
+   * \return the number of stream indices assigned by this model
+   */
+  int64_t AssignStreams (int64_t stream);
+
+
+protected:
+  virtual void DoDispose (void);
+
+private:
+  /**
+   * A vector of pointers to YansWifiPhy.
+   */
+  typedef std::vector<Ptr<YansWifiPhy> > PhyList;
+
+  /// Coordinates of a grid cell
+  typedef std::pair<int64_t, int64_t> Cell;
+  /// Indices of the PHYs located in each (non empty) grid cell
+  typedef std::map<Cell, std::vector<uint32_t> > Grid;
+
+  /**
+   * \param position a position
+   * \return the grid cell containing the given position
+   */
+  Cell GetCell (const Vector &position) const;
+  /**
+   * Rebuild the grid from the current positions of all the PHYs, if it
+   * was never built, if PHYs were added since it was built, or if the
+   * nodes may have drifted too far away from their cell.
+   */
+  void UpdateGrid (void) const;
+  /**
+   * Move the given PHY to the grid cell of its current position.
+   *
+   * \param i the index of the PHY in the PHY list
+   */
+  void UpdateCell (uint32_t i) const;
+  /**
+   * Get the indices, in increasing order, of the PHYs that may be within
+   * MaxRange meters of the given position.
+   *
+   * \param position the position of the transmitter
+   * \param receivers the vector the indices of the PHYs are appended to
+   */
+  void GetCandidateReceivers (const Vector &position, std::vector<uint32_t> &receivers) const;
+  /**
+   * Callback invoked when the mobility model of a PHY changes course.
+   *
+   * \param channel the channel
+   * \param i the index of the PHY in the PHY list
+   * \param mobility the mobility model of the PHY
+   */
+  static void CourseChanged (const YansWifiChannel *channel, uint32_t i, Ptr<const MobilityModel> mobility);
+
+  /**
+   * This method is scheduled by Send for each associated YansWifiPhy.
+   * The method then calls the corresponding YansWifiPhy that the first
+   * bit of the packet has arrived.
+   *
+   * \param receiver the device to which the packet is destined
+   * \param packet the packet being sent
+   * \param txPowerDbm the tx power associated to the packet being sent (dBm)
+   * \param duration the transmission duration associated with the packet being sent
+   */
+  static void Receive (Ptr<YansWifiPhy> receiver, Ptr<Packet> packet, double txPowerDbm, Time duration);
+
+  /**
+   * Deliver the given packet to the given receiver, unless the propagation
+   * loss exceeds MaxLossDb.
+   *
+   * \param senderMobility the mobility model of the sender
+   * \param receiver the phy object the packet is delivered to
+   * \param receiverMobility the mobility model of the receiver
+   * \param packet the packet to send
+   * \param txPowerDbm the tx power associated to the packet, in dBm
+   * \param rxPowerDbm the rx power at the receiver, in dBm
+   * \param duration the transmission duration associated with the packet
+   */
+  void SendTo (Ptr<MobilityModel> senderMobility, Ptr<YansWifiPhy> receiver, Ptr<MobilityModel> receiverMobility,
+               Ptr<const Packet> packet, double txPowerDbm, double rxPowerDbm, Time duration) const;
+
+  PhyList m_phyList;                   //!< List of YansWifiPhys connected to this YansWifiChannel
+  Ptr<PropagationLossModel> m_loss;    //!< Propagation loss model
+  Ptr<PropagationDelayModel> m_delay;  //!< Propagation delay model
+  double m_maxRange;                   //!< maximum distance to a receiver (m), or 0 if unlimited
+  double m_maxLossDb;                  //!< maximum loss to a receiver (dB)
+
+  mutable Grid m_grid;                 //!< the PHYs indexed by grid cell
+  mutable std::vector<Cell> m_cells;   //!< the grid cell of each PHY
+  mutable std::vector<Ptr<MobilityModel> > m_mobilities; //!< the mobility models whose course changes are tracked
+  mutable bool m_gridValid;            //!< whether the grid is up to date
+  mutable Time m_gridTime;             //!< the time the grid was last rebuilt
+  mutable double m_maxSpeed;           //!< the maximum speed of a node since the grid was rebuilt (m/s)
+};
+
+} //namespace ns3
+
+#endif /* YANS_WIFI_CHANNEL_H */
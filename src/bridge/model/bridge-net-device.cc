@@ -17,6 +17,7 @@
  */
 #include "bridge-net-device.h"
 #include "ns3/node.h"
+#include "ns3/node-list.h"
 #include "ns3/channel.h"
 #include "ns3/packet.h"
 #include "ns3/log.h"
@@ -291,6 +292,7 @@ BridgeNetDevice::SetAddress (Address address)
 {
   NS_LOG_FUNCTION_NOARGS ();
   m_address = Mac48Address::ConvertFrom (address);
+  NodeList::NotifyAddressChange (this);
 }
 
 Address 
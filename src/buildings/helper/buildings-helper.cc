@@ -55,6 +55,7 @@ BuildingsHelper::Install (Ptr<Node> node)
     }
   Ptr<MobilityBuildingInfo> buildingInfo = CreateObject<MobilityBuildingInfo> ();
   model->AggregateObject (buildingInfo);
+  model->TraceConnectWithoutContext ("CourseChange", MakeCallback (&BuildingsHelper::CourseChanged));
 }
 
 
@@ -79,23 +80,19 @@ void
 BuildingsHelper::MakeConsistent (Ptr<MobilityModel> mm)
 {
   Ptr<MobilityBuildingInfo> bmm = mm->GetObject<MobilityBuildingInfo> ();
-  bool found = false;
-  for (BuildingList::Iterator bit = BuildingList::Begin (); bit != BuildingList::End (); ++bit)
+  Vector pos = mm->GetPosition ();
+  std::vector<Ptr<Building> > buildings = BuildingList::GetBuildingsAt (pos);
+  NS_ABORT_MSG_UNLESS (buildings.size () <= 1, " MobilityBuildingInfo already inside another building!");
+  if (!buildings.empty ())
     {
-      NS_LOG_LOGIC ("checking building " << (*bit)->GetId () << " with boundaries " << (*bit)->GetBoundaries ());
-      Vector pos = mm->GetPosition ();
-      if ((*bit)->IsInside (pos))
-        {
-          NS_LOG_LOGIC ("MobilityBuildingInfo " << bmm << " pos " << mm->GetPosition () << " falls inside building " << (*bit)->GetId ());
-          NS_ABORT_MSG_UNLESS (found == false, " MobilityBuildingInfo already inside another building!");		
-          found = true;
-          uint16_t floor = (*bit)->GetFloor (pos);
-          uint16_t roomX = (*bit)->GetRoomX (pos);
-          uint16_t roomY = (*bit)->GetRoomY (pos);	   
-          bmm->SetIndoor (*bit, floor, roomX, roomY);	      
-        }		    	  
+      Ptr<Building> building = buildings.front ();
+      NS_LOG_LOGIC ("MobilityBuildingInfo " << bmm << " pos " << pos << " falls inside building " << building->GetId ());
+      uint16_t floor = building->GetFloor (pos);
+      uint16_t roomX = building->GetRoomX (pos);
+      uint16_t roomY = building->GetRoomY (pos);
+      bmm->SetIndoor (building, floor, roomX, roomY);
     }
-  if (!found)
+  else
     {
       NS_LOG_LOGIC ("MobilityBuildingInfo " << bmm << " pos " << mm->GetPosition ()  << " is outdoor");
       bmm->SetOutdoor ();
@@ -103,4 +100,10 @@ BuildingsHelper::MakeConsistent (Ptr<MobilityModel> mm)
 
 }
 
+void
+BuildingsHelper::CourseChanged (Ptr<const MobilityModel> mm)
+{
+  MakeConsistent (ConstCast<MobilityModel> (mm));
+}
+
 } // namespace ns3
@@ -37,7 +37,9 @@ class BuildingsHelper
 {
 public:
   /**
-  * Install the MobilityBuildingInfo to a node
+  * Install the MobilityBuildingInfo to a node. The MobilityBuildingInfo
+  * is then made consistent automatically whenever the mobility model
+  * notifies a course change.
   *
   * \param node the mobility model of the node to be updated
   */
@@ -63,7 +65,15 @@ public:
   * \param bmm the mobility model to be made consistent
   */
   static void MakeConsistent (Ptr<MobilityModel> bmm);
-  
+
+private:
+  /**
+  * Make the mobility model of a node installed by Install consistent
+  * upon a course change.
+  *
+  * \param mm the mobility model which notified a course change
+  */
+  static void CourseChanged (Ptr<const MobilityModel> mm);
 };
 
 
@@ -27,6 +27,9 @@
 #include "ns3/assert.h"
 #include "building-list.h"
 #include "building.h"
+#include <map>
+#include <cmath>
+#include <algorithm>
 
 namespace ns3 {
 
@@ -47,16 +50,41 @@ public:
   BuildingList::Iterator End (void) const;
   Ptr<Building> GetBuilding (uint32_t n);
   uint32_t GetNBuildings (void);
+  std::vector<Ptr<Building> > GetBuildingsAt (const Vector &position);
+  void InvalidateGrid (void);
 
   static Ptr<BuildingListPriv> Get (void);
 
 private:
+  /// Coordinates of a grid cell
+  typedef std::pair<int64_t, int64_t> Cell;
+  /// Indices of the buildings overlapping each (non empty) grid cell
+  typedef std::map<Cell, std::vector<uint32_t> > Grid;
+
   virtual void DoDispose (void);
   static Ptr<BuildingListPriv> *DoGet (void);
   static void Delete (void);
+  /**
+   * \param x the x coordinate
+   * \param y the y coordinate
+   * \returns the coordinates of the grid cell containing the given point
+   */
+  Cell GetCell (double x, double y) const;
+  /**
+   * Rebuild the grid from the boundaries of all the buildings.
+   */
+  void UpdateGrid (void);
+
   std::vector<Ptr<Building> > m_buildings;
+  Grid m_grid;                       //!< the buildings indexed by grid cell
+  std::vector<uint32_t> m_unbounded; //!< the buildings too large to be indexed in the grid
+  double m_cellSize;                 //!< the side of the grid cells (m)
+  bool m_gridValid;                  //!< whether the grid is up to date
 };
 
+/// Maximum number of grid cells a building can span
+static const double MAX_BUILDING_CELLS = 1024;
+
 NS_OBJECT_ENSURE_REGISTERED (BuildingListPriv);
 
 TypeId
@@ -100,6 +128,8 @@ BuildingListPriv::Delete (void)
 
 
 BuildingListPriv::BuildingListPriv ()
+  : m_cellSize (1),
+    m_gridValid (false)
 {
   NS_LOG_FUNCTION_NOARGS ();
 }
@@ -118,6 +148,9 @@ BuildingListPriv::DoDispose (void)
       *i = 0;
     }
   m_buildings.erase (m_buildings.begin (), m_buildings.end ());
+  m_grid.clear ();
+  m_unbounded.clear ();
+  m_gridValid = false;
   Object::DoDispose ();
 }
 
@@ -127,6 +160,7 @@ BuildingListPriv::Add (Ptr<Building> building)
 {
   uint32_t index = m_buildings.size ();
   m_buildings.push_back (building);
+  m_gridValid = false;
   Simulator::ScheduleWithContext (index, TimeStep (0), &Building::Initialize, building);
   return index;
 
@@ -155,6 +189,99 @@ BuildingListPriv::GetBuilding (uint32_t n)
   return m_buildings.at (n);
 }
 
+void
+BuildingListPriv::InvalidateGrid (void)
+{
+  m_gridValid = false;
+}
+
+BuildingListPriv::Cell
+BuildingListPriv::GetCell (double x, double y) const
+{
+  return Cell (static_cast<int64_t> (std::floor (x / m_cellSize)),
+               static_cast<int64_t> (std::floor (y / m_cellSize)));
+}
+
+void
+BuildingListPriv::UpdateGrid (void)
+{
+  NS_LOG_FUNCTION (this);
+  m_grid.clear ();
+  m_unbounded.clear ();
+  // the cells are as large as the median building, so that a typical
+  // building overlaps a few cells and a cell a few buildings
+  std::vector<double> sizes;
+  for (std::vector<Ptr<Building> >::const_iterator i = m_buildings.begin (); i != m_buildings.end (); i++)
+    {
+      Box box = (*i)->GetBoundaries ();
+      double size = std::max (box.xMax - box.xMin, box.yMax - box.yMin);
+      if (size > 0 && std::isfinite (size))
+        {
+          sizes.push_back (size);
+        }
+    }
+  m_cellSize = 1;
+  if (!sizes.empty ())
+    {
+      std::nth_element (sizes.begin (), sizes.begin () + sizes.size () / 2, sizes.end ());
+      m_cellSize = sizes[sizes.size () / 2];
+    }
+  for (uint32_t n = 0; n < m_buildings.size (); n++)
+    {
+      Box box = m_buildings[n]->GetBoundaries ();
+      double nCellsX = std::floor (box.xMax / m_cellSize) - std::floor (box.xMin / m_cellSize) + 1;
+      double nCellsY = std::floor (box.yMax / m_cellSize) - std::floor (box.yMin / m_cellSize) + 1;
+      if (!(nCellsX * nCellsY <= MAX_BUILDING_CELLS))
+        {
+          // also catches infinite or NaN boundaries
+          m_unbounded.push_back (n);
+          continue;
+        }
+      Cell min = GetCell (box.xMin, box.yMin);
+      Cell max = GetCell (box.xMax, box.yMax);
+      for (int64_t x = min.first; x <= max.first; x++)
+        {
+          for (int64_t y = min.second; y <= max.second; y++)
+            {
+              m_grid[Cell (x, y)].push_back (n);
+            }
+        }
+    }
+  NS_LOG_DEBUG ("cell size " << m_cellSize << "m, " << m_grid.size () << " cells, "
+                << m_unbounded.size () << " buildings not indexed");
+  m_gridValid = true;
+}
+
+std::vector<Ptr<Building> >
+BuildingListPriv::GetBuildingsAt (const Vector &position)
+{
+  NS_LOG_FUNCTION (this << position);
+  if (!m_gridValid)
+    {
+      UpdateGrid ();
+    }
+  std::vector<uint32_t> candidates (m_unbounded);
+  if (std::isfinite (position.x / m_cellSize) && std::isfinite (position.y / m_cellSize)
+      && std::abs (position.x / m_cellSize) < 1e15 && std::abs (position.y / m_cellSize) < 1e15)
+    {
+      Grid::const_iterator it = m_grid.find (GetCell (position.x, position.y));
+      if (it != m_grid.end ())
+        {
+          candidates.insert (candidates.end (), it->second.begin (), it->second.end ());
+          std::inplace_merge (candidates.begin (), candidates.begin () + m_unbounded.size (), candidates.end ());
+        }
+    }
+  std::vector<Ptr<Building> > buildings;
+  for (std::vector<uint32_t>::const_iterator i = candidates.begin (); i != candidates.end (); i++)
+    {
+      if (m_buildings[*i]->IsInside (position))
+        {
+          buildings.push_back (m_buildings[*i]);
+        }
+    }
+  return buildings;
+}
+
 }
 
 /**
@@ -189,5 +316,15 @@ BuildingList::GetNBuildings (void)
 {
   return BuildingListPriv::Get ()->GetNBuildings ();
 }
+std::vector<Ptr<Building> >
+BuildingList::GetBuildingsAt (const Vector &position)
+{
+  return BuildingListPriv::Get ()->GetBuildingsAt (position);
+}
+void
+BuildingList::NotifyBoundariesChanged (void)
+{
+  BuildingListPriv::Get ()->InvalidateGrid ();
+}
 
 } // namespace ns3
@@ -25,6 +25,7 @@
 
 #include <vector>
 #include "ns3/ptr.h"
+#include "ns3/vector.h"
 
 namespace ns3 {
 
@@ -62,6 +63,22 @@ public:
    * \returns the number of buildings currently in the list.
    */
   static uint32_t GetNBuildings (void);
+  /**
+   * \param position a position
+   * \returns the buildings whose boundaries contain the given position,
+   *          in increasing order of index.
+   *
+   * The buildings are looked up in a uniform grid over their boundaries,
+   * which is built upon the first call and rebuilt after a building is
+   * added or its boundaries change.
+   */
+  static std::vector<Ptr<Building> > GetBuildingsAt (const Vector &position);
+  /**
+   * Notify that the boundaries of a building changed, so that the grid
+   * used by GetBuildingsAt is rebuilt. This method is called automatically
+   * from Building::SetBoundaries.
+   */
+  static void NotifyBoundariesChanged (void);
 };
 
 } // namespace ns3
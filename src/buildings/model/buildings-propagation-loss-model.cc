@@ -153,33 +153,25 @@ const
     Ptr<MobilityBuildingInfo> b1 = b->GetObject <MobilityBuildingInfo> ();
     NS_ASSERT_MSG ((a1 != 0) && (b1 != 0), "BuildingsPropagationLossModel only works with MobilityBuildingInfo");
   
-  std::map<Ptr<MobilityModel>,  std::map<Ptr<MobilityModel>, ShadowingLoss> >::iterator ait = m_shadowingLossMap.find (a);
-  if (ait != m_shadowingLossMap.end ())
+  std::pair<Ptr<MobilityModel>, Ptr<MobilityModel> > link (a, b);
+  std::unordered_map<std::pair<Ptr<MobilityModel>, Ptr<MobilityModel> >, ShadowingLoss, LinkHash>::const_iterator it = m_shadowingLossMap.find (link);
+  if (it != m_shadowingLossMap.end ())
     {
-      std::map<Ptr<MobilityModel>, ShadowingLoss>::iterator bit = ait->second.find (b);
-      if (bit != ait->second.end ())
-        {
-          return (bit->second.GetLoss ());
-        }
-      else
-        {
-          double sigma = EvaluateSigma (a1, b1);
-          // side effect: will create new entry          
-          // sigma is standard deviation, not variance
-          double shadowingValue = m_randVariable->GetValue (0.0, (sigma*sigma));
-          ait->second[b] = ShadowingLoss (shadowingValue, b);          
-          return (ait->second[b].GetLoss ());
-        }
-    }
-  else
-    {
-      double sigma = EvaluateSigma (a1, b1);
-      // side effect: will create new entries in both maps
-      // sigma is standard deviation, not variance
-      double shadowingValue = m_randVariable->GetValue (0.0, (sigma*sigma));
-      m_shadowingLossMap[a][b] = ShadowingLoss (shadowingValue, b);  
-      return (m_shadowingLossMap[a][b].GetLoss ());       
+      return (it->second.GetLoss ());
     }
+  double sigma = EvaluateSigma (a1, b1);
+  // side effect: will create new entry
+  // sigma is standard deviation, not variance
+  double shadowingValue = m_randVariable->GetValue (0.0, (sigma*sigma));
+  it = m_shadowingLossMap.insert (std::make_pair (link, ShadowingLoss (shadowingValue, b))).first;
+  return (it->second.GetLoss ());
+}
+
+std::size_t
+BuildingsPropagationLossModel::LinkHash::operator() (const std::pair<Ptr<MobilityModel>, Ptr<MobilityModel> > &link) const
+{
+  std::size_t h = std::hash<MobilityModel *> () (PeekPointer (link.first));
+  return h ^ (std::hash<MobilityModel *> () (PeekPointer (link.second)) + 0x9e3779b9 + (h << 6) + (h >> 2));
 }
 
 
@@ -226,5 +218,11 @@ BuildingsPropagationLossModel::DoAssignStreams (int64_t stream)
   return 1;
 }
 
+bool
+BuildingsPropagationLossModel::DoIsDeterministic (void) const
+{
+  return true;
+}
+
 
 } // namespace ns3
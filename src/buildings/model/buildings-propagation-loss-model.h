@@ -28,6 +28,7 @@
 #include "ns3/random-variable-stream.h"
 #include <ns3/building.h>
 #include <ns3/mobility-building-info.h>
+#include <unordered_map>
 
 
 
@@ -93,7 +94,18 @@ protected:
     Ptr<MobilityModel> m_receiver;
   };
 
-  mutable std::map<Ptr<MobilityModel>,  std::map<Ptr<MobilityModel>, ShadowingLoss> > m_shadowingLossMap;
+  /// Hash function for a (source, destination) pair of mobility models
+  struct LinkHash
+  {
+    /**
+     * \param link the (source, destination) pair
+     * \return the hash of the pair
+     */
+    std::size_t operator() (const std::pair<Ptr<MobilityModel>, Ptr<MobilityModel> > &link) const;
+  };
+
+  /// The shadowing loss of each (source, destination) pair, drawn upon the first call
+  mutable std::unordered_map<std::pair<Ptr<MobilityModel>, Ptr<MobilityModel> >, ShadowingLoss, LinkHash> m_shadowingLossMap;
   double EvaluateSigma (Ptr<MobilityBuildingInfo> a, Ptr<MobilityBuildingInfo> b) const;
 
 
@@ -103,6 +115,15 @@ protected:
   Ptr<NormalRandomVariable> m_randVariable;
 
   virtual int64_t DoAssignStreams (int64_t stream);
+  /**
+   * The loss only depends on the positions of the nodes and on their
+   * MobilityBuildingInfo (which BuildingsHelper updates upon course changes),
+   * and the shadowing of a link is drawn once and for all, hence the
+   * reception power can be cached.
+   *
+   * \return true
+   */
+  virtual bool DoIsDeterministic (void) const;
 };
 
 }
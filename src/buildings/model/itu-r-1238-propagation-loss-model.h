@@ -58,6 +58,7 @@ private:
                                 Ptr<MobilityModel> a,
                                 Ptr<MobilityModel> b) const;
   virtual int64_t DoAssignStreams (int64_t stream);
+  virtual bool DoIsDeterministic (void) const;
   
   double m_frequency; ///< frequency in MHz
 
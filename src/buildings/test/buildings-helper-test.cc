@@ -25,7 +25,9 @@
 #include <ns3/mobility-building-info.h>
 #include <ns3/constant-position-mobility-model.h>
 #include <ns3/building.h>
+#include <ns3/building-list.h>
 #include <ns3/buildings-helper.h>
+#include <ns3/random-variable-stream.h>
 #include <ns3/mobility-helper.h>
 #include <ns3/simulator.h>
 
@@ -173,6 +175,101 @@ BuildingsHelperOneTestCase::DoRun ()
 
 
 
+/**
+ * Test the lookup of the buildings containing a position through the grid
+ * of BuildingList, against a scan of all the buildings, and the automatic
+ * update of MobilityBuildingInfo upon course changes.
+ */
+class BuildingsHelperGridTestCase : public TestCase
+{
+public:
+  BuildingsHelperGridTestCase ();
+
+private:
+  virtual void DoRun (void);
+  /**
+   * Check the buildings returned by BuildingList::GetBuildingsAt
+   * \param position the position
+   */
+  void CheckBuildingsAt (Vector position);
+};
+
+BuildingsHelperGridTestCase::BuildingsHelperGridTestCase ()
+  : TestCase ("BuildingList grid and automatic consistency")
+{
+}
+
+void
+BuildingsHelperGridTestCase::CheckBuildingsAt (Vector position)
+{
+  std::vector<Ptr<Building> > expected;
+  for (BuildingList::Iterator bit = BuildingList::Begin (); bit != BuildingList::End (); ++bit)
+    {
+      if ((*bit)->IsInside (position))
+        {
+          expected.push_back (*bit);
+        }
+    }
+  std::vector<Ptr<Building> > buildings = BuildingList::GetBuildingsAt (position);
+  NS_TEST_ASSERT_MSG_EQ (buildings.size (), expected.size (), "wrong number of buildings at " << position);
+  for (uint32_t i = 0; i < buildings.size (); i++)
+    {
+      NS_TEST_ASSERT_MSG_EQ (buildings[i]->GetId (), expected[i]->GetId (), "wrong building at " << position);
+    }
+}
+
+void
+BuildingsHelperGridTestCase::DoRun ()
+{
+  Ptr<UniformRandomVariable> random = CreateObject<UniformRandomVariable> ();
+  random->SetStream (1);
+  // a city block layout with buildings of various sizes, a few of them overlapping
+  for (uint32_t i = 0; i < 400; i++)
+    {
+      double x = (i % 20) * 50.0;
+      double y = (i / 20) * 50.0;
+      Ptr<Building> b = CreateObject<Building> ();
+      b->SetBoundaries (Box (x, x + random->GetValue (5, 80), y, y + random->GetValue (5, 80), 0, random->GetValue (3, 30)));
+    }
+  // a building spanning the whole area, above the others
+  Ptr<Building> large = CreateObject<Building> ();
+  large->SetBoundaries (Box (-1e6, 1e6, -1e6, 1e6, 100, 200));
+
+  for (uint32_t i = 0; i < 2000; i++)
+    {
+      CheckBuildingsAt (Vector (random->GetValue (-100, 1100), random->GetValue (-100, 1100), random->GetValue (0, 150)));
+    }
+  // positions on the walls of a building
+  Box box = BuildingList::GetBuilding (42)->GetBoundaries ();
+  CheckBuildingsAt (Vector (box.xMin, box.yMin, box.zMin));
+  CheckBuildingsAt (Vector (box.xMax, box.yMax, box.zMax));
+
+  // the grid is rebuilt when a building moves
+  Ptr<Building> moved = BuildingList::GetBuilding (7);
+  moved->SetBoundaries (Box (2000, 2010, 2000, 2010, 0, 10));
+  CheckBuildingsAt (Vector (2005, 2005, 5));
+  CheckBuildingsAt (Vector (355, 5, 1));
+
+  // the MobilityBuildingInfo of installed nodes follows their course changes
+  Ptr<Building> isolated = CreateObject<Building> ();
+  isolated->SetBoundaries (Box (-500, -400, -500, -400, 0, 10));
+  NodeContainer nodes;
+  nodes.Create (1);
+  MobilityHelper mobility;
+  mobility.SetMobilityModel ("ns3::ConstantPositionMobilityModel");
+  mobility.Install (nodes);
+  BuildingsHelper::Install (nodes);
+  Ptr<MobilityModel> mm = nodes.Get (0)->GetObject<MobilityModel> ();
+  Ptr<MobilityBuildingInfo> buildingInfo = mm->GetObject<MobilityBuildingInfo> ();
+  mm->SetPosition (Vector (-450, -450, 1.5));
+  NS_TEST_ASSERT_MSG_EQ (buildingInfo->IsIndoor (), true, "the node should be indoor after moving into a building");
+  NS_TEST_ASSERT_MSG_EQ (buildingInfo->GetBuilding ()->GetId (), isolated->GetId (), "wrong building");
+  mm->SetPosition (Vector (-300, -450, 1.5));
+  NS_TEST_ASSERT_MSG_EQ (buildingInfo->IsOutdoor (), true, "the node should be outdoor after leaving the building");
+
+  Simulator::Destroy ();
+}
+
 class BuildingsHelperTestSuite : public TestSuite
 {
 public:
@@ -321,6 +418,8 @@ BuildingsHelperTestSuite::BuildingsHelperTestSuite ()
   q7.pos = vq7;
   q7.indoor = false;
   AddTestCase (new BuildingsHelperOneTestCase (q7, b2), TestCase::QUICK);     
+
+  AddTestCase (new BuildingsHelperGridTestCase, TestCase::QUICK);
 }
 
 static BuildingsHelperTestSuite buildingsHelperAntennaTestSuiteInstance;
@@ -184,6 +184,13 @@ public:
    */
   static uint32_t GetContext (void);
 
+  /**
+   * Get the number of events executed so far.
+   *
+   * @return The number of events executed since the simulator was created.
+   */
+  static uint64_t GetEventCount (void);
+
   /**
    * Context enum values.
    *
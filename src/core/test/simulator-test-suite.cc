@@ -133,7 +133,9 @@ SimulatorEventsTestCase::DoRun (void)
   NS_TEST_EXPECT_MSG_EQ (!a.IsExpired (), true, "");
   Simulator::Cancel (a);
   NS_TEST_EXPECT_MSG_EQ (a.IsExpired (), true, "");
+  uint64_t eventCount = Simulator::GetEventCount ();
   Simulator::Run ();
+  NS_TEST_EXPECT_MSG_GT_OR_EQ (Simulator::GetEventCount (), eventCount + 3, "Events B, C and D should have been counted");
   NS_TEST_EXPECT_MSG_EQ (m_a, true, "Event A did not run ?");
   NS_TEST_EXPECT_MSG_EQ (m_b, true, "Event B did not run ?");
   NS_TEST_EXPECT_MSG_EQ (m_c, true, "Event C did not run ?");
@@ -33,6 +33,7 @@
 #include "csma-net-device.h"
 #include "csma-channel.h"
 #include "ns3/net-device-queue-interface.h"
+#include "ns3/node-list.h"
 
 namespace ns3 {
 
@@ -897,6 +898,7 @@ CsmaNetDevice::SetAddress (Address address)
 {
   NS_LOG_FUNCTION_NOARGS ();
   m_address = Mac48Address::ConvertFrom (address);
+  NodeList::NotifyAddressChange (this);
 }
 
 Address
@@ -362,18 +362,7 @@ DsrOptions::GetIDfromIP (Ipv4Address address)
 Ptr<Node> DsrOptions::GetNodeWithAddress (Ipv4Address ipv4Address)
 {
   NS_LOG_FUNCTION (this << ipv4Address);
-  int32_t nNodes = NodeList::GetNNodes ();
-  for (int32_t i = 0; i < nNodes; ++i)
-    {
-      Ptr<Node> node = NodeList::GetNode (i);
-      Ptr<Ipv4> ipv4 = node->GetObject<Ipv4> ();
-      int32_t ifIndex = ipv4->GetInterfaceForAddress (ipv4Address);
-      if (ifIndex != -1)
-        {
-          return node;
-        }
-    }
-  return 0;
+  return NodeList::GetNodeByAddress (ipv4Address);
 }
 
 NS_OBJECT_ENSURE_REGISTERED (DsrOptionPad1);
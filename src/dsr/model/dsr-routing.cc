@@ -625,18 +625,7 @@ Ptr<Node>
 DsrRouting::GetNodeWithAddress (Ipv4Address ipv4Address)
 {
   NS_LOG_FUNCTION (this << ipv4Address);
-  int32_t nNodes = NodeList::GetNNodes ();
-  for (int32_t i = 0; i < nNodes; ++i)
-    {
-      Ptr<Node> node = NodeList::GetNode (i);
-      Ptr<Ipv4> ipv4 = node->GetObject<Ipv4> ();
-      int32_t ifIndex = ipv4->GetInterfaceForAddress (ipv4Address);
-      if (ifIndex != -1)
-        {
-          return node;
-        }
-    }
-  return 0;
+  return NodeList::GetNodeByAddress (ipv4Address);
 }
 
 bool DsrRouting::IsLinkCache ()
@@ -35,6 +35,7 @@
 #include "ns3/string.h"
 #include "ns3/trace-source-accessor.h"
 #include "ns3/uinteger.h"
+#include "ns3/node-list.h"
 
 #include <unistd.h>
 #include <arpa/inet.h>
@@ -612,6 +613,7 @@ void
 FdNetDevice::SetAddress (Address address)
 {
   m_address = Mac48Address::ConvertFrom (address);
+  NodeList::NotifyAddressChange (this);
 }
 
 Address
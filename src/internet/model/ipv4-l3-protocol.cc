@@ -24,6 +24,7 @@
 #include "ns3/ipv4-address.h"
 #include "ns3/ipv4-route.h"
 #include "ns3/node.h"
+#include "ns3/node-list.h"
 #include "ns3/socket.h"
 #include "ns3/net-device.h"
 #include "ns3/uinteger.h"
@@ -1126,6 +1127,11 @@ Ipv4L3Protocol::AddAddress (uint32_t i, Ipv4InterfaceAddress address)
   NS_LOG_FUNCTION (this << i << address);
   Ptr<Ipv4Interface> interface = GetInterface (i);
   bool retVal = interface->AddAddress (address);
+  // the loopback address is shared by all the nodes
+  if (retVal && m_node != 0 && !address.GetLocal ().IsLocalhost ())
+    {
+      NodeList::AddAddress (address.GetLocal (), m_node);
+    }
   if (m_routingProtocol != 0)
     {
       m_routingProtocol->NotifyAddAddress (i, address);
@@ -1157,6 +1163,10 @@ Ipv4L3Protocol::RemoveAddress (uint32_t i, uint32_t addressIndex)
   Ipv4InterfaceAddress address = interface->RemoveAddress (addressIndex);
   if (address != Ipv4InterfaceAddress ())
     {
+      if (m_node != 0 && !address.GetLocal ().IsLocalhost ())
+        {
+          NodeList::RemoveAddress (address.GetLocal (), m_node);
+        }
       if (m_routingProtocol != 0)
         {
           m_routingProtocol->NotifyRemoveAddress (i, address);
@@ -1180,6 +1190,10 @@ Ipv4L3Protocol::RemoveAddress (uint32_t i, Ipv4Address address)
   Ipv4InterfaceAddress ifAddr = interface->RemoveAddress (address);
   if (ifAddr != Ipv4InterfaceAddress ())
     {
+      if (m_node != 0 && !ifAddr.GetLocal ().IsLocalhost ())
+        {
+          NodeList::RemoveAddress (ifAddr.GetLocal (), m_node);
+        }
       if (m_routingProtocol != 0)
         {
           m_routingProtocol->NotifyRemoveAddress (i, ifAddr);
@@ -20,6 +20,7 @@
 
 #include "ns3/log.h"
 #include "ns3/node.h"
+#include "ns3/node-list.h"
 #include "ns3/uinteger.h"
 #include "ns3/vector.h"
 #include "ns3/boolean.h"
@@ -415,6 +416,11 @@ bool Ipv6L3Protocol::AddAddress (uint32_t i, Ipv6InterfaceAddress address)
   Ptr<Ipv6Interface> interface = GetInterface (i);
   bool ret = interface->AddAddress (address);
 
+  // the loopback and link-local addresses are shared by all the nodes
+  if (ret && m_node != 0 && !address.GetAddress ().IsLocalhost () && !address.GetAddress ().IsLinkLocal ())
+    {
+      NodeList::AddAddress (address.GetAddress (), m_node);
+    }
   if (m_routingProtocol != 0)
     {
       m_routingProtocol->NotifyAddAddress (i, address);
@@ -444,6 +450,10 @@ bool Ipv6L3Protocol::RemoveAddress (uint32_t i, uint32_t addressIndex)
 
   if (address != Ipv6InterfaceAddress ())
     {
+      if (m_node != 0 && !address.GetAddress ().IsLocalhost () && !address.GetAddress ().IsLinkLocal ())
+        {
+          NodeList::RemoveAddress (address.GetAddress (), m_node);
+        }
       if (m_routingProtocol != 0)
         {
           m_routingProtocol->NotifyRemoveAddress (i, address);
@@ -467,6 +477,10 @@ Ipv6L3Protocol::RemoveAddress (uint32_t i, Ipv6Address address)
   Ipv6InterfaceAddress ifAddr = interface->RemoveAddress (address);
   if (ifAddr != Ipv6InterfaceAddress ())
   {
+    if (m_node != 0 && !ifAddr.GetAddress ().IsLocalhost () && !ifAddr.GetAddress ().IsLinkLocal ())
+    {
+      NodeList::RemoveAddress (ifAddr.GetAddress (), m_node);
+    }
     if (m_routingProtocol != 0)
     {
       m_routingProtocol->NotifyRemoveAddress (i, ifAddr);
@@ -22,6 +22,7 @@
 #include "ns3/simulator.h"
 #include "ns3/channel.h"
 #include "ns3/node.h"
+#include "ns3/node-list.h"
 #include "ns3/packet.h"
 
 namespace ns3 {
@@ -101,6 +102,7 @@ void
 LoopbackNetDevice::SetAddress (Address address)
 {
   m_address = Mac48Address::ConvertFrom (address);
+  NodeList::NotifyAddressChange (this);
 }
 
 Address 
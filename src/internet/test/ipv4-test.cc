@@ -24,6 +24,9 @@
 #include "ns3/log.h"
 #include "ns3/inet-socket-address.h"
 #include "ns3/node.h"
+#include "ns3/node-list.h"
+#include "ns3/simple-net-device.h"
+#include "ns3/internet-stack-helper.h"
 
 #include "ns3/ipv4-l3-protocol.h"
 #include "ns3/arp-l3-protocol.h"
@@ -134,6 +137,81 @@ Ipv4L3ProtocolTestCase::DoRun (void)
   Simulator::Destroy ();
 }
 
+/**
+ * \ingroup internet-test
+ * \ingroup tests
+ *
+ * \brief Node lookup by IPv4 and MAC address Test
+ */
+class Ipv4NodeLookupTestCase : public TestCase
+{
+public:
+  Ipv4NodeLookupTestCase ();
+  virtual void DoRun (void);
+};
+
+Ipv4NodeLookupTestCase::Ipv4NodeLookupTestCase ()
+  : TestCase ("Verify the node lookup by address")
+{
+}
+
+void
+Ipv4NodeLookupTestCase::DoRun (void)
+{
+  NodeContainer nodes;
+  nodes.Create (2);
+  InternetStackHelper internet;
+  internet.SetIpv6StackInstall (false);
+  internet.Install (nodes);
+
+  std::vector<Ptr<SimpleNetDevice> > devices;
+  for (uint32_t i = 0; i < nodes.GetN (); i++)
+    {
+      Ptr<SimpleNetDevice> device = CreateObject<SimpleNetDevice> ();
+      nodes.Get (i)->AddDevice (device);
+      device->SetAddress (Mac48Address::Allocate ());
+      devices.push_back (device);
+
+      Ptr<Ipv4> ipv4 = nodes.Get (i)->GetObject<Ipv4> ();
+      uint32_t index = ipv4->AddInterface (device);
+      std::ostringstream oss;
+      oss << "10.1.1." << i + 1;
+      ipv4->AddAddress (index, Ipv4InterfaceAddress (Ipv4Address (oss.str ().c_str ()), "255.255.255.0"));
+      ipv4->AddAddress (index, Ipv4InterfaceAddress (Ipv4Address ("10.2.2.2"), "255.255.255.0"));
+    }
+
+  // the address of a device is recorded even if it was set after the device was added
+  for (uint32_t i = 0; i < nodes.GetN (); i++)
+    {
+      NS_TEST_EXPECT_MSG_EQ (NodeList::GetNodeByAddress (devices[i]->GetAddress ()), nodes.Get (i),
+                             "Wrong node for MAC address " << devices[i]->GetAddress ());
+    }
+
+  // the devices notify the changes of their address
+  Address oldAddress = devices[0]->GetAddress ();
+  Mac48Address newAddress = Mac48Address::Allocate ();
+  devices[0]->SetAddress (newAddress);
+  NS_TEST_EXPECT_MSG_EQ (NodeList::GetNodeByAddress (newAddress), nodes.Get (0), "Wrong node for MAC address " << newAddress);
+  NS_TEST_EXPECT_MSG_EQ (NodeList::GetNodeByAddress (oldAddress), 0, "No node should own MAC address " << oldAddress);
+  devices[1]->SetAddress (oldAddress);
+  NS_TEST_EXPECT_MSG_EQ (NodeList::GetNodeByAddress (oldAddress), nodes.Get (1), "Wrong node for MAC address " << oldAddress);
+
+  NS_TEST_EXPECT_MSG_EQ (NodeList::GetNodeByAddress (Ipv4Address ("10.1.1.1")), nodes.Get (0), "Wrong node for 10.1.1.1");
+  NS_TEST_EXPECT_MSG_EQ (NodeList::GetNodeByAddress (Ipv4Address ("10.1.1.2")), nodes.Get (1), "Wrong node for 10.1.1.2");
+  NS_TEST_EXPECT_MSG_EQ (NodeList::GetNodeByAddress (Ipv4Address ("10.1.1.3")), 0, "No node should own 10.1.1.3");
+  // the loopback address, shared by all the nodes, is not indexed
+  NS_TEST_EXPECT_MSG_EQ (NodeList::GetNodeByAddress (Ipv4Address::GetLoopback ()), 0, "No node should own the loopback address");
+
+  // duplicate addresses resolve to the node that registered first
+  NS_TEST_EXPECT_MSG_EQ (NodeList::GetNodeByAddress (Ipv4Address ("10.2.2.2")), nodes.Get (0), "Wrong node for 10.2.2.2");
+  nodes.Get (0)->GetObject<Ipv4> ()->RemoveAddress (1, Ipv4Address ("10.2.2.2"));
+  NS_TEST_EXPECT_MSG_EQ (NodeList::GetNodeByAddress (Ipv4Address ("10.2.2.2")), nodes.Get (1), "Wrong node for 10.2.2.2");
+  nodes.Get (1)->GetObject<Ipv4> ()->RemoveAddress (1, 1);
+  NS_TEST_EXPECT_MSG_EQ (NodeList::GetNodeByAddress (Ipv4Address ("10.2.2.2")), 0, "No node should own 10.2.2.2");
+
+  Simulator::Destroy ();
+}
+
   
 /**
  * \ingroup internet-test
@@ -148,6 +226,7 @@ public:
     TestSuite ("ipv4-protocol", UNIT)
   {
     AddTestCase (new Ipv4L3ProtocolTestCase (), TestCase::QUICK);
+    AddTestCase (new Ipv4NodeLookupTestCase (), TestCase::QUICK);
   }
 };
 
@@ -26,6 +26,7 @@
 #include "lr-wpan-error-model.h"
 #include <ns3/abort.h>
 #include <ns3/node.h>
+#include <ns3/node-list.h>
 #include <ns3/log.h>
 #include <ns3/spectrum-channel.h>
 #include <ns3/pointer.h>
@@ -252,6 +253,7 @@ LrWpanNetDevice::SetAddress (Address address)
 {
   NS_LOG_FUNCTION (this);
   m_mac->SetShortAddress (Mac16Address::ConvertFrom (address));
+  NodeList::NotifyAddressChange (this);
 }
 
 Address
@@ -37,9 +37,16 @@
 #include <ns3/node.h>
 #include <ns3/buildings-helper.h>
 #include <ns3/lte-spectrum-value-helper.h>
+#include <ns3/lte-spectrum-signal-parameters.h>
+#include <ns3/spectrum-converter.h>
+#include <ns3/spectrum-propagation-loss-model.h>
+#include <ns3/propagation-loss-model.h>
+#include <ns3/antenna-model.h>
+#include <ns3/pointer.h>
 
 #include <fstream>
 #include <limits>
+#include <cmath>
 
 namespace ns3 {
 
@@ -48,6 +55,7 @@ NS_LOG_COMPONENT_DEFINE ("RadioEnvironmentMapHelper");
 NS_OBJECT_ENSURE_REGISTERED (RadioEnvironmentMapHelper);
 
 RadioEnvironmentMapHelper::RadioEnvironmentMapHelper ()
+  : m_directEvaluation (false)
 {
 }
 
@@ -62,6 +70,7 @@ void
 RadioEnvironmentMapHelper::DoDispose ()
 {
   NS_LOG_FUNCTION (this);
+  m_signals.clear ();
 }
 
 TypeId
@@ -144,6 +153,13 @@ RadioEnvironmentMapHelper::GetTypeId (void)
                    IntegerValue (-1),
                    MakeIntegerAccessor (&RadioEnvironmentMapHelper::m_rbId),
                    MakeIntegerChecker<int32_t> ())
+    .AddAttribute ("DirectEvaluation",
+                   "If true, the REM is computed at once by evaluating the propagation "
+                   "models of the channel at each point for the signals transmitted on "
+                   "the channel, instead of deploying RemSpectrumPhy listeners on the channel",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&RadioEnvironmentMapHelper::m_directEvaluation),
+                   MakeBooleanChecker ())
   ;
   return tid;
 }
@@ -225,6 +241,16 @@ RadioEnvironmentMapHelper::DelayedInstall ()
     {
       m_maxPointsPerIteration = m_xRes * m_yRes;
     }
+
+  if (m_directEvaluation)
+    {
+      // record the signals which the listeners of the first iteration
+      // would receive, then compute the map at once
+      m_channel->TraceConnectWithoutContext ("TxSigParams",
+                                             MakeCallback (&RadioEnvironmentMapHelper::RecordSignal, this));
+      Simulator::Schedule (Seconds (0.0006), &RadioEnvironmentMapHelper::EvaluateMap, this);
+      return;
+    }
   
   for (uint32_t i = 0; i < m_maxPointsPerIteration; ++i)
     {
@@ -340,6 +366,140 @@ RadioEnvironmentMapHelper::PrintAndReset ()
     }
 }
 
+void
+RadioEnvironmentMapHelper::RecordSignal (Ptr<SpectrumSignalParameters> params)
+{
+  NS_LOG_FUNCTION (this << params);
+  // same filter as RemSpectrumPhy::StartRx
+  if (m_useDataChannel)
+    {
+      if (DynamicCast<LteSpectrumSignalParametersDataFrame> (params) != 0)
+        {
+          m_signals.push_back (params);
+        }
+    }
+  else if (DynamicCast<LteSpectrumSignalParametersDlCtrlFrame> (params) != 0)
+    {
+      m_signals.push_back (params);
+    }
+}
+
+void
+RadioEnvironmentMapHelper::EvaluateMap ()
+{
+  NS_LOG_FUNCTION (this);
+  m_channel->TraceDisconnectWithoutContext ("TxSigParams",
+                                            MakeCallback (&RadioEnvironmentMapHelper::RecordSignal, this));
+
+  PointerValue lossValue;
+  m_channel->GetAttribute ("PropagationLossModel", lossValue);
+  Ptr<PropagationLossModel> propagationLoss = lossValue.Get<PropagationLossModel> ();
+  Ptr<SpectrumPropagationLossModel> spectrumPropagationLoss = m_channel->GetSpectrumPropagationLossModel ();
+  DoubleValue maxLossDbValue;
+  m_channel->GetAttribute ("MaxLossDb", maxLossDbValue);
+  double maxLossDb = maxLossDbValue.Get ();
+
+  // the part of the reception of each signal which does not depend on the
+  // position, as done by the channel and by RemSpectrumPhy
+  Ptr<const SpectrumModel> rxSpectrumModel = LteSpectrumValueHelper::GetSpectrumModel (m_earfcn, m_bandwidth);
+  std::vector<RemSignal> signals;
+  for (std::vector<Ptr<SpectrumSignalParameters> >::const_iterator it = m_signals.begin (); it != m_signals.end (); ++it)
+    {
+      RemSignal signal;
+      signal.txMobility = (*it)->txPhy->GetMobility ();
+      signal.txAntenna = (*it)->txAntenna;
+      signal.psd = (*it)->psd;
+      Ptr<const SpectrumModel> txSpectrumModel = signal.psd->GetSpectrumModel ();
+      if (txSpectrumModel->GetUid () != rxSpectrumModel->GetUid ())
+        {
+          if (txSpectrumModel->IsOrthogonal (*rxSpectrumModel))
+            {
+              continue;
+            }
+          SpectrumConverter converter (txSpectrumModel, rxSpectrumModel);
+          signal.psd = converter.Convert (signal.psd);
+        }
+      signal.power = (m_rbId >= 0) ? (*signal.psd)[m_rbId] * 180000 : Integral (*signal.psd);
+      signals.push_back (signal);
+    }
+  m_signals.clear ();
+  NS_LOG_LOGIC ("evaluating the REM for " << signals.size () << " signals");
+
+  // the points of an iteration are at distinct positions, as the listeners
+  // of an iteration, which may matter to the propagation loss models
+  // (e.g., for the shadowing of the buildings propagation loss models)
+  std::vector<Ptr<MobilityModel> > points;
+  for (uint32_t i = 0; i < m_maxPointsPerIteration; ++i)
+    {
+      Ptr<MobilityModel> point = CreateObject<ConstantPositionMobilityModel> ();
+      point->AggregateObject (CreateObject<MobilityBuildingInfo> ());
+      points.push_back (point);
+    }
+
+  uint32_t pointIndex = 0;
+  for (double x = m_xMin; x < m_xMax + 0.5*m_xStep; x += m_xStep)
+    {
+      for (double y = m_yMin; y < m_yMax + 0.5*m_yStep ; y += m_yStep)
+        {
+          Ptr<MobilityModel> rxMobility = points[pointIndex];
+          pointIndex = (pointIndex + 1) % m_maxPointsPerIteration;
+          rxMobility->SetPosition (Vector (x, y, m_z));
+          BuildingsHelper::MakeConsistent (rxMobility);
+
+          double referenceSignalPower = 0;
+          double sumPower = 0;
+          for (std::vector<RemSignal>::const_iterator it = signals.begin (); it != signals.end (); ++it)
+            {
+              double power = it->power;
+              if (it->txMobility != 0)
+                {
+                  double pathLossDb = 0;
+                  if (it->txAntenna != 0)
+                    {
+                      Angles txAngles (rxMobility->GetPosition (), it->txMobility->GetPosition ());
+                      pathLossDb -= it->txAntenna->GetGainDb (txAngles);
+                    }
+                  if (propagationLoss != 0)
+                    {
+                      pathLossDb -= propagationLoss->CalcRxPower (0, it->txMobility, rxMobility);
+                    }
+                  if (pathLossDb > maxLossDb)
+                    {
+                      continue;
+                    }
+                  double pathGainLinear = std::pow (10.0, (-pathLossDb) / 10.0);
+                  if (spectrumPropagationLoss != 0)
+                    {
+                      Ptr<SpectrumValue> rxPsd = Copy<SpectrumValue> (it->psd);
+                      *rxPsd *= pathGainLinear;
+                      rxPsd = spectrumPropagationLoss->CalcRxPowerSpectralDensity (rxPsd, it->txMobility, rxMobility);
+                      power = (m_rbId >= 0) ? (*rxPsd)[m_rbId] * 180000 : Integral (*rxPsd);
+                    }
+                  else
+                    {
+                      power *= pathGainLinear;
+                    }
+                }
+              sumPower += power;
+              if (power > referenceSignalPower)
+                {
+                  referenceSignalPower = power;
+                }
+            }
+
+          double sinr = referenceSignalPower / (sumPower - referenceSignalPower + m_noisePower);
+          NS_LOG_LOGIC ("output: " << x << "\t" << y << "\t" << m_z << "\t" << sinr);
+          m_outFile << x << "\t"
+                    << y << "\t"
+                    << m_z << "\t"
+                    << sinr
+                    << "\n";
+        }
+    }
+
+  Finalize ();
+}
+
 void 
 RadioEnvironmentMapHelper::Finalize ()
 {
@@ -25,6 +25,7 @@
 
 #include <ns3/object.h>
 #include <fstream>
+#include <vector>
 
 
 namespace ns3 {
@@ -33,6 +34,9 @@ class RemSpectrumPhy;
 class Node;
 class NetDevice;
 class SpectrumChannel;
+class SpectrumValue;
+class AntennaModel;
+struct SpectrumSignalParameters;
 //class BuildingsMobilityModel;
 class MobilityModel;
 
@@ -108,6 +112,34 @@ private:
   /// Called when the map generation procedure has been completed.
   void Finalize ();
 
+  /**
+   * Record a signal transmitted on the channel while the map is generated
+   * in the direct evaluation mode.
+   *
+   * \param params the parameters of the signal
+   */
+  void RecordSignal (Ptr<SpectrumSignalParameters> params);
+
+  /**
+   * Compute the whole map from the recorded signals by evaluating the
+   * propagation models of the channel at each point, writing each point to
+   * the output file as soon as it is computed, and then call Finalize().
+   */
+  void EvaluateMap ();
+
+  /// A signal received at the REM points, in the direct evaluation mode.
+  struct RemSignal
+  {
+    /// Position of the transmitter.
+    Ptr<MobilityModel> txMobility;
+    /// Antenna of the transmitter.
+    Ptr<AntennaModel> txAntenna;
+    /// PSD of the signal, converted to the spectrum model of the REM.
+    Ptr<SpectrumValue> psd;
+    /// Received power without path loss, as computed by RemSpectrumPhy.
+    double power;
+  };
+
   /// A complete Radio Environment Map is composed of many of this structure.
   struct RemPoint 
   {
@@ -152,6 +184,10 @@ private:
   bool m_useDataChannel;  ///< The `UseDataChannel` attribute.
   int32_t m_rbId;         ///< The `RbId` attribute.
 
+  bool m_directEvaluation;  ///< The `DirectEvaluation` attribute.
+  /// Signals recorded on the channel, in the direct evaluation mode.
+  std::vector<Ptr<SpectrumSignalParameters> > m_signals;
+
 }; // end of `class RadioEnvironmentMapHelper`
 
 
@@ -23,6 +23,7 @@
 #include "ns3/simulator.h"
 #include "ns3/callback.h"
 #include "ns3/node.h"
+#include "ns3/node-list.h"
 #include "ns3/packet.h"
 #include "lte-net-device.h"
 #include "ns3/packet-burst.h"
@@ -101,6 +102,7 @@ LteNetDevice::SetAddress (Address address)
 {
   NS_LOG_FUNCTION (this << address);
   m_address = Mac64Address::ConvertFrom (address);
+  NodeList::NotifyAddressChange (this);
 }
 
 
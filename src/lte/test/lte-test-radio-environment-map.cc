@@ -0,0 +1,173 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <fstream>
+#include <sstream>
+#include <vector>
+
+#include "ns3/test.h"
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+#include "ns3/boolean.h"
+#include "ns3/double.h"
+#include "ns3/uinteger.h"
+#include "ns3/string.h"
+#include "ns3/node-container.h"
+#include "ns3/mobility-helper.h"
+#include "ns3/position-allocator.h"
+#include "ns3/lte-helper.h"
+#include "ns3/spectrum-channel.h"
+#include "ns3/radio-environment-map-helper.h"
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("LteTestRadioEnvironmentMap");
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * \brief Test that the REM computed by direct evaluation of the propagation
+ * models matches the REM measured by RemSpectrumPhy listeners.
+ *
+ * Two eNBs transmit on a channel with a deterministic propagation loss
+ * model, and the REM of a small grid, spanning several listener
+ * iterations, is generated in both modes.
+ */
+class LteRadioEnvironmentMapTestCase : public TestCase
+{
+public:
+  LteRadioEnvironmentMapTestCase ();
+  virtual ~LteRadioEnvironmentMapTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+  /**
+   * Generate a REM
+   *
+   * \param directEvaluation the DirectEvaluation attribute of the helper
+   * \param fileName the output file
+   * \returns the lines of the output file, each a (x, y, z, SINR) tuple
+   */
+  std::vector<std::vector<double> > GenerateRem (bool directEvaluation, std::string fileName);
+};
+
+LteRadioEnvironmentMapTestCase::LteRadioEnvironmentMapTestCase ()
+  : TestCase ("Compare the REM computed by direct evaluation with the REM measured by listeners")
+{
+}
+
+LteRadioEnvironmentMapTestCase::~LteRadioEnvironmentMapTestCase ()
+{
+}
+
+std::vector<std::vector<double> >
+LteRadioEnvironmentMapTestCase::GenerateRem (bool directEvaluation, std::string fileName)
+{
+  Ptr<LteHelper> lteHelper = CreateObject<LteHelper> ();
+  lteHelper->SetAttribute ("PathlossModel", StringValue ("ns3::FriisPropagationLossModel"));
+
+  NodeContainer enbNodes;
+  enbNodes.Create (2);
+  MobilityHelper mobility;
+  Ptr<ListPositionAllocator> positions = CreateObject<ListPositionAllocator> ();
+  positions->Add (Vector (-50.0, 10.0, 30.0));
+  positions->Add (Vector (120.0, -20.0, 30.0));
+  mobility.SetPositionAllocator (positions);
+  mobility.SetMobilityModel ("ns3::ConstantPositionMobilityModel");
+  mobility.Install (enbNodes);
+  lteHelper->InstallEnbDevice (enbNodes);
+
+  std::ostringstream channelPath;
+  channelPath << "/ChannelList/" << lteHelper->GetDownlinkSpectrumChannel ()->GetId ();
+  Ptr<RadioEnvironmentMapHelper> remHelper = CreateObject<RadioEnvironmentMapHelper> ();
+  remHelper->SetAttribute ("ChannelPath", StringValue (channelPath.str ()));
+  remHelper->SetAttribute ("OutputFile", StringValue (fileName));
+  remHelper->SetAttribute ("XMin", DoubleValue (-200.0));
+  remHelper->SetAttribute ("XMax", DoubleValue (200.0));
+  remHelper->SetAttribute ("XRes", UintegerValue (5));
+  remHelper->SetAttribute ("YMin", DoubleValue (-100.0));
+  remHelper->SetAttribute ("YMax", DoubleValue (100.0));
+  remHelper->SetAttribute ("YRes", UintegerValue (4));
+  remHelper->SetAttribute ("Z", DoubleValue (1.5));
+  remHelper->SetAttribute ("MaxPointsPerIteration", UintegerValue (7));
+  remHelper->SetAttribute ("DirectEvaluation", BooleanValue (directEvaluation));
+  remHelper->Install ();
+
+  Simulator::Stop (Seconds (1));
+  Simulator::Run ();
+  Simulator::Destroy ();
+
+  std::vector<std::vector<double> > rem;
+  std::ifstream is (fileName.c_str ());
+  std::string line;
+  while (std::getline (is, line))
+    {
+      std::istringstream iss (line);
+      std::vector<double> values;
+      double value;
+      while (iss >> value)
+        {
+          values.push_back (value);
+        }
+      rem.push_back (values);
+    }
+  return rem;
+}
+
+void
+LteRadioEnvironmentMapTestCase::DoRun (void)
+{
+  std::vector<std::vector<double> > listenerRem = GenerateRem (false, CreateTempDirFilename ("rem-listeners.out"));
+  std::vector<std::vector<double> > directRem = GenerateRem (true, CreateTempDirFilename ("rem-direct.out"));
+
+  NS_TEST_ASSERT_MSG_EQ (listenerRem.size (), 20, "Unexpected number of points measured by listeners");
+  NS_TEST_ASSERT_MSG_EQ (directRem.size (), listenerRem.size (), "Unexpected number of points evaluated directly");
+  for (std::size_t i = 0; i < listenerRem.size (); ++i)
+    {
+      NS_TEST_ASSERT_MSG_EQ (listenerRem[i].size (), 4, "Unexpected number of values at point " << i);
+      NS_TEST_ASSERT_MSG_EQ (directRem[i].size (), 4, "Unexpected number of values at point " << i);
+      for (std::size_t j = 0; j < 3; ++j)
+        {
+          NS_TEST_EXPECT_MSG_EQ (directRem[i][j], listenerRem[i][j], "Unexpected coordinate " << j << " of point " << i);
+        }
+      // both SINRs are written with the default precision of the stream
+      NS_TEST_EXPECT_MSG_EQ_TOL (directRem[i][3], listenerRem[i][3], listenerRem[i][3] * 1e-5,
+                                 "Unexpected SINR at point " << i);
+    }
+}
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * \brief Test suite of the RadioEnvironmentMapHelper.
+ */
+class LteRadioEnvironmentMapTestSuite : public TestSuite
+{
+public:
+  LteRadioEnvironmentMapTestSuite ();
+};
+
+LteRadioEnvironmentMapTestSuite::LteRadioEnvironmentMapTestSuite ()
+  : TestSuite ("lte-radio-environment-map", UNIT)
+{
+  NS_LOG_FUNCTION (this);
+  AddTestCase (new LteRadioEnvironmentMapTestCase, TestCase::QUICK);
+}
+
+static LteRadioEnvironmentMapTestSuite g_lteRadioEnvironmentMapTestSuite; ///< the test suite
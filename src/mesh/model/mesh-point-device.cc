@@ -25,6 +25,7 @@
 #include "ns3/mesh-point-device.h"
 #include "ns3/wifi-net-device.h"
 #include "ns3/mesh-wifi-interface-mac.h"
+#include "ns3/node-list.h"
 
 namespace ns3 {
 
@@ -181,6 +182,7 @@ MeshPointDevice::SetAddress (Address a)
   NS_LOG_FUNCTION (this);
   NS_LOG_WARN ("Manual changing mesh point address can cause routing errors.");
   m_address = Mac48Address::ConvertFrom (a);
+  NodeList::NotifyAddressChange (this);
 }
 
 bool
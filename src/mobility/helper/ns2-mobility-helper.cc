@@ -41,8 +41,14 @@
 #include <fstream>
 #include <sstream>
 #include <map>
+#include <vector>
+#include <cstdlib>
+#include <climits>
+#include <cctype>
+#include <algorithm>
 #include "ns3/log.h"
 #include "ns3/unused.h"
+#include "ns3/simple-ref-count.h"
 #include "ns3/simulator.h"
 #include "ns3/node-list.h"
 #include "ns3/node.h"
@@ -106,6 +112,15 @@ struct DestinationPoint
  */
 static ParseResult ParseNs2Line (const std::string& str);
 
+/**
+ * Check if a string represents a numeric value, and convert it
+ * \param str string to check
+ * \param ival integer value to return
+ * \param dval double value to return
+ * \return true if string represents a numeric value
+ */
+static bool ParseNumber (const std::string& str, int& ival, double& dval);
+
 /** 
  * Put out blank spaces at the start and end of a line
  */
@@ -128,48 +143,56 @@ static bool IsVal (const std::string& str, T& ret);
 /**
  * Checks if the value between brackets is a correct nodeId number
  */ 
-static bool HasNodeIdNumber (std::string str);
+static bool HasNodeIdNumber (const std::string& str);
 
 /** 
  * Gets nodeId number in string format from the string like $node_(4)
  */
-static std::string GetNodeIdFromToken (std::string str);
+static std::string GetNodeIdFromToken (const std::string& str);
 
 /** 
  * Get node id number in int format
  */
-static int GetNodeIdInt (ParseResult pr);
+static int GetNodeIdInt (const ParseResult& pr);
 
 /**  
  * Get node id number in string format
  */
-static std::string GetNodeIdString (ParseResult pr);
+static std::string GetNodeIdString (const ParseResult& pr);
 
 /**
  * Add one coord to a vector position
  */
-static Vector SetOneInitialCoord (Vector actPos, std::string& coord, double value);
+static Vector SetOneInitialCoord (Vector actPos, const std::string& coord, double value);
 
 /** 
  * Check if this corresponds to a line like this: $node_(0) set X_ 123
  */
-static bool IsSetInitialPos (ParseResult pr);
+static bool IsSetInitialPos (const ParseResult& pr);
 
 /** 
  * Check if this corresponds to a line like this: $ns_ at 1 "$node_(0) setdest 2 3 4"
  */
-static bool IsSchedSetPos (ParseResult pr);
+static bool IsSchedSetPos (const ParseResult& pr);
 
 /**
  * Check if this corresponds to a line like this: $ns_ at 1 "$node_(0) set X_ 2"
  */
-static bool IsSchedMobilityPos (ParseResult pr);
+static bool IsSchedMobilityPos (const ParseResult& pr);
+
+/**
+ * If the last movement is not over at the given time, cancel its end and
+ * set its final position to the position actually reached.
+ */
+static void InterruptMovement (DestinationPoint& point, double at);
 
 /**
- * Set waypoints and speed for movement.
+ * Set waypoints and speed for movement. The events are scheduled at the
+ * given time minus the time elapsed since the trace was installed.
  */
 static DestinationPoint SetMovement (Ptr<ConstantVelocityMobilityModel> model, Vector lastPos, double at,
-                                     double xFinalPosition, double yFinalPosition, double speed);
+                                     double xFinalPosition, double yFinalPosition, double speed,
+                                     Time elapsed);
 
 /**
  * Set initial position for a node
@@ -182,13 +205,206 @@ static Vector SetInitialPosition (Ptr<ConstantVelocityMobilityModel> model, std:
 static Vector SetSchedPosition (Ptr<ConstantVelocityMobilityModel> model, double at, std::string coord, double coordVal);
 
 
+/**
+ * Reads and schedules the statements of a ns-2 trace in time windows
+ * (streaming mode). The statements of a time window are read at the start
+ * of the previous time window, from the byte ranges of the trace indexed
+ * for this time window.
+ */
+class Ns2TraceStream : public SimpleRefCount<Ns2TraceStream>
+{
+public:
+  /**
+   * \param filename the trace file
+   * \param window the duration of a time window
+   */
+  Ns2TraceStream (std::string filename, Time window);
+  /**
+   * Add a node of the trace
+   * \param nodeId the node id
+   * \param model the mobility model of the node
+   * \param point the initial position of the node
+   */
+  void AddNode (int nodeId, Ptr<ConstantVelocityMobilityModel> model, const DestinationPoint& point);
+  /**
+   * Index a scheduled statement
+   * \param at the time of the statement
+   * \param begin the offset of the line of the statement in the trace
+   * \param end the offset of the next line
+   */
+  void AddStatement (double at, uint64_t begin, uint64_t end);
+  /**
+   * Read the first time window, and schedule the reading of the next ones
+   */
+  void Start (void);
+
+private:
+  /// State of a node of the trace
+  struct NodeState
+  {
+    Ptr<ConstantVelocityMobilityModel> model; //!< mobility model of the node
+    DestinationPoint lastPos;                 //!< last movement scheduled
+    Vector position;                          //!< position after the last scheduled set position
+  };
+  /// Byte range [begin, end) of consecutive lines of the trace
+  typedef std::pair<uint64_t, uint64_t> Range;
+
+  /**
+   * Read and schedule the first time window not read yet, and schedule
+   * the reading of the next one
+   */
+  void Load (void);
+  /**
+   * Schedule a statement of the trace
+   * \param pr the parsed statement
+   */
+  void ScheduleStatement (const ParseResult& pr);
+
+  std::string m_filename;                          //!< trace file name
+  std::ifstream m_file;                            //!< trace file
+  Time m_window;                                   //!< duration of a time window
+  Time m_start;                                    //!< time at which the trace was installed
+  std::map<int, NodeState> m_nodes;                //!< nodes of the trace
+  std::map<uint64_t, std::vector<Range> > m_index; //!< byte ranges of the trace, per time window
+  uint64_t m_lastWindow;                           //!< time window of the last statement indexed
+};
+
+Ns2TraceStream::Ns2TraceStream (std::string filename, Time window)
+  : m_filename (filename),
+    m_window (window),
+    m_lastWindow (0)
+{
+}
+
+void
+Ns2TraceStream::AddNode (int nodeId, Ptr<ConstantVelocityMobilityModel> model, const DestinationPoint& point)
+{
+  NodeState &node = m_nodes[nodeId];
+  node.model = model;
+  node.lastPos = point;
+  node.position = model->GetPosition ();
+}
+
+void
+Ns2TraceStream::AddStatement (double at, uint64_t begin, uint64_t end)
+{
+  uint64_t window = Seconds (at).GetTimeStep () / m_window.GetTimeStep ();
+  std::vector<Range> &ranges = m_index[window];
+  if (window == m_lastWindow && !ranges.empty ())
+    {
+      // the previous statement of the trace is in the same time window:
+      // extend its range over the lines in between, if any
+      ranges.back ().second = end;
+    }
+  else
+    {
+      ranges.push_back (Range (begin, end));
+    }
+  m_lastWindow = window;
+}
+
+void
+Ns2TraceStream::Start (void)
+{
+  m_start = Simulator::Now ();
+  m_file.open (m_filename.c_str (), std::ios::in);
+  if (!m_file.is_open ())
+    {
+      NS_FATAL_ERROR ("Could not open trace file " << m_filename << " for reading");
+    }
+  if (!m_index.empty ())
+    {
+      Load ();
+    }
+}
+
+void
+Ns2TraceStream::Load (void)
+{
+  std::map<uint64_t, std::vector<Range> >::iterator it = m_index.begin ();
+  NS_LOG_DEBUG ("Reading time window " << it->first << " (" << it->second.size () << " ranges)");
+  std::string line;
+  for (std::vector<Range>::const_iterator range = it->second.begin (); range != it->second.end (); range++)
+    {
+      m_file.clear ();
+      m_file.seekg (range->first);
+      uint64_t offset = range->first;
+      while (offset < range->second && getline (m_file, line))
+        {
+          offset += line.size () + 1;
+          if (!line.empty ())
+            {
+              ScheduleStatement (ParseNs2Line (line));
+            }
+        }
+    }
+  m_index.erase (it);
+
+  if (!m_index.empty ())
+    {
+      // read the next time window at the start of the previous one
+      Time next = m_start + TimeStep (m_window.GetTimeStep () * (m_index.begin ()->first - 1));
+      Simulator::Schedule (Max (next - Simulator::Now (), Time (0)), &Ns2TraceStream::Load, Ptr<Ns2TraceStream> (this));
+    }
+}
+
+void
+Ns2TraceStream::ScheduleStatement (const ParseResult& pr)
+{
+  // the lines were checked when the trace was indexed, except the
+  // lines between indexed statements
+  if ((pr.tokens.size () != 7 && pr.tokens.size () != 8) || !IsNumber (pr.tokens[2]) || pr.dvals[2] < 0)
+    {
+      return;
+    }
+  std::map<int, NodeState>::iterator it = m_nodes.find (GetNodeIdInt (pr));
+  if (it == m_nodes.end ())
+    {
+      return;
+    }
+  NodeState &node = it->second;
+  double at = pr.dvals[2];
+  Time elapsed = Simulator::Now () - m_start;
+
+  if (IsSchedMobilityPos (pr))
+    {
+      InterruptMovement (node.lastPos, at);
+      node.lastPos = SetMovement (node.model, node.lastPos.m_finalPosition, at, pr.dvals[5], pr.dvals[6], pr.dvals[7], elapsed);
+      NS_LOG_DEBUG ("Positions after parse for node " << it->first << " position =" << node.lastPos.m_finalPosition);
+    }
+  else if (IsSchedSetPos (pr))
+    {
+      // unlike in the default mode, the position of the model is not
+      // changed before the statement time
+      node.position = SetOneInitialCoord (node.position, pr.tokens[5], pr.dvals[6]);
+      Simulator::Schedule (Seconds (at) - elapsed, &ConstantVelocityMobilityModel::SetPosition, node.model, node.position);
+      node.lastPos.m_finalPosition = node.position;
+      if (node.lastPos.m_targetArrivalTime > at)
+        {
+          node.lastPos.m_stopEvent.Cancel ();
+        }
+      node.lastPos.m_targetArrivalTime = at;
+      node.lastPos.m_travelStartTime = at;
+      NS_LOG_DEBUG ("Positions after parse for node " << it->first << " position =" << node.lastPos.m_finalPosition);
+    }
+}
+
+
 Ns2MobilityHelper::Ns2MobilityHelper (std::string filename)
-  : m_filename (filename)
+  : m_filename (filename),
+    m_window (0)
 {
   std::ifstream file (m_filename.c_str (), std::ios::in);
   if (!(file.is_open ())) NS_FATAL_ERROR("Could not open trace file " << m_filename.c_str() << " for reading, aborting here \n"); 
 }
 
+void
+Ns2MobilityHelper::EnableStreaming (Time window)
+{
+  NS_ASSERT (!window.IsNegative ());
+  m_window = window;
+}
+
 Ptr<ConstantVelocityMobilityModel>
 Ns2MobilityHelper::GetMobilityModel (std::string idString, const ObjectStore &store) const
 {
@@ -216,6 +432,12 @@ Ns2MobilityHelper::ConfigNodesMovements (const ObjectStore &store) const
 {
   std::map<int, DestinationPoint> last_pos;    // Stores previous movement scheduled for each node
 
+  // In streaming mode, the scheduled statements are indexed during the first
+  // parse, and read during the simulation instead of the second parse
+  Ptr<Ns2TraceStream> stream = m_window.IsZero () ? 0 : Create<Ns2TraceStream> (m_filename, m_window);
+  std::map<int, Ptr<ConstantVelocityMobilityModel> > models;
+  uint64_t offset = 0;
+
   //*****************************************************************
   // Parse the file the first time to get the initial node positions.
   //*****************************************************************
@@ -233,6 +455,8 @@ Ns2MobilityHelper::ConfigNodesMovements (const ObjectStore &store) const
           std::string line;
 
           getline (file, line);
+          uint64_t begin = offset;
+          offset += line.size () + 1;
 
           // ignore empty lines
           if (line.empty ())
@@ -243,8 +467,9 @@ Ns2MobilityHelper::ConfigNodesMovements (const ObjectStore &store) const
           ParseResult pr = ParseNs2Line (line); // Parse line and obtain tokens
 
           // Check if the line corresponds with setting the initial
-          // node positions
-          if (pr.tokens.size () != 4)
+          // node positions (or with a scheduled statement, in streaming mode)
+          if (pr.tokens.size () != 4
+              && (stream == 0 || (pr.tokens.size () != 7 && pr.tokens.size () != 8)))
             {
               continue;
             }
@@ -267,6 +492,10 @@ Ns2MobilityHelper::ConfigNodesMovements (const ObjectStore &store) const
               NS_LOG_ERROR ("Unknown node ID (corrupted file?): " << nodeId << "\n");
               continue;
             }
+          if (stream != 0)
+            {
+              models[iNodeId] = model;
+            }
 
 
           /*
@@ -284,10 +513,29 @@ Ns2MobilityHelper::ConfigNodesMovements (const ObjectStore &store) const
               NS_LOG_DEBUG ("Positions after parse for node " << iNodeId << " " << nodeId <<
                             " position = " << last_pos[iNodeId].m_finalPosition);
             }
+          else if (stream != 0 && pr.tokens.size () != 4)
+            {
+              if (!IsNumber (pr.tokens[2]) || pr.dvals[2] < 0)
+                {
+                  NS_LOG_WARN ("Time is not a number or is less than cero: " << pr.tokens[2]);
+                  continue;
+                }
+              stream->AddStatement (pr.dvals[2], begin, offset);
+            }
         }
       file.close ();
     }
 
+  if (stream != 0)
+    {
+      for (std::map<int, Ptr<ConstantVelocityMobilityModel> >::const_iterator it = models.begin (); it != models.end (); it++)
+        {
+          stream->AddNode (it->first, it->second, last_pos[it->first]);
+        }
+      stream->Start ();
+      return;
+    }
+
   //*****************************************************************
   // Parse the file a second time to get the rest of its values
   //*****************************************************************
@@ -380,21 +628,9 @@ Ns2MobilityHelper::ConfigNodesMovements (const ObjectStore &store) const
                */
               if (IsSchedMobilityPos (pr))
                 {
-                  if (last_pos[iNodeId].m_targetArrivalTime > at)
-                    {
-                      NS_LOG_LOGIC ("Did not reach a destination! stoptime = " << last_pos[iNodeId].m_targetArrivalTime << ", at = "<<  at);
-                      double actuallytraveled = at - last_pos[iNodeId].m_travelStartTime;
-                      Vector reached = Vector (
-                          last_pos[iNodeId].m_startPosition.x + last_pos[iNodeId].m_speed.x * actuallytraveled,
-                          last_pos[iNodeId].m_startPosition.y + last_pos[iNodeId].m_speed.y * actuallytraveled,
-                          0
-                          );
-                      NS_LOG_LOGIC ("Final point = " << last_pos[iNodeId].m_finalPosition << ", actually reached = " << reached);
-                      last_pos[iNodeId].m_stopEvent.Cancel ();
-                      last_pos[iNodeId].m_finalPosition = reached;
-                    }
+                  InterruptMovement (last_pos[iNodeId], at);
                   //                                     last position     time  X coord     Y coord      velocity
-                  last_pos[iNodeId] = SetMovement (model, last_pos[iNodeId].m_finalPosition, at, pr.dvals[5], pr.dvals[6], pr.dvals[7]);
+                  last_pos[iNodeId] = SetMovement (model, last_pos[iNodeId].m_finalPosition, at, pr.dvals[5], pr.dvals[6], pr.dvals[7], Time (0));
 
                   // Log new position
                   NS_LOG_DEBUG ("Positions after parse for node " << iNodeId << " " << nodeId << " position =" << last_pos[iNodeId].m_finalPosition);
@@ -434,7 +670,6 @@ ParseResult
 ParseNs2Line (const std::string& str)
 {
   ParseResult ret;
-  std::istringstream s;
   std::string line;
 
   // ignore comments (#)
@@ -457,16 +692,25 @@ ParseNs2Line (const std::string& str)
       return ret;
     }
 
-  s.str (line);
-
-  while (!s.eof ())
+  // split the line on white spaces
+  std::string::size_type end = 0;
+  while (true)
     {
-      std::string x;
-      s >> x;
-      if (x.length () == 0)
+      std::string::size_type start = end;
+      while (start < line.size () && isspace (static_cast<unsigned char> (line[start])))
         {
-          continue;
+          start++;
         }
+      if (start == line.size ())
+        {
+          break;
+        }
+      end = start;
+      while (end < line.size () && !isspace (static_cast<unsigned char> (line[end])))
+        {
+          end++;
+        }
+      std::string x = line.substr (start, end - start);
       ret.tokens.push_back (x);
       int ii (0);
       double d (0);
@@ -474,13 +718,19 @@ ParseNs2Line (const std::string& str)
         {
           x = GetNodeIdFromToken (x);
         }
-      ret.has_ival.push_back (IsVal<int> (x, ii));
+      bool isNumber = ParseNumber (x, ii, d);
+      ret.has_ival.push_back (isNumber);
       ret.ivals.push_back (ii);
-      ret.has_dval.push_back (IsVal<double> (x, d));
+      ret.has_dval.push_back (isNumber);
       ret.dvals.push_back (d);
       ret.svals.push_back (x);
     }
 
+  if (ret.tokens.empty ())
+    {
+      return ret;
+    }
+
   size_t tokensLength   = ret.tokens.size ();                 // number of tokens in line
   size_t lasTokenLength = ret.tokens[tokensLength - 1].size (); // length of the last token
 
@@ -504,9 +754,10 @@ ParseNs2Line (const std::string& str)
       // Re calculate values
       int ii (0);
       double d (0);
-      ret.has_ival[tokensLength - 1] = IsVal<int> (x, ii);
+      bool isNumber = ParseNumber (x, ii, d);
+      ret.has_ival[tokensLength - 1] = isNumber;
       ret.ivals[tokensLength - 1] = ii;
-      ret.has_dval[tokensLength - 1] = IsVal<double> (x, d);
+      ret.has_dval[tokensLength - 1] = isNumber;
       ret.dvals[tokensLength - 1] = d;
       ret.svals[tokensLength - 1] = x;
 
@@ -583,7 +834,33 @@ bool IsVal (const std::string& str, T& ret)
 
 
 bool
-HasNodeIdNumber (std::string str)
+ParseNumber (const std::string& str, int& ival, double& dval)
+{
+  if (str.size () == 0)
+    {
+      return false;
+    }
+  char *endp;
+  double value = strtod (str.c_str (), &endp);
+  if (endp != str.c_str () + str.size ())
+    {
+      return false;
+    }
+  if (str.find_first_not_of ("0123456789+-.eE") != std::string::npos)
+    {
+      // hexadecimal, infinite or NaN values are converted as by IsVal
+      return IsVal<int> (str, ival) && IsVal<double> (str, dval);
+    }
+  // decimal values are converted as by IsVal, without string streams
+  dval = value;
+  long integer = strtol (str.c_str (), 0, 10);
+  ival = static_cast<int> (std::max (static_cast<long> (INT_MIN), std::min (integer, static_cast<long> (INT_MAX))));
+  return true;
+}
+
+
+bool
+HasNodeIdNumber (const std::string& str)
 {
 
   // find brackets
@@ -614,7 +891,7 @@ HasNodeIdNumber (std::string str)
 
 
 std::string
-GetNodeIdFromToken (std::string str)
+GetNodeIdFromToken (const std::string& str)
 {
   if (HasNodeIdNumber (str))
     {
@@ -632,7 +909,7 @@ GetNodeIdFromToken (std::string str)
 
 
 int
-GetNodeIdInt (ParseResult pr)
+GetNodeIdInt (const ParseResult& pr)
 {
   int result = -1;
   switch (pr.tokens.size ())
@@ -654,7 +931,7 @@ GetNodeIdInt (ParseResult pr)
 
 // Get node id number in string format
 std::string
-GetNodeIdString (ParseResult pr)
+GetNodeIdString (const ParseResult& pr)
 {
   switch (pr.tokens.size ())
     {
@@ -674,7 +951,7 @@ GetNodeIdString (ParseResult pr)
 
 
 Vector
-SetOneInitialCoord (Vector position, std::string& coord, double value)
+SetOneInitialCoord (Vector position, const std::string& coord, double value)
 {
 
   // set the position for the coord.
@@ -698,7 +975,7 @@ SetOneInitialCoord (Vector position, std::string& coord, double value)
 
 
 bool
-IsSetInitialPos (ParseResult pr)
+IsSetInitialPos (const ParseResult& pr)
 {
   //        number of tokens         has $node_( ?                        has "set"           has doble for position?
   return pr.tokens.size () == 4 && HasNodeIdNumber (pr.tokens[0]) && pr.tokens[1] == NS2_SET && pr.has_dval[3]
@@ -709,7 +986,7 @@ IsSetInitialPos (ParseResult pr)
 
 
 bool
-IsSchedSetPos (ParseResult pr)
+IsSchedSetPos (const ParseResult& pr)
 {
   //      correct number of tokens,    has $ns_                   and at
   return pr.tokens.size () == 7 && pr.tokens[0] == NS2_NS_SCH && pr.tokens[1] == NS2_AT
@@ -719,7 +996,7 @@ IsSchedSetPos (ParseResult pr)
 }
 
 bool
-IsSchedMobilityPos (ParseResult pr)
+IsSchedMobilityPos (const ParseResult& pr)
 {
   //     number of tokens      and    has $ns_                and    has at
   return pr.tokens.size () == 8 && pr.tokens[0] == NS2_NS_SCH && pr.tokens[1] == NS2_AT
@@ -729,9 +1006,27 @@ IsSchedMobilityPos (ParseResult pr)
 
 }
 
+void
+InterruptMovement (DestinationPoint& point, double at)
+{
+  if (point.m_targetArrivalTime > at)
+    {
+      NS_LOG_LOGIC ("Did not reach a destination! stoptime = " << point.m_targetArrivalTime << ", at = "<<  at);
+      double actuallytraveled = at - point.m_travelStartTime;
+      Vector reached = Vector (
+          point.m_startPosition.x + point.m_speed.x * actuallytraveled,
+          point.m_startPosition.y + point.m_speed.y * actuallytraveled,
+          0
+          );
+      NS_LOG_LOGIC ("Final point = " << point.m_finalPosition << ", actually reached = " << reached);
+      point.m_stopEvent.Cancel ();
+      point.m_finalPosition = reached;
+    }
+}
+
 DestinationPoint
 SetMovement (Ptr<ConstantVelocityMobilityModel> model, Vector last_pos, double at,
-             double xFinalPosition, double yFinalPosition, double speed)
+             double xFinalPosition, double yFinalPosition, double speed, Time elapsed)
 {
   DestinationPoint retval;
   retval.m_startPosition = last_pos;
@@ -742,7 +1037,7 @@ SetMovement (Ptr<ConstantVelocityMobilityModel> model, Vector last_pos, double a
   if (speed == 0)
     {
       // We have to maintain last position, and stop the movement
-      retval.m_stopEvent = Simulator::Schedule (Seconds (at), &ConstantVelocityMobilityModel::SetVelocity, model,
+      retval.m_stopEvent = Simulator::Schedule (Seconds (at) - elapsed, &ConstantVelocityMobilityModel::SetVelocity, model,
                                                 Vector (0, 0, 0));
       return retval;
     }
@@ -766,8 +1061,8 @@ SetMovement (Ptr<ConstantVelocityMobilityModel> model, Vector last_pos, double a
       NS_LOG_DEBUG ("Calculated Speed: X=" << xSpeed << " Y=" << ySpeed << " Z=" << zSpeed);
 
       // Set the Values
-      Simulator::Schedule (Seconds (at), &ConstantVelocityMobilityModel::SetVelocity, model, Vector (xSpeed, ySpeed, zSpeed));
-      retval.m_stopEvent = Simulator::Schedule (Seconds (at + time), &ConstantVelocityMobilityModel::SetVelocity, model, Vector (0, 0, 0));
+      Simulator::Schedule (Seconds (at) - elapsed, &ConstantVelocityMobilityModel::SetVelocity, model, Vector (xSpeed, ySpeed, zSpeed));
+      retval.m_stopEvent = Simulator::Schedule (Seconds (at + time) - elapsed, &ConstantVelocityMobilityModel::SetVelocity, model, Vector (0, 0, 0));
       retval.m_finalPosition.x += xSpeed * time;
       retval.m_finalPosition.y += ySpeed * time;
       retval.m_targetArrivalTime += time;
@@ -27,6 +27,7 @@
 #include <stdint.h>
 #include "ns3/ptr.h"
 #include "ns3/object.h"
+#include "ns3/nstime.h"
 
 namespace ns3 {
 
@@ -69,6 +70,12 @@ class ConstantVelocityMobilityModel;
  *
  *  See usage example in examples/mobility/ns2-mobility-trace.cc
  *
+ * By default, the whole trace is read when Install is called, and every
+ * movement is scheduled up front. For large traces, EnableStreaming can be
+ * called before Install: the trace is then only indexed by time when
+ * Install is called, and the movements are read and scheduled during the
+ * simulation, one time window ahead.
+ *
  * \bug Rounding errors may cause movement to diverge from the mobility
  * pattern in ns-2 (using the same trace).
  * See https://www.nsnam.org/bugzilla/show_bug.cgi?id=1316
@@ -82,6 +89,22 @@ public:
    */
   Ns2MobilityHelper (std::string filename);
 
+  /**
+   * \brief Read the trace in time windows during the simulation
+   *
+   * \param window the duration of a time window, or zero to read the
+   *        whole trace when Install is called (the default)
+   *
+   * When Install is called, the trace is scanned once to set the initial
+   * positions and to index the scheduled statements by time window. The
+   * statements of a time window are then read and scheduled at the start
+   * of the previous time window, so that the memory used scales with the
+   * number of statements in a time window rather than with the length of
+   * the trace. The statements of a time window are read in the trace order,
+   * and the time windows in time order.
+   */
+  void EnableStreaming (Time window);
+
   /**
    * Read the ns2 trace file and configure the movement
    * patterns of all nodes contained in the global ns3::NodeList
@@ -131,6 +154,7 @@ public:
    */
   Ptr<ConstantVelocityMobilityModel> GetMobilityModel (std::string idString, const ObjectStore &store) const;
   std::string m_filename; //!< filename of file containing ns-2 mobility trace 
+  Time m_window;          //!< duration of a time window in streaming mode, zero if disabled
 };
 
 } // namespace ns3
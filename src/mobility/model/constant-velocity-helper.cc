@@ -82,12 +82,14 @@ ConstantVelocityHelper::Update (void) const
   NS_LOG_FUNCTION (this);
   Time now = Simulator::Now ();
   NS_ASSERT (m_lastUpdate <= now);
-  Time deltaTime = now - m_lastUpdate;
-  m_lastUpdate = now;
-  if (m_paused)
+  if (m_paused || now == m_lastUpdate)
     {
+      // avoid the conversion of the elapsed time when there is no move
+      m_lastUpdate = now;
       return;
     }
+  Time deltaTime = now - m_lastUpdate;
+  m_lastUpdate = now;
   double deltaS = deltaTime.GetSeconds ();
   m_position.x += m_velocity.x * deltaS;
   m_position.y += m_velocity.y * deltaS;
@@ -22,6 +22,7 @@
 #include "ns3/random-variable-stream.h"
 #include "ns3/pointer.h"
 #include "ns3/string.h"
+#include "ns3/boolean.h"
 #include "random-waypoint-mobility-model.h"
 #include "position-allocator.h"
 
@@ -50,11 +51,26 @@ RandomWaypointMobilityModel::GetTypeId (void)
                    "The position model used to pick a destination point.",
                    PointerValue (),
                    MakePointerAccessor (&RandomWaypointMobilityModel::m_position),
-                   MakePointerChecker<PositionAllocator> ());
+                   MakePointerChecker<PositionAllocator> ())
+    .AddAttribute ("Lazy",
+                   "If true, do not schedule an event at the end of each walk, and only a "
+                   "notification of the course change at the end of each pause, but play the "
+                   "pauses and walks back when the position or the velocity is queried. Must "
+                   "be set before the model is initialized.",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&RandomWaypointMobilityModel::m_lazy),
+                   MakeBooleanChecker ());
 
   return tid;
 }
 
+RandomWaypointMobilityModel::RandomWaypointMobilityModel ()
+  : m_lazy (false),
+    m_walking (false),
+    m_legEnd (Time::Max ())
+{
+}
+
 void
 RandomWaypointMobilityModel::BeginWalk (void)
 {
@@ -80,7 +96,17 @@ RandomWaypointMobilityModel::BeginWalk (void)
 void
 RandomWaypointMobilityModel::DoInitialize (void)
 {
-  DoInitializePrivate ();
+  if (m_lazy)
+    {
+      // the position may have been set before the model became lazy
+      Simulator::Remove (m_event);
+      StartPause (m_helper.GetCurrentPosition ());
+      NotifyCourseChange ();
+    }
+  else
+    {
+      DoInitializePrivate ();
+    }
   MobilityModel::DoInitialize ();
 }
 
@@ -94,15 +120,95 @@ RandomWaypointMobilityModel::DoInitializePrivate (void)
   NotifyCourseChange ();
 }
 
+void
+RandomWaypointMobilityModel::StartPause (const Vector &position) const
+{
+  m_walking = false;
+  m_legStartPosition = position;
+  m_legStart = Simulator::Now ();
+  m_legEnd = m_legStart + Seconds (m_pause->GetValue ());
+  SchedulePauseEnd ();
+}
+
+void
+RandomWaypointMobilityModel::SchedulePauseEnd (void) const
+{
+  Time pauseEnd = m_walking ? m_legEnd + m_nextPause : m_legEnd;
+  if (!m_pauseEndEvent.IsExpired () && m_pauseEndEvent.GetTs () == static_cast<uint64_t> (pauseEnd.GetTimeStep ()))
+    {
+      return;
+    }
+  Simulator::Remove (m_pauseEndEvent);
+  m_pauseEndEvent = Simulator::Schedule (pauseEnd - Simulator::Now (), &RandomWaypointMobilityModel::CatchUp, this);
+}
+
+void
+RandomWaypointMobilityModel::CatchUp (void) const
+{
+  Time now = Simulator::Now ();
+  if (m_legEnd > now)
+    {
+      return;
+    }
+  while (m_legEnd <= now)
+    {
+      m_legStart = m_legEnd;
+      if (m_walking)
+        {
+          // the destination was reached at the end of the walk
+          m_walking = false;
+          m_legStartPosition = m_destination;
+          m_legEnd = m_legStart + m_nextPause;
+        }
+      else
+        {
+          NS_ASSERT_MSG (m_position, "No position allocator added before using this model");
+          m_walking = true;
+          m_destination = m_position->GetNext ();
+          double speed = m_speed->GetValue ();
+          double dx = (m_destination.x - m_legStartPosition.x);
+          double dy = (m_destination.y - m_legStartPosition.y);
+          double dz = (m_destination.z - m_legStartPosition.z);
+          double k = speed / std::sqrt (dx*dx + dy*dy + dz*dz);
+          m_velocity = Vector (k*dx, k*dy, k*dz);
+          m_legEnd = m_legStart + Seconds (CalculateDistance (m_destination, m_legStartPosition) / speed);
+          // draw the pause which follows the walk now, so that its end can be scheduled
+          m_nextPause = Seconds (m_pause->GetValue ());
+        }
+    }
+  SchedulePauseEnd ();
+  NotifyCourseChange ();
+}
+
 Vector
 RandomWaypointMobilityModel::DoGetPosition (void) const
 {
+  if (m_lazy)
+    {
+      CatchUp ();
+      if (!m_walking)
+        {
+          return m_legStartPosition;
+        }
+      double t = (Simulator::Now () - m_legStart).GetSeconds ();
+      return Vector (m_legStartPosition.x + m_velocity.x * t,
+                     m_legStartPosition.y + m_velocity.y * t,
+                     m_legStartPosition.z + m_velocity.z * t);
+    }
   m_helper.Update ();
   return m_helper.GetCurrentPosition ();
 }
 void 
 RandomWaypointMobilityModel::DoSetPosition (const Vector &position)
 {
+  if (m_lazy)
+    {
+      // the pause starts at the new position now, as in the default mode
+      m_helper.SetPosition (position);
+      StartPause (position);
+      NotifyCourseChange ();
+      return;
+    }
   m_helper.SetPosition (position);
   Simulator::Remove (m_event);
   m_event = Simulator::ScheduleNow (&RandomWaypointMobilityModel::DoInitializePrivate, this);
@@ -110,6 +216,11 @@ RandomWaypointMobilityModel::DoSetPosition (const Vector &position)
 Vector
 RandomWaypointMobilityModel::DoGetVelocity (void) const
 {
+  if (m_lazy)
+    {
+      CatchUp ();
+      return m_walking ? m_velocity : Vector (0.0, 0.0, 0.0);
+    }
   return m_helper.GetVelocity ();
 }
 int64_t
@@ -25,6 +25,7 @@
 #include "position-allocator.h"
 #include "ns3/ptr.h"
 #include "ns3/random-variable-stream.h"
+#include "ns3/event-id.h"
 
 namespace ns3 {
 
@@ -48,6 +49,21 @@ namespace ns3 {
  * a 3d random waypoint position model to this mobility model, the model 
  * will still work. There is no 3d position allocator for now but it should
  * be trivial to add one.
+ *
+ * By default, the end of each pause and of each walk is a scheduled event.
+ * With many nodes, these events can dominate the simulation, even though
+ * the positions are only queried now and then. If the Lazy attribute is
+ * set, the pauses and walks which ended since the last query are played
+ * back when the position or the velocity is queried, and the course change
+ * is notified at that time. Only the end of each pause is still scheduled,
+ * so that the start of each walk is notified even if the model is not
+ * queried: the observers of the course changes which bound how far a node
+ * can move from its speed (e.g., the grid of YansWifiChannel) are then
+ * never stale. The end of a walk is notified at the next query or at the
+ * end of the following pause. The waypoints, speeds and pauses follow the
+ * same distributions as in the default mode, but the random variables (and
+ * a PositionAllocator shared by several nodes) are not drawn in the same
+ * order.
  */
 class RandomWaypointMobilityModel : public MobilityModel
 {
@@ -57,6 +73,7 @@ public:
    * \return the object TypeId
    */
   static TypeId GetTypeId (void);
+  RandomWaypointMobilityModel ();
 protected:
   virtual void DoInitialize (void);
 private:
@@ -68,6 +85,21 @@ private:
    * Begin current pause event, schedule future walk event
    */
   void DoInitializePrivate (void);
+  /**
+   * In lazy mode, begin a pause at the given position now
+   * \param position the position
+   */
+  void StartPause (const Vector &position) const;
+  /**
+   * In lazy mode, play back the pauses and walks which ended since the last
+   * call, and notify a course change if there was any
+   */
+  void CatchUp (void) const;
+  /**
+   * In lazy mode, schedule CatchUp at the end of the current or next pause,
+   * unless it is already scheduled then
+   */
+  void SchedulePauseEnd (void) const;
   virtual Vector DoGetPosition (void) const;
   virtual void DoSetPosition (const Vector &position);
   virtual Vector DoGetVelocity (void) const;
@@ -78,6 +110,16 @@ private:
   Ptr<RandomVariableStream> m_speed; //!< random variable to generate speeds
   Ptr<RandomVariableStream> m_pause; //!< random variable to generate pauses
   EventId m_event; //!< event ID of next scheduled event
+  bool m_lazy; //!< whether the pauses and walks are played back upon queries rather than scheduled
+
+  mutable bool m_walking; //!< in lazy mode, whether the current leg is a walk (or a pause)
+  mutable Time m_legStart; //!< in lazy mode, the start time of the current leg
+  mutable Time m_legEnd; //!< in lazy mode, the end time of the current leg
+  mutable Vector m_legStartPosition; //!< in lazy mode, the position at the start of the current leg
+  mutable Vector m_destination; //!< in lazy mode, the destination of the current walk
+  mutable Vector m_velocity; //!< in lazy mode, the velocity during the current walk
+  mutable Time m_nextPause; //!< in lazy mode, the duration of the pause following the current walk
+  mutable EventId m_pauseEndEvent; //!< in lazy mode, the event at the end of the current or next pause
 };
 
 } // namespace ns3
@@ -126,7 +126,8 @@ public:
     : TestCase (name),
       m_timeLimit (timeLimit),
       m_nodeCount (nodes),
-      m_nextRefPoint (0)
+      m_nextRefPoint (0),
+      m_window (0)
   {
   }
   /// Empty
@@ -138,6 +139,11 @@ public:
   {
     m_trace = trace;
   }
+  /// Read the trace in time windows of the given duration
+  void SetStreaming (Time window)
+  {
+    m_window = window;
+  }
   /// Add next reference point
   void AddReferencePoint (ReferencePoint const & r)
   {
@@ -162,6 +168,8 @@ private:
   size_t m_nextRefPoint;
   /// TMP trace file name
   std::string m_traceFile;
+  /// Duration of a time window in streaming mode, zero if disabled
+  Time m_window;
 
 private:
   /// Dump NS-2 trace to tmp file
@@ -254,6 +262,10 @@ private:
         return;
       }
     Ns2MobilityHelper mobility (m_traceFile);
+    if (!m_window.IsZero ())
+      {
+        mobility.EnableStreaming (m_window);
+      }
     mobility.Install ();
     if (CheckInitialPositions ())
       {
@@ -532,5 +544,63 @@ public:
     t->AddReferencePoint ("0", 920.000, Vector (300.000,  650.000, 0.000), Vector (0.000, 0.000, 0.000));
     AddTestCase (t, TestCase::QUICK);
 
+    // Streaming mode, with time windows shorter than the movements, and
+    // with the statements of the nodes interleaved
+    t = new Ns2MobilityHelperTest ("streaming, few nodes", Seconds (10), 3);
+    t->SetStreaming (Seconds (1));
+    t->SetTrace ("$node_(0) set X_ 1.0\n"
+                 "$node_(0) set Y_ 2.0\n"
+                 "$node_(0) set Z_ 3.0\n"
+                 "$ns_ at 1.0 \"$node_(1) setdest 25 0 5\"\n"
+                 "$ns_ at 1.0 \"$node_(2) setdest 5  0  5\"\n"
+                 "$ns_ at 2.0 \"$node_(2) setdest 5  5  5\"\n"
+                 "# comment\n"
+                 "$ns_ at 3.0 \"$node_(2) setdest 0  5  5\"\n"
+                 "$ns_ at 3.5 \"$node_(0) set X_ 10\"\n"
+                 "$ns_ at 4.0 \"$node_(2) setdest 0  0  5\"\n"
+                 "$node_(2) set X_ 0.0\n"
+                 "$node_(2) set Y_ 0.0\n");
+    //                     id  t  position         velocity
+    t->AddReferencePoint ("0", 0, Vector (1, 2, 3), Vector (0, 0, 0));
+    t->AddReferencePoint ("1", 0, Vector (0, 0, 0), Vector (0, 0, 0));
+    t->AddReferencePoint ("2", 0, Vector (0, 0, 0), Vector (0,  0, 0));
+    t->AddReferencePoint ("1", 1, Vector (0, 0, 0), Vector (5, 0, 0));
+    t->AddReferencePoint ("2", 1, Vector (0, 0, 0), Vector (5,  0, 0));
+    t->AddReferencePoint ("2", 2, Vector (5, 0, 0), Vector (0,  0, 0));
+    t->AddReferencePoint ("2", 2, Vector (5, 0, 0), Vector (0,  5, 0));
+    t->AddReferencePoint ("2", 3, Vector (5, 5, 0), Vector (0,  0, 0));
+    t->AddReferencePoint ("2", 3, Vector (5, 5, 0), Vector (-5, 0, 0));
+    t->AddReferencePoint ("0", 3.5, Vector (10, 2, 3), Vector (0, 0, 0));
+    t->AddReferencePoint ("2", 4, Vector (0, 5, 0), Vector (0, 0, 0));
+    t->AddReferencePoint ("2", 4, Vector (0, 5, 0), Vector (0, -5, 0));
+    t->AddReferencePoint ("2", 5, Vector (0, 0, 0), Vector (0,  0, 0));
+    t->AddReferencePoint ("1", 6, Vector (25, 0, 0), Vector (0, 0, 0));
+    AddTestCase (t, TestCase::QUICK);
+
+    t = new Ns2MobilityHelperTest ("Bug 1316 testcase, streaming", Seconds (1000));
+    t->SetStreaming (Seconds (30));
+    t->SetTrace ("$node_(0) set X_ 350.00000000000000\n"
+                 "$node_(0) set Y_ 50.00000000000000\n"
+                 "$ns_ at 50.00000000000000  \"$node_(0) setdest 400.00000000000000 50.00000000000000 1.00000000000000\"\n"
+                 "$ns_ at 150.00000000000000 \"$node_(0) setdest 400.00000000000000 150.00000000000000 4.00000000000000\"\n"
+                 "$ns_ at 300.00000000000000 \"$node_(0) setdest 250.00000000000000 150.00000000000000 3.00000000000000\"\n"
+                 "$ns_ at 350.00000000000000 \"$node_(0) setdest 250.00000000000000 50.00000000000000 1.00000000000000\"\n"
+                 "$ns_ at 600.00000000000000 \"$node_(0) setdest 250.00000000000000 1050.00000000000000 2.00000000000000\"\n"
+                 "$ns_ at 900.00000000000000 \"$node_(0) setdest 300.00000000000000 650.00000000000000 2.50000000000000\"\n"
+                 );
+    t->AddReferencePoint ("0", 0.000, Vector (350.000, 50.000, 0.000), Vector (0.000, 0.000, 0.000));
+    t->AddReferencePoint ("0", 50.000, Vector (350.000, 50.000, 0.000), Vector (1.000, 0.000, 0.000));
+    t->AddReferencePoint ("0", 100.000, Vector (400.000, 50.000, 0.000), Vector (0.000, 0.000, 0.000));
+    t->AddReferencePoint ("0", 150.000, Vector (400.000, 50.000, 0.000), Vector (0.000, 4.000, 0.000));
+    t->AddReferencePoint ("0", 175.000, Vector (400.000, 150.000, 0.000), Vector (0.000, 0.000, 0.000));
+    t->AddReferencePoint ("0", 300.000, Vector (400.000, 150.000, 0.000), Vector (-3.000, 0.000, 0.000));
+    t->AddReferencePoint ("0", 350.000, Vector (250.000, 150.000, 0.000), Vector (0.000, 0.000, 0.000));
+    t->AddReferencePoint ("0", 350.000, Vector (250.000, 150.000, 0.000), Vector (0.000, -1.000, 0.000));
+    t->AddReferencePoint ("0", 450.000, Vector (250.000,  50.000, 0.000), Vector (0.000, 0.000, 0.000));
+    t->AddReferencePoint ("0", 600.000, Vector (250.000,  50.000, 0.000), Vector (0.000, 2.000, 0.000));
+    t->AddReferencePoint ("0", 900.000, Vector (250.000,  650.000, 0.000), Vector (2.500, 0.000, 0.000));
+    t->AddReferencePoint ("0", 920.000, Vector (300.000,  650.000, 0.000), Vector (0.000, 0.000, 0.000));
+    AddTestCase (t, TestCase::QUICK);
+
   }
 } g_ns2TransmobilityHelperTestSuite; ///< the test suite
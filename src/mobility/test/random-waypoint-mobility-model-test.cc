@@ -0,0 +1,178 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/simulator.h"
+#include "ns3/boolean.h"
+#include "ns3/pointer.h"
+#include "ns3/string.h"
+#include "ns3/test.h"
+#include "ns3/random-waypoint-mobility-model.h"
+#include "ns3/position-allocator.h"
+
+using namespace ns3;
+
+/**
+ * \ingroup mobility-test
+ * \ingroup tests
+ *
+ * \brief Random Waypoint Lazy Mode Test
+ *
+ * Check that a random waypoint model in lazy mode follows the same
+ * trajectory as in the default mode (with constant speeds and pauses and
+ * a list of waypoints), and that it only schedules an event at the end of
+ * each pause.
+ */
+class RandomWaypointLazyTest : public TestCase
+{
+public:
+  RandomWaypointLazyTest ()
+    : TestCase ("Check the lazy mode of the random waypoint mobility model") {}
+  virtual ~RandomWaypointLazyTest () {}
+
+private:
+  virtual void DoRun (void);
+  /**
+   * Create a random waypoint model
+   * \param lazy whether to use the lazy mode
+   * \return the model
+   */
+  Ptr<MobilityModel> CreateModel (bool lazy);
+  /// Compare the positions and velocities of the two models
+  void Compare (void);
+  /// Query the position of the lazy model
+  void Query (void);
+
+  Ptr<MobilityModel> m_eager; ///< the model in default mode
+  Ptr<MobilityModel> m_lazy;  ///< the model in lazy mode
+  uint32_t m_courseChanges;   ///< number of course changes of the lazy model
+};
+
+Ptr<MobilityModel>
+RandomWaypointLazyTest::CreateModel (bool lazy)
+{
+  Ptr<ListPositionAllocator> waypoints = CreateObject<ListPositionAllocator> ();
+  waypoints->Add (Vector (10, 0, 0));
+  waypoints->Add (Vector (10, 10, 0));
+  waypoints->Add (Vector (0, 10, 5));
+  waypoints->Add (Vector (0, 0, 0));
+  Ptr<MobilityModel> model = CreateObject<RandomWaypointMobilityModel> ();
+  model->SetAttribute ("Speed", StringValue ("ns3::ConstantRandomVariable[Constant=2.0]"));
+  model->SetAttribute ("Pause", StringValue ("ns3::ConstantRandomVariable[Constant=1.5]"));
+  model->SetAttribute ("PositionAllocator", PointerValue (waypoints));
+  model->SetAttribute ("Lazy", BooleanValue (lazy));
+  model->SetPosition (Vector (0, 0, 0));
+  model->Initialize ();
+  return model;
+}
+
+void
+RandomWaypointLazyTest::Compare (void)
+{
+  Vector eager = m_eager->GetPosition ();
+  Vector lazy = m_lazy->GetPosition ();
+  NS_TEST_EXPECT_MSG_EQ_TOL (lazy.x, eager.x, 1e-6, "Unexpected x-position at " << Simulator::Now ().GetSeconds ());
+  NS_TEST_EXPECT_MSG_EQ_TOL (lazy.y, eager.y, 1e-6, "Unexpected y-position at " << Simulator::Now ().GetSeconds ());
+  NS_TEST_EXPECT_MSG_EQ_TOL (lazy.z, eager.z, 1e-6, "Unexpected z-position at " << Simulator::Now ().GetSeconds ());
+  Vector eagerVelocity = m_eager->GetVelocity ();
+  Vector lazyVelocity = m_lazy->GetVelocity ();
+  NS_TEST_EXPECT_MSG_EQ_TOL (lazyVelocity.x, eagerVelocity.x, 1e-9, "Unexpected x-velocity at " << Simulator::Now ().GetSeconds ());
+  NS_TEST_EXPECT_MSG_EQ_TOL (lazyVelocity.y, eagerVelocity.y, 1e-9, "Unexpected y-velocity at " << Simulator::Now ().GetSeconds ());
+  NS_TEST_EXPECT_MSG_EQ_TOL (lazyVelocity.z, eagerVelocity.z, 1e-9, "Unexpected z-velocity at " << Simulator::Now ().GetSeconds ());
+}
+
+void
+RandomWaypointLazyTest::Query (void)
+{
+  m_lazy->GetPosition ();
+}
+
+static void
+CountCourseChanges (uint32_t *count, Ptr<const MobilityModel> model)
+{
+  (*count)++;
+}
+
+void
+RandomWaypointLazyTest::DoRun (void)
+{
+  // sample the positions off the waypoint times, during pauses and walks
+  m_eager = CreateModel (false);
+  m_lazy = CreateModel (true);
+  for (double t = 0.25; t < 60; t += 0.5)
+    {
+      Simulator::Schedule (Seconds (t), &RandomWaypointLazyTest::Compare, this);
+    }
+  Simulator::Stop (Seconds (60));
+  Simulator::Run ();
+  Simulator::Destroy ();
+  m_eager = 0;
+
+  // the lazy model alone only schedules the ends of the pauses, at 1.5 s
+  // and 8 s, where the walks start; the end of the first walk, at 6.5 s,
+  // is notified upon the next query
+  m_courseChanges = 0;
+  m_lazy = CreateModel (true);
+  m_lazy->TraceConnectWithoutContext ("CourseChange", MakeBoundCallback (&CountCourseChanges, &m_courseChanges));
+  uint64_t events = Simulator::GetEventCount ();
+  Simulator::Schedule (Seconds (0.5), &RandomWaypointLazyTest::Query, this);
+  Simulator::Schedule (Seconds (7), &RandomWaypointLazyTest::Query, this);
+  Simulator::Schedule (Seconds (7), &RandomWaypointLazyTest::Query, this);
+  Simulator::Stop (Seconds (10));
+  Simulator::Run ();
+  NS_TEST_EXPECT_MSG_EQ (Simulator::GetEventCount () - events, 6, "The lazy model should only schedule the ends of the pauses");
+  NS_TEST_EXPECT_MSG_EQ (m_courseChanges, 3, "Unexpected number of course changes");
+  Simulator::Destroy ();
+  m_lazy = 0;
+
+  // a model made lazy after its position is set starts from that position,
+  // and the event scheduled when the position was set is cancelled
+  m_lazy = CreateObject<RandomWaypointMobilityModel> ();
+  m_lazy->SetAttribute ("Pause", StringValue ("ns3::ConstantRandomVariable[Constant=1.5]"));
+  m_lazy->SetAttribute ("PositionAllocator", PointerValue (CreateObject<ListPositionAllocator> ()));
+  m_lazy->SetPosition (Vector (5, 5, 0));
+  m_lazy->SetAttribute ("Lazy", BooleanValue (true));
+  m_lazy->Initialize ();
+  events = Simulator::GetEventCount ();
+  Simulator::Schedule (Seconds (0.5), &RandomWaypointLazyTest::Query, this);
+  Simulator::Stop (Seconds (1));
+  Simulator::Run ();
+  NS_TEST_EXPECT_MSG_EQ (Simulator::GetEventCount () - events, 2, "The lazy model should not schedule events during the pause");
+  Vector position = m_lazy->GetPosition ();
+  NS_TEST_EXPECT_MSG_EQ (position.x, 5, "Unexpected x-position");
+  NS_TEST_EXPECT_MSG_EQ (position.y, 5, "Unexpected y-position");
+
+  // moving the model notifies a course change
+  m_courseChanges = 0;
+  m_lazy->TraceConnectWithoutContext ("CourseChange", MakeBoundCallback (&CountCourseChanges, &m_courseChanges));
+  m_lazy->SetPosition (Vector (20, 5, 0));
+  NS_TEST_EXPECT_MSG_EQ (m_courseChanges, 1, "Setting the position should notify a course change");
+  Simulator::Destroy ();
+  m_lazy = 0;
+}
+
+/**
+ * \ingroup mobility-test
+ * \ingroup tests
+ *
+ * \brief Random Waypoint Test Suite
+ */
+struct RandomWaypointTestSuite : public TestSuite
+{
+  RandomWaypointTestSuite () : TestSuite ("random-waypoint-mobility-model", UNIT)
+  {
+    AddTestCase (new RandomWaypointLazyTest, TestCase::QUICK);
+  }
+} g_randomWaypointTestSuite; ///< the test suite
@@ -20,6 +20,7 @@
 
 #include "ns3/assert.h"
 #include "ns3/log.h"
+#include "ns3/hash.h"
 #include "address.h"
 #include <cstring>
 #include <iostream>
@@ -232,6 +233,13 @@ bool operator < (const Address &a, const Address &b)
   return false;
 }
 
+size_t AddressHash::operator() (Address const &x) const
+{
+  uint8_t buffer[Address::MAX_SIZE];
+  uint32_t len = x.CopyTo (buffer);
+  return Hash32 (reinterpret_cast<const char *> (buffer), len);
+}
+
 std::ostream& operator<< (std::ostream& os, const Address & address)
 {
   os.setf (std::ios::hex, std::ios::basefield);
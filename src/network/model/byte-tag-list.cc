@@ -194,19 +194,7 @@ ByteTagList::Add (TypeId tid, uint32_t bufferSize, int32_t start, int32_t end)
   NS_LOG_FUNCTION (this << tid << bufferSize << start << end);
   uint32_t spaceNeeded = m_used + bufferSize + 4 + 4 + 4 + 4;
   NS_ASSERT (m_used <= spaceNeeded);
-  if (m_data == 0)
-    {
-      m_data = Allocate (spaceNeeded);
-      m_used = 0;
-    } 
-  else if (m_data->size < spaceNeeded ||
-           (m_data->count != 1 && m_data->dirty != m_used))
-    {
-      struct ByteTagListData *newData = Allocate (spaceNeeded);
-      std::memcpy (&newData->data, &m_data->data, m_used);
-      Deallocate (m_data);
-      m_data = newData;
-    }
+  Reserve (spaceNeeded);
   TagBuffer tag = TagBuffer (&m_data->data[m_used], 
                              &m_data->data[spaceNeeded]);
   tag.WriteU32 (tid.GetUid ());
@@ -226,10 +214,33 @@ ByteTagList::Add (TypeId tid, uint32_t bufferSize, int32_t start, int32_t end)
   return tag;
 }
 
+void
+ByteTagList::Reserve (uint32_t size)
+{
+  NS_LOG_FUNCTION (this << size);
+  if (m_data == 0)
+    {
+      m_data = Allocate (size);
+      m_used = 0;
+    }
+  else if (m_data->size < size ||
+           (m_data->count != 1 && m_data->dirty != m_used))
+    {
+      // Grow geometrically so that a sequence of Add calls on the
+      // same list does not reallocate the buffer each time.
+      struct ByteTagListData *newData = Allocate (std::max (size, 2 * m_used));
+      std::memcpy (&newData->data, &m_data->data, m_used);
+      Deallocate (m_data);
+      m_data = newData;
+    }
+}
+
 void 
 ByteTagList::Add (const ByteTagList &o)
 {
   NS_LOG_FUNCTION (this << &o);
+  // make room for all the tags at once
+  Reserve (m_used + o.m_used);
   ByteTagList::Iterator i = o.BeginAll ();
   while (i.HasNext ())
     {
@@ -282,28 +293,7 @@ ByteTagList::AddAtEnd (int32_t appendOffset)
     {
       return;
     }
-  ByteTagList list;
-  ByteTagList::Iterator i = BeginAll ();
-  while (i.HasNext ())
-    {
-      ByteTagList::Iterator::Item item = i.Next ();
-
-      if (item.start >= appendOffset)
-        {
-          continue;
-        }
-      if (item.end > appendOffset)
-        {
-          item.end = appendOffset;
-        }
-      TagBuffer buf = list.Add (item.tid, item.size, item.start, item.end);
-      buf.CopyFrom (item.buf);
-      if (item.end > m_maxEnd)
-        {
-          m_maxEnd = item.end;
-        }
-    }
-  *this = list;
+  Trim (0, appendOffset);
 }
 
 void 
@@ -314,29 +304,62 @@ ByteTagList::AddAtStart (int32_t prependOffset)
     {
       return;
     }
+  Trim (std::max (prependOffset, 0), OFFSET_MAX);
+}
+
+void
+ByteTagList::Trim (int32_t minStart, int32_t maxEnd)
+{
+  NS_LOG_FUNCTION (this << minStart << maxEnd);
+  if (m_data == 0)
+    {
+      return;
+    }
+  // The tags are trimmed in place if we are the only user of the
+  // buffer. Otherwise, they are trimmed while being copied to a
+  // private buffer.
+  struct ByteTagListData *target = m_data;
+  if (m_data->count != 1)
+    {
+      target = Allocate (m_used);
+    }
+  uint8_t *src = m_data->data;
+  uint8_t *srcEnd = &m_data->data[m_used];
+  uint8_t *dst = target->data;
   m_minStart = INT32_MAX;
-  ByteTagList list;
-  ByteTagList::Iterator i = BeginAll ();
-  while (i.HasNext ())
+  m_maxEnd = INT32_MIN;
+  while (src < srcEnd)
     {
-      ByteTagList::Iterator::Item item = i.Next ();
-
-      if (item.end <= prependOffset)
-        {
-          continue;
-        }
-      if (item.start < prependOffset)
+      TagBuffer buf = TagBuffer (src, srcEnd);
+      uint32_t tid = buf.ReadU32 ();
+      uint32_t size = buf.ReadU32 ();
+      int32_t start = buf.ReadU32 () + m_adjustment;
+      int32_t end = buf.ReadU32 () + m_adjustment;
+      if (start < maxEnd && end > minStart)
         {
-          item.start = prependOffset;
-        }
-      TagBuffer buf = list.Add (item.tid, item.size, item.start, item.end);
-      buf.CopyFrom (item.buf);
-      if (item.start < m_minStart)
-        {
-          m_minStart = item.start;
+          start = std::max (start, minStart);
+          end = std::min (end, maxEnd);
+          // the tag data is moved first because the tag header
+          // may overwrite it when trimming in place
+          std::memmove (dst + 4 + 4 + 4 + 4, src + 4 + 4 + 4 + 4, size);
+          TagBuffer tag = TagBuffer (dst, dst + 4 + 4 + 4 + 4);
+          tag.WriteU32 (tid);
+          tag.WriteU32 (size);
+          tag.WriteU32 (start - m_adjustment);
+          tag.WriteU32 (end - m_adjustment);
+          m_minStart = std::min (m_minStart, start - m_adjustment);
+          m_maxEnd = std::max (m_maxEnd, end - m_adjustment);
+          dst += 4 + 4 + 4 + 4 + size;
         }
+      src += 4 + 4 + 4 + 4 + size;
     }
-  *this = list;
+  if (target != m_data)
+    {
+      Deallocate (m_data);
+      m_data = target;
+    }
+  m_used = dst - m_data->data;
+  m_data->dirty = m_used;
 }
 
 #ifdef USE_FREE_LIST
@@ -359,7 +382,8 @@ ByteTagList::Allocate (uint32_t size)
       uint8_t *buffer = (uint8_t *)data;
       delete [] buffer;
     }
-  uint8_t *buffer = new uint8_t [std::max (size, g_maxSize) + sizeof (struct ByteTagListData) - 4];
+  size = std::max (size, g_maxSize);
+  uint8_t *buffer = new uint8_t [size + sizeof (struct ByteTagListData) - 4];
   struct ByteTagListData *data = (struct ByteTagListData *)buffer;
   data->count = 1;
   data->size = size;
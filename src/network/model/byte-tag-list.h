@@ -239,6 +239,27 @@ private:
    */
   ByteTagList::Iterator BeginAll (void) const;
 
+  /**
+   * \brief Make sure that the buffer can be written up to the given size
+   *
+   * The buffer is (re)allocated if it is too small, or if it is shared
+   * and another list has already written past our used bytes.
+   *
+   * \param size the number of bytes that must be writable
+   */
+  void Reserve (uint32_t size);
+
+  /**
+   * \brief Restrict all tags to the [minStart, maxEnd) interval
+   *
+   * Tags that fall outside of the interval are removed and the others are
+   * cut to fit it. This is done in place unless the buffer is shared.
+   *
+   * \param minStart minimum start offset
+   * \param maxEnd maximum end offset
+   */
+  void Trim (int32_t minStart, int32_t maxEnd);
+
   /**
    * \brief Allocate the memory for the ByteTagListData
    * \param size the memory to allocate
@@ -26,6 +26,10 @@
 #include "ns3/assert.h"
 #include "node-list.h"
 #include "node.h"
+#include "net-device.h"
+#include "address.h"
+#include <unordered_map>
+#include <map>
 
 namespace ns3 {
 
@@ -78,6 +82,34 @@ public:
    */
   uint32_t GetNNodes (void);
 
+  /**
+   * \param address the address owned by the node
+   * \param node the node
+   */
+  void AddAddress (const Address &address, Ptr<Node> node);
+
+  /**
+   * \param address the address no longer owned by the node
+   * \param node the node
+   */
+  void RemoveAddress (const Address &address, Ptr<Node> node);
+
+  /**
+   * \param device a device whose address is to be recorded
+   */
+  void AddDevice (Ptr<NetDevice> device);
+
+  /**
+   * \param device a device whose address has changed
+   */
+  void NotifyAddressChange (Ptr<NetDevice> device);
+
+  /**
+   * \param address the requested address
+   * \returns the node owning the given address, or 0
+   */
+  Ptr<Node> GetNodeByAddress (const Address &address);
+
   /**
    * \brief Get the node list object
    * \returns the node list
@@ -101,7 +133,33 @@ private:
    */
   virtual void DoDispose (void);
 
+  /**
+   * \brief Record the addresses of the devices added since the last lookup
+   */
+  void RecordNewDevices (void);
+
+  /**
+   * \param address the requested address
+   * \returns the node owning the given address according to the index, or 0
+   *
+   * The entries recorded for a device whose address has changed without
+   * notification are skipped.
+   */
+  Ptr<Node> FindNode (const Address &address) const;
+
+  /// Owner of an indexed address
+  struct AddressOwner
+  {
+    uint32_t nodeId;          //!< the id of the node
+    Ptr<NetDevice> device;    //!< the device if this is its address, 0 otherwise
+  };
+  /// Address index container, the owners of each address in the order they registered it
+  typedef std::unordered_map<Address, std::vector<AddressOwner>, AddressHash> AddressIndex;
+
   std::vector<Ptr<Node> > m_nodes; //!< node objects container
+  AddressIndex m_addresses; //!< owners of each address
+  std::vector<Ptr<NetDevice> > m_newDevices; //!< devices whose address is not recorded yet
+  std::map<Ptr<NetDevice>, Address> m_devices; //!< devices whose address is recorded, and the address
 };
 
 NS_OBJECT_ENSURE_REGISTERED (NodeListPriv);
@@ -168,6 +226,9 @@ NodeListPriv::DoDispose (void)
       *i = 0;
     }
   m_nodes.erase (m_nodes.begin (), m_nodes.end ());
+  m_addresses.clear ();
+  m_newDevices.clear ();
+  m_devices.clear ();
   Object::DoDispose ();
 }
 
@@ -210,6 +271,123 @@ NodeListPriv::GetNode (uint32_t n)
   return m_nodes[n];
 }
 
+void
+NodeListPriv::AddAddress (const Address &address, Ptr<Node> node)
+{
+  NS_LOG_FUNCTION (this << address << node);
+  AddressOwner owner;
+  owner.nodeId = node->GetId ();
+  m_addresses[address].push_back (owner);
+}
+
+void
+NodeListPriv::RemoveAddress (const Address &address, Ptr<Node> node)
+{
+  NS_LOG_FUNCTION (this << address << node);
+  AddressIndex::iterator it = m_addresses.find (address);
+  if (it == m_addresses.end ())
+    {
+      return;
+    }
+  for (std::vector<AddressOwner>::iterator i = it->second.begin (); i != it->second.end (); i++)
+    {
+      if (i->device == 0 && i->nodeId == node->GetId ())
+        {
+          it->second.erase (i);
+          break;
+        }
+    }
+  if (it->second.empty ())
+    {
+      m_addresses.erase (it);
+    }
+}
+
+void
+NodeListPriv::AddDevice (Ptr<NetDevice> device)
+{
+  NS_LOG_FUNCTION (this << device);
+  m_newDevices.push_back (device);
+}
+
+void
+NodeListPriv::RecordNewDevices (void)
+{
+  NS_LOG_FUNCTION (this);
+  for (std::vector<Ptr<NetDevice> >::const_iterator i = m_newDevices.begin ();
+       i != m_newDevices.end (); i++)
+    {
+      AddressOwner owner;
+      owner.nodeId = (*i)->GetNode ()->GetId ();
+      owner.device = *i;
+      Address address = (*i)->GetAddress ();
+      m_addresses[address].push_back (owner);
+      m_devices[*i] = address;
+    }
+  m_newDevices.clear ();
+}
+
+void
+NodeListPriv::NotifyAddressChange (Ptr<NetDevice> device)
+{
+  NS_LOG_FUNCTION (this << device);
+  std::map<Ptr<NetDevice>, Address>::iterator it = m_devices.find (device);
+  if (it == m_devices.end ())
+    {
+      // not recorded yet, the current address will be
+      return;
+    }
+  Address address = device->GetAddress ();
+  if (address == it->second)
+    {
+      return;
+    }
+  std::vector<AddressOwner> &owners = m_addresses[it->second];
+  for (std::vector<AddressOwner>::iterator i = owners.begin (); i != owners.end (); i++)
+    {
+      if (i->device == device)
+        {
+          owners.erase (i);
+          break;
+        }
+    }
+  if (owners.empty ())
+    {
+      m_addresses.erase (it->second);
+    }
+  AddressOwner owner;
+  owner.nodeId = device->GetNode ()->GetId ();
+  owner.device = device;
+  m_addresses[address].push_back (owner);
+  it->second = address;
+}
+
+Ptr<Node>
+NodeListPriv::FindNode (const Address &address) const
+{
+  AddressIndex::const_iterator it = m_addresses.find (address);
+  if (it == m_addresses.end ())
+    {
+      return 0;
+    }
+  for (std::vector<AddressOwner>::const_iterator i = it->second.begin (); i != it->second.end (); i++)
+    {
+      if (i->device == 0 || i->device->GetAddress () == address)
+        {
+          return m_nodes[i->nodeId];
+        }
+    }
+  return 0;
+}
+
+Ptr<Node>
+NodeListPriv::GetNodeByAddress (const Address &address)
+{
+  NS_LOG_FUNCTION (this << address);
+  RecordNewDevices ();
+  return FindNode (address);
+}
+
 }
 
 /**
@@ -249,5 +427,35 @@ NodeList::GetNNodes (void)
   NS_LOG_FUNCTION_NOARGS ();
   return NodeListPriv::Get ()->GetNNodes ();
 }
+void
+NodeList::AddAddress (const Address &address, Ptr<Node> node)
+{
+  NS_LOG_FUNCTION (address << node);
+  NodeListPriv::Get ()->AddAddress (address, node);
+}
+void
+NodeList::RemoveAddress (const Address &address, Ptr<Node> node)
+{
+  NS_LOG_FUNCTION (address << node);
+  NodeListPriv::Get ()->RemoveAddress (address, node);
+}
+void
+NodeList::AddDevice (Ptr<NetDevice> device)
+{
+  NS_LOG_FUNCTION (device);
+  NodeListPriv::Get ()->AddDevice (device);
+}
+void
+NodeList::NotifyAddressChange (Ptr<NetDevice> device)
+{
+  NS_LOG_FUNCTION (device);
+  NodeListPriv::Get ()->NotifyAddressChange (device);
+}
+Ptr<Node>
+NodeList::GetNodeByAddress (const Address &address)
+{
+  NS_LOG_FUNCTION (address);
+  return NodeListPriv::Get ()->GetNodeByAddress (address);
+}
 
 } // namespace ns3
@@ -28,6 +28,8 @@ namespace ns3 {
 
 class Node;
 class CallbackBase;
+class Address;
+class NetDevice;
 
 
 /**
@@ -70,6 +72,53 @@ public:
    * \returns the number of nodes currently in the list.
    */
   static uint32_t GetNNodes (void);
+
+  /**
+   * \param address the address owned by the node
+   * \param node the node
+   *
+   * Record that the given node owns the given (e.g., IP) address, so
+   * that the node can be found by GetNodeByAddress. This method is
+   * called automatically when an address is added to an IPv4 or IPv6
+   * interface, except for the loopback and link-local addresses, which
+   * are shared by all the nodes.
+   */
+  static void AddAddress (const Address &address, Ptr<Node> node);
+  /**
+   * \param address the address no longer owned by the node
+   * \param node the node
+   *
+   * Forget that the given node owns the given address.
+   */
+  static void RemoveAddress (const Address &address, Ptr<Node> node);
+  /**
+   * \param device a device that was just added to its node
+   *
+   * Record the address of the given device, so that its node can be
+   * found by GetNodeByAddress. Since the address of a device may not
+   * be available yet when the device is added to its node, it is
+   * recorded upon the next call to GetNodeByAddress. This method is
+   * called automatically by Node::AddDevice.
+   */
+  static void AddDevice (Ptr<NetDevice> device);
+  /**
+   * \param device a device whose address has changed
+   *
+   * Update the recorded address of the given device. This method is
+   * called by the NetDevice::SetAddress implementations; a device
+   * whose address changes otherwise (e.g., through its MAC layer) is
+   * no longer found by its new address until it calls this method.
+   */
+  static void NotifyAddressChange (Ptr<NetDevice> device);
+  /**
+   * \param address the requested address
+   * \returns the node owning the given address, or 0 if no such node
+   *          is known. If several nodes own the address (e.g., the
+   *          all-zero MAC address of the loopback devices, or an address
+   *          configured twice), the one that registered it first is
+   *          returned.
+   */
+  static Ptr<Node> GetNodeByAddress (const Address &address);
 };
 
 } // namespace ns3
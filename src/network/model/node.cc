@@ -77,7 +77,9 @@ Node::GetTypeId (void)
 
 Node::Node()
   : m_id (0),
-    m_sid (0)
+    m_sid (0),
+    m_dispatching (0),
+    m_dispatchStale (false)
 {
   NS_LOG_FUNCTION (this);
   Construct ();
@@ -85,7 +87,9 @@ Node::Node()
 
 Node::Node(uint32_t sid)
   : m_id (0),
-    m_sid (sid)
+    m_sid (sid),
+    m_dispatching (0),
+    m_dispatchStale (false)
 { 
   NS_LOG_FUNCTION (this << sid);
   Construct ();
@@ -133,6 +137,7 @@ Node::AddDevice (Ptr<NetDevice> device)
   device->SetNode (this);
   device->SetIfIndex (index);
   device->SetReceiveCallback (MakeCallback (&Node::NonPromiscReceiveFromDevice, this));
+  NodeList::AddDevice (device);
   Simulator::ScheduleWithContext (GetId (), Seconds (0.0), 
                                   &NetDevice::Initialize, device);
   NotifyDeviceAdded (device);
@@ -185,6 +190,7 @@ Node::DoDispose ()
   NS_LOG_FUNCTION (this);
   m_deviceAdditionListeners.clear ();
   m_handlers.clear ();
+  m_dispatch.clear ();
   for (std::vector<Ptr<NetDevice> >::iterator i = m_devices.begin ();
        i != m_devices.end (); i++)
     {
@@ -255,6 +261,7 @@ Node::RegisterProtocolHandler (ProtocolHandler handler,
     }
 
   m_handlers.push_back (entry);
+  FlushDispatchTable ();
 }
 
 void
@@ -267,11 +274,20 @@ Node::UnregisterProtocolHandler (ProtocolHandler handler)
       if (i->handler.IsEqual (handler))
         {
           m_handlers.erase (i);
+          FlushDispatchTable ();
           break;
         }
     }
 }
 
+uint64_t
+Node::GetDispatchKey (Ptr<NetDevice> device, uint16_t protocol, bool promiscuous)
+{
+  return (static_cast<uint64_t> (device->GetIfIndex ()) << 17)
+         | (static_cast<uint64_t> (protocol) << 1)
+         | (promiscuous ? 1 : 0);
+}
+
 bool
 Node::ChecksumEnabled (void)
 {
@@ -308,27 +324,57 @@ Node::ReceiveFromDevice (Ptr<NetDevice> device, Ptr<const Packet> packet, uint16
   NS_LOG_DEBUG ("Node " << GetId () << " ReceiveFromDevice:  dev "
                         << device->GetIfIndex () << " (type=" << device->GetInstanceTypeId ().GetName ()
                         << ") Packet UID " << packet->GetUid ());
-  bool found = false;
-
-  for (ProtocolHandlerList::iterator i = m_handlers.begin ();
-       i != m_handlers.end (); i++)
+  uint64_t key = GetDispatchKey (device, protocol, promiscuous);
+  ProtocolHandlerDispatch::iterator it = m_dispatch.find (key);
+  if (it == m_dispatch.end ())
     {
-      if (i->device == 0 ||
-          (i->device != 0 && i->device == device))
+      // First packet for this (device, protocol, promiscuous) triple since
+      // the handlers last changed: collect the matching handlers once.
+      std::vector<ProtocolHandler> handlers;
+      for (ProtocolHandlerList::const_iterator i = m_handlers.begin ();
+           i != m_handlers.end (); i++)
         {
-          if (i->protocol == 0 || 
-              i->protocol == protocol)
+          if ((i->device == 0 || i->device == device)
+              && (i->protocol == 0 || i->protocol == protocol)
+              && promiscuous == i->promiscuous)
             {
-              if (promiscuous == i->promiscuous)
-                {
-                  i->handler (device, packet, protocol, from, to, packetType);
-                  found = true;
-                }
+              handlers.push_back (i->handler);
             }
         }
+      it = m_dispatch.insert (std::make_pair (key, handlers)).first;
+    }
+
+  // Handlers are allowed to (un)register other handlers: flushing the
+  // dispatch table is then deferred until this delivery is over.
+  m_dispatching++;
+  const std::vector<ProtocolHandler> &handlers = it->second;
+  for (std::vector<ProtocolHandler>::const_iterator i = handlers.begin ();
+       i != handlers.end (); i++)
+    {
+      (*i) (device, packet, protocol, from, to, packetType);
+    }
+  bool found = !handlers.empty ();
+  m_dispatching--;
+  if (m_dispatching == 0 && m_dispatchStale)
+    {
+      FlushDispatchTable ();
     }
   return found;
 }
+
+void
+Node::FlushDispatchTable (void)
+{
+  NS_LOG_FUNCTION (this);
+  if (m_dispatching > 0)
+    {
+      m_dispatchStale = true;
+      return;
+    }
+  m_dispatch.clear ();
+  m_dispatchStale = false;
+}
+
 void 
 Node::RegisterDeviceAdditionListener (DeviceAdditionListener listener)
 {
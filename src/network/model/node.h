@@ -22,6 +22,7 @@
 #define NODE_H
 
 #include <vector>
+#include <map>
 
 #include "ns3/object.h"
 #include "ns3/callback.h"
@@ -266,6 +267,23 @@ private:
    */
   void Construct (void);
 
+  /**
+   * \brief Build the dispatch key of a (device, protocol, promiscuous) triple.
+   * \param device the device
+   * \param protocol the protocol
+   * \param promiscuous true if received in promiscuous mode
+   * \returns the key used to index the dispatch table
+   */
+  static uint64_t GetDispatchKey (Ptr<NetDevice> device, uint16_t protocol, bool promiscuous);
+
+  /**
+   * \brief Invalidate the protocol handler dispatch table.
+   *
+   * If a packet is being delivered, the table is flushed once the
+   * delivery is over.
+   */
+  void FlushDispatchTable (void);
+
   /**
    * \brief Protocol handler entry.
    * This structure is used to demultiplex all the protocols.
@@ -281,12 +299,24 @@ private:
   typedef std::vector<struct Node::ProtocolHandlerEntry> ProtocolHandlerList;
   /// Typedef for NetDevice addition listeners container
   typedef std::vector<DeviceAdditionListener> DeviceAdditionListenerList;
+  /**
+   * Typedef for the protocol handler dispatch table.
+   *
+   * Each entry holds, in registration order, the handlers matching a
+   * given (device, protocol, promiscuous) triple. Entries are filled on
+   * first use and the whole table is flushed whenever a handler is
+   * registered or unregistered.
+   */
+  typedef std::map<uint64_t, std::vector<ProtocolHandler> > ProtocolHandlerDispatch;
 
   uint32_t    m_id;         //!< Node id for this node
   uint32_t    m_sid;        //!< System id for this node
   std::vector<Ptr<NetDevice> > m_devices; //!< Devices associated to this node
   std::vector<Ptr<Application> > m_applications; //!< Applications associated to this node
   ProtocolHandlerList m_handlers; //!< Protocol handlers in the node
+  ProtocolHandlerDispatch m_dispatch; //!< Protocol handlers dispatch table
+  uint32_t m_dispatching; //!< Number of deliveries in progress
+  bool m_dispatchStale; //!< True if the dispatch table must be flushed
   DeviceAdditionListenerList m_deviceAdditionListeners; //!< Device addition listeners in the node
 };
 
@@ -0,0 +1,236 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/test.h"
+#include "ns3/simulator.h"
+#include "ns3/node.h"
+#include "ns3/packet.h"
+#include "ns3/mac48-address.h"
+#include "ns3/simple-net-device.h"
+
+using namespace ns3;
+
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * \brief Check that the packets received by a node are delivered to the right
+ * protocol handlers when the handlers are registered and unregistered
+ * after the dispatch table of the node has been filled, and that the
+ * promiscuous and non-promiscuous handlers are kept apart.
+ */
+class NodeProtocolHandlerTestCase : public TestCase
+{
+public:
+  NodeProtocolHandlerTestCase ();
+  virtual void DoRun (void);
+private:
+  /**
+   * Deliver a packet to the node through the given device
+   * \param device the device receiving the packet
+   * \param protocol the protocol number of the packet
+   * \param to the destination address of the packet
+   */
+  void Receive (Ptr<SimpleNetDevice> device, uint16_t protocol, Mac48Address to);
+  /**
+   * Handler registered for IPv4 on the first device
+   * \param device the device
+   * \param packet the packet
+   * \param protocol the protocol number
+   * \param from the source address
+   * \param to the destination address
+   * \param packetType the packet type
+   */
+  void Ipv4Handler (Ptr<NetDevice> device, Ptr<const Packet> packet, uint16_t protocol,
+                    const Address &from, const Address &to, NetDevice::PacketType packetType);
+  /**
+   * Handler registered for all the protocols on all the devices
+   * \param device the device
+   * \param packet the packet
+   * \param protocol the protocol number
+   * \param from the source address
+   * \param to the destination address
+   * \param packetType the packet type
+   */
+  void AnyHandler (Ptr<NetDevice> device, Ptr<const Packet> packet, uint16_t protocol,
+                   const Address &from, const Address &to, NetDevice::PacketType packetType);
+  /**
+   * Promiscuous handler registered for IPv4 on the second device
+   * \param device the device
+   * \param packet the packet
+   * \param protocol the protocol number
+   * \param from the source address
+   * \param to the destination address
+   * \param packetType the packet type
+   */
+  void PromiscHandler (Ptr<NetDevice> device, Ptr<const Packet> packet, uint16_t protocol,
+                       const Address &from, const Address &to, NetDevice::PacketType packetType);
+  /**
+   * Handler unregistering itself upon its first packet
+   * \param device the device
+   * \param packet the packet
+   * \param protocol the protocol number
+   * \param from the source address
+   * \param to the destination address
+   * \param packetType the packet type
+   */
+  void OnceHandler (Ptr<NetDevice> device, Ptr<const Packet> packet, uint16_t protocol,
+                    const Address &from, const Address &to, NetDevice::PacketType packetType);
+
+  Ptr<Node> m_node;                        //!< the node
+  uint32_t m_ipv4Count;                    //!< number of packets received by Ipv4Handler
+  uint32_t m_anyCount;                     //!< number of packets received by AnyHandler
+  uint32_t m_promiscCount;                 //!< number of packets received by PromiscHandler
+  uint32_t m_onceCount;                    //!< number of packets received by OnceHandler
+  NetDevice::PacketType m_promiscType;     //!< type of the last packet received by PromiscHandler
+};
+
+NodeProtocolHandlerTestCase::NodeProtocolHandlerTestCase ()
+  : TestCase ("Check the dispatch of received packets to the protocol handlers"),
+    m_ipv4Count (0),
+    m_anyCount (0),
+    m_promiscCount (0),
+    m_onceCount (0),
+    m_promiscType (NetDevice::PACKET_HOST)
+{
+}
+
+void
+NodeProtocolHandlerTestCase::Ipv4Handler (Ptr<NetDevice> device, Ptr<const Packet> packet, uint16_t protocol,
+                                          const Address &from, const Address &to, NetDevice::PacketType packetType)
+{
+  m_ipv4Count++;
+}
+
+void
+NodeProtocolHandlerTestCase::AnyHandler (Ptr<NetDevice> device, Ptr<const Packet> packet, uint16_t protocol,
+                                         const Address &from, const Address &to, NetDevice::PacketType packetType)
+{
+  m_anyCount++;
+}
+
+void
+NodeProtocolHandlerTestCase::PromiscHandler (Ptr<NetDevice> device, Ptr<const Packet> packet, uint16_t protocol,
+                                             const Address &from, const Address &to, NetDevice::PacketType packetType)
+{
+  m_promiscCount++;
+  m_promiscType = packetType;
+}
+
+void
+NodeProtocolHandlerTestCase::OnceHandler (Ptr<NetDevice> device, Ptr<const Packet> packet, uint16_t protocol,
+                                          const Address &from, const Address &to, NetDevice::PacketType packetType)
+{
+  m_onceCount++;
+  m_node->UnregisterProtocolHandler (MakeCallback (&NodeProtocolHandlerTestCase::OnceHandler, this));
+}
+
+void
+NodeProtocolHandlerTestCase::Receive (Ptr<SimpleNetDevice> device, uint16_t protocol, Mac48Address to)
+{
+  Simulator::ScheduleWithContext (m_node->GetId (), Seconds (0), &SimpleNetDevice::Receive, device,
+                                  Create<Packet> (100), protocol, to, Mac48Address ("00:00:00:00:00:ff"));
+  Simulator::Run ();
+}
+
+void
+NodeProtocolHandlerTestCase::DoRun (void)
+{
+  const uint16_t ipv4 = 0x0800;
+  const uint16_t ipv6 = 0x86dd;
+  Mac48Address otherHost ("00:00:00:00:00:fe");
+
+  m_node = CreateObject<Node> ();
+  Ptr<SimpleNetDevice> dev0 = CreateObject<SimpleNetDevice> ();
+  dev0->SetAddress (Mac48Address ("00:00:00:00:00:01"));
+  m_node->AddDevice (dev0);
+  Mac48Address addr0 = Mac48Address::ConvertFrom (dev0->GetAddress ());
+  Ptr<SimpleNetDevice> dev1 = CreateObject<SimpleNetDevice> ();
+  dev1->SetAddress (Mac48Address ("00:00:00:00:00:02"));
+  m_node->AddDevice (dev1);
+  Mac48Address addr1 = Mac48Address::ConvertFrom (dev1->GetAddress ());
+
+  // fill the dispatch table of the node
+  m_node->RegisterProtocolHandler (MakeCallback (&NodeProtocolHandlerTestCase::Ipv4Handler, this), ipv4, dev0);
+  Receive (dev0, ipv4, addr0);
+  Receive (dev1, ipv4, addr1);
+  Receive (dev0, ipv6, addr0);
+  NS_TEST_EXPECT_MSG_EQ (m_ipv4Count, 1, "The IPv4 handler should only get IPv4 packets from the first device");
+
+  // a handler registered once the table is filled gets the packets of the filled entries
+  m_node->RegisterProtocolHandler (MakeCallback (&NodeProtocolHandlerTestCase::AnyHandler, this), 0, 0);
+  Receive (dev0, ipv4, addr0);
+  Receive (dev1, ipv4, addr1);
+  Receive (dev0, ipv6, addr0);
+  NS_TEST_EXPECT_MSG_EQ (m_ipv4Count, 2, "The IPv4 handler should have got one more packet");
+  NS_TEST_EXPECT_MSG_EQ (m_anyCount, 3, "The handler registered later should get the packets of all the devices");
+
+  // promiscuous handlers get the packets to other hosts, non-promiscuous ones do not
+  m_node->RegisterProtocolHandler (MakeCallback (&NodeProtocolHandlerTestCase::PromiscHandler, this), ipv4, dev1, true);
+  Receive (dev1, ipv4, otherHost);
+  NS_TEST_EXPECT_MSG_EQ (m_anyCount, 3, "A non-promiscuous handler should not get packets to other hosts");
+  NS_TEST_EXPECT_MSG_EQ (m_promiscCount, 1, "The promiscuous handler should get packets to other hosts");
+  NS_TEST_EXPECT_MSG_EQ (m_promiscType, NetDevice::PACKET_OTHERHOST, "Wrong packet type");
+  Receive (dev1, ipv4, addr1);
+  NS_TEST_EXPECT_MSG_EQ (m_anyCount, 4, "The non-promiscuous handler should get the packet once");
+  NS_TEST_EXPECT_MSG_EQ (m_promiscCount, 2, "The promiscuous handler should get the packet once");
+  NS_TEST_EXPECT_MSG_EQ (m_promiscType, NetDevice::PACKET_HOST, "Wrong packet type");
+  Receive (dev0, ipv4, addr0);
+  NS_TEST_EXPECT_MSG_EQ (m_ipv4Count, 3, "The IPv4 handler should have got one more packet");
+  NS_TEST_EXPECT_MSG_EQ (m_anyCount, 5, "The non-promiscuous handler should have got one more packet");
+  NS_TEST_EXPECT_MSG_EQ (m_promiscCount, 2, "The promiscuous handler should not get packets from the first device");
+
+  // unregistered handlers no longer get the packets of the filled entries
+  m_node->UnregisterProtocolHandler (MakeCallback (&NodeProtocolHandlerTestCase::Ipv4Handler, this));
+  Receive (dev0, ipv4, addr0);
+  NS_TEST_EXPECT_MSG_EQ (m_ipv4Count, 3, "The unregistered IPv4 handler should not get packets");
+  NS_TEST_EXPECT_MSG_EQ (m_anyCount, 6, "The remaining handler should still get packets");
+  m_node->UnregisterProtocolHandler (MakeCallback (&NodeProtocolHandlerTestCase::AnyHandler, this));
+  Receive (dev1, ipv4, addr1);
+  NS_TEST_EXPECT_MSG_EQ (m_anyCount, 6, "The unregistered handler should not get packets");
+  NS_TEST_EXPECT_MSG_EQ (m_promiscCount, 3, "The promiscuous handler should still get packets");
+
+  // a handler unregistering itself during a delivery does not get the next packets
+  m_node->RegisterProtocolHandler (MakeCallback (&NodeProtocolHandlerTestCase::OnceHandler, this), ipv4, dev1, true);
+  Receive (dev1, ipv4, addr1);
+  Receive (dev1, ipv4, addr1);
+  NS_TEST_EXPECT_MSG_EQ (m_onceCount, 1, "The handler should have unregistered itself after its first packet");
+  NS_TEST_EXPECT_MSG_EQ (m_promiscCount, 5, "The other promiscuous handler should get all the packets");
+
+  m_node->Dispose ();
+  m_node = 0;
+  Simulator::Destroy ();
+}
+
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * \brief Node TestSuite
+ */
+class NodeTestSuite : public TestSuite
+{
+public:
+  NodeTestSuite ();
+};
+
+NodeTestSuite::NodeTestSuite ()
+  : TestSuite ("node", UNIT)
+{
+  AddTestCase (new NodeProtocolHandlerTestCase (), TestCase::QUICK);
+}
+
+static NodeTestSuite g_nodeTestSuite; //!< Static variable for test initialization
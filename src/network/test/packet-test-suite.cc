@@ -18,6 +18,7 @@
  * Author: Mathieu Lacage <mathieu.lacage@sophia.inria.fr>
  */
 #include "ns3/packet.h"
+#include "ns3/byte-tag-list.h"
 #include "ns3/packet-tag-list.h"
 #include "ns3/test.h"
 #include "ns3/unused.h"
@@ -1035,6 +1036,154 @@ PacketTagListTest::DoRun (void)
     
 }
 
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * Byte Tag list unit tests.
+ */
+class ByteTagListTest : public TestCase
+{
+public:
+  ByteTagListTest ();
+  virtual void DoRun (void);
+private:
+  /**
+   * Adds a tag to a list
+   * \param list The list
+   * \param tag The tag
+   * \param start The start offset of the tag
+   * \param end The end offset of the tag
+   */
+  void AddTag (ByteTagList &list, const ATestTagBase &tag, int32_t start, int32_t end);
+  /**
+   * Checks the list
+   * \param list The list
+   * \param file The file name
+   * \param line The line number
+   * \param n The number of variable arguments
+   * \param ... The variable arguments
+   */
+  void DoCheck (const ByteTagList &list, const char *file, int line, uint32_t n, ...);
+};
+
+ByteTagListTest::ByteTagListTest ()
+  : TestCase ("ByteTagList")
+{
+}
+
+void
+ByteTagListTest::AddTag (ByteTagList &list, const ATestTagBase &tag, int32_t start, int32_t end)
+{
+  TagBuffer buf = list.Add (tag.GetInstanceTypeId (), tag.GetSerializedSize (), start, end);
+  tag.Serialize (buf);
+}
+
+void
+ByteTagListTest::DoCheck (const ByteTagList &list, const char *file, int line, uint32_t n, ...)
+{
+  std::vector<struct Expected> expected;
+  va_list ap;
+  va_start (ap, n);
+  for (uint32_t k = 0; k < n; ++k)
+    {
+      uint32_t N = va_arg (ap, uint32_t);
+      uint32_t start = va_arg (ap, uint32_t);
+      uint32_t end = va_arg (ap, uint32_t);
+      expected.push_back (Expected (N, start, end));
+    }
+  va_end (ap);
+
+  ByteTagList::Iterator i = list.Begin (0, 1000);
+  uint32_t j = 0;
+  while (i.HasNext () && j < expected.size ())
+    {
+      ByteTagList::Iterator::Item item = i.Next ();
+      struct Expected e = expected[j];
+      std::ostringstream oss;
+      oss << "anon::ATestTag<" << e.n << ">";
+      NS_TEST_EXPECT_MSG_EQ_INTERNAL (item.tid.GetName (), oss.str (), "trivial", file, line);
+      NS_TEST_EXPECT_MSG_EQ_INTERNAL (item.start, static_cast<int32_t> (e.start), "trivial", file, line);
+      NS_TEST_EXPECT_MSG_EQ_INTERNAL (item.end, static_cast<int32_t> (e.end), "trivial", file, line);
+      ATestTagBase *tag = dynamic_cast<ATestTagBase *> (item.tid.GetConstructor () ());
+      NS_TEST_EXPECT_MSG_NE (tag, 0, "trivial");
+      tag->Deserialize (item.buf);
+      NS_TEST_EXPECT_MSG_EQ_INTERNAL (tag->m_error, false, "Tag data corrupted", file, line);
+      delete tag;
+      j++;
+    }
+  NS_TEST_EXPECT_MSG_EQ_INTERNAL (i.HasNext (), false, "Nothing left", file, line);
+  NS_TEST_EXPECT_MSG_EQ_INTERNAL (j, expected.size (), "Size match", file, line);
+}
+
+void
+ByteTagListTest::DoRun (void)
+{
+  {
+    // cut overlapping tags at the end of the buffer
+    ByteTagList list;
+    AddTag (list, ATestTag<1> (), 0, 10);
+    AddTag (list, ATestTag<5> (), 5, 15);
+    AddTag (list, ATestTag<10> (), 12, 20);
+    list.AddAtEnd (20);
+    CHECK (list, 3, E (1, 0, 10), E (5, 5, 15), E (10, 12, 20));
+    list.AddAtEnd (12);
+    CHECK (list, 2, E (1, 0, 10), E (5, 5, 12));
+  }
+
+  {
+    // cut overlapping tags at the start of the buffer and move the
+    // remaining tags over the removed one
+    ByteTagList list;
+    AddTag (list, ATestTag<10> (), 0, 5);
+    AddTag (list, ATestTag<1> (), 3, 10);
+    AddTag (list, ATestTag<5> (), 8, 20);
+    list.AddAtStart (0);
+    CHECK (list, 3, E (10, 0, 5), E (1, 3, 10), E (5, 8, 20));
+    list.AddAtStart (6);
+    CHECK (list, 2, E (1, 6, 10), E (5, 8, 20));
+
+    // cut adjusted tags
+    list.Adjust (10);
+    CHECK (list, 2, E (1, 16, 20), E (5, 18, 30));
+    list.AddAtEnd (25);
+    CHECK (list, 2, E (1, 16, 20), E (5, 18, 25));
+    list.Adjust (-10);
+    CHECK (list, 2, E (1, 6, 10), E (5, 8, 15));
+    list.AddAtStart (9);
+    CHECK (list, 2, E (1, 9, 10), E (5, 9, 15));
+    AddTag (list, ATestTag<10> (), 0, 9);
+    CHECK (list, 3, E (1, 9, 10), E (5, 9, 15), E (10, 0, 9));
+  }
+
+  {
+    // copy-on-write of lists sharing a buffer
+    ByteTagList a;
+    AddTag (a, ATestTag<1> (), 0, 10);
+    ByteTagList b = a;
+    AddTag (b, ATestTag<5> (), 0, 5);
+    AddTag (a, ATestTag<10> (), 5, 10);
+    CHECK (a, 2, E (1, 0, 10), E (10, 5, 10));
+    CHECK (b, 2, E (1, 0, 10), E (5, 0, 5));
+
+    ByteTagList c = b;
+    c.AddAtEnd (3);
+    CHECK (c, 2, E (1, 0, 3), E (5, 0, 3));
+    CHECK (b, 2, E (1, 0, 10), E (5, 0, 5));
+
+    ByteTagList d = a;
+    d.AddAtStart (6);
+    CHECK (d, 2, E (1, 6, 10), E (10, 6, 10));
+    CHECK (a, 2, E (1, 0, 10), E (10, 5, 10));
+
+    ByteTagList e = a;
+    e.Add (b);
+    CHECK (e, 4, E (1, 0, 10), E (10, 5, 10), E (1, 0, 10), E (5, 0, 5));
+    CHECK (a, 2, E (1, 0, 10), E (10, 5, 10));
+    CHECK (b, 2, E (1, 0, 10), E (5, 0, 5));
+  }
+}
+
 /**
  * \ingroup network-test
  * \ingroup tests
@@ -1052,6 +1201,7 @@ PacketTestSuite::PacketTestSuite ()
 {
   AddTestCase (new PacketTest, TestCase::QUICK);
   AddTestCase (new PacketTagListTest, TestCase::QUICK);
+  AddTestCase (new ByteTagListTest, TestCase::QUICK);
 }
 
 static PacketTestSuite g_packetTestSuite; //!< Static variable for test initialization
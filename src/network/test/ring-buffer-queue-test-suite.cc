@@ -0,0 +1,125 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/test.h"
+#include "ns3/ring-buffer-queue.h"
+#include "ns3/string.h"
+
+using namespace ns3;
+
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * RingBufferQueue unit tests.
+ */
+class RingBufferQueueTestCase : public TestCase
+{
+public:
+  RingBufferQueueTestCase ();
+  virtual void DoRun (void);
+private:
+  /**
+   * Count the dropped packets
+   * \param item the dropped packet
+   */
+  void Drop (Ptr<const Packet> item);
+  uint32_t m_drops; //!< number of dropped packets
+};
+
+RingBufferQueueTestCase::RingBufferQueueTestCase ()
+  : TestCase ("Sanity check on the ring buffer queue implementation"),
+    m_drops (0)
+{
+}
+
+void
+RingBufferQueueTestCase::Drop (Ptr<const Packet> item)
+{
+  m_drops++;
+}
+
+void
+RingBufferQueueTestCase::DoRun (void)
+{
+  Ptr<RingBufferQueue<Packet> > queue = CreateObject<RingBufferQueue<Packet> > ();
+  NS_TEST_EXPECT_MSG_EQ (queue->SetAttributeFailSafe ("MaxSize", StringValue ("40p")), true,
+                         "Verify that we can actually set the attribute");
+  queue->TraceConnectWithoutContext ("Drop", MakeCallback (&RingBufferQueueTestCase::Drop, this));
+
+  std::vector<Ptr<Packet> > packets;
+  for (uint32_t i = 0; i < 50; i++)
+    {
+      packets.push_back (Create<Packet> (i));
+    }
+
+  // interleave enqueue and dequeue so that the ring buffer wraps around
+  for (uint32_t i = 0; i < 10; i++)
+    {
+      queue->Enqueue (packets[i]);
+    }
+  for (uint32_t i = 0; i < 5; i++)
+    {
+      Ptr<Packet> packet = queue->Dequeue ();
+      NS_TEST_EXPECT_MSG_EQ (packet->GetUid (), packets[i]->GetUid (), "Packets dequeued out of order");
+    }
+  NS_TEST_EXPECT_MSG_EQ (queue->GetNPackets (), 5, "There should be five packets in there");
+  NS_TEST_EXPECT_MSG_EQ (queue->Peek ()->GetUid (), packets[5]->GetUid (), "Unexpected head of the queue");
+
+  // the ring buffer grows beyond its initial capacity and 5 packets are dropped
+  std::vector<Ptr<Packet> > batch (packets.begin () + 10, packets.end ());
+  NS_TEST_EXPECT_MSG_EQ (queue->EnqueueBatch (batch), 35, "Only 35 packets should fit in the queue");
+  NS_TEST_EXPECT_MSG_EQ (queue->GetNPackets (), 40, "The queue should be full");
+  NS_TEST_EXPECT_MSG_EQ (m_drops, 5, "Five packets should have been dropped");
+  NS_TEST_EXPECT_MSG_EQ (queue->GetCapacity (), 64, "The ring buffer should have doubled twice");
+
+  std::vector<Ptr<Packet> > dequeued;
+  NS_TEST_EXPECT_MSG_EQ (queue->DequeueBatch (dequeued, 30), 30, "30 packets should have been dequeued");
+  NS_TEST_EXPECT_MSG_EQ (queue->GetNPackets (), 10, "There should be ten packets in there");
+  for (uint32_t i = 0; i < 30; i++)
+    {
+      NS_TEST_EXPECT_MSG_EQ (dequeued[i]->GetUid (), packets[5 + i]->GetUid (), "Packets dequeued out of order");
+    }
+
+  NS_TEST_EXPECT_MSG_EQ (queue->DequeueBatch (dequeued, 30), 10, "Only ten packets should have been dequeued");
+  NS_TEST_EXPECT_MSG_EQ (dequeued.back ()->GetUid (), packets[44]->GetUid (), "Unexpected last packet");
+  NS_TEST_EXPECT_MSG_EQ (queue->GetNBytes (), 0, "The queue should be empty");
+  NS_TEST_EXPECT_MSG_EQ ((queue->Dequeue () == 0), true, "There are really no packets in there");
+
+  queue->Enqueue (packets[0]);
+  queue->Enqueue (packets[1]);
+  queue->Flush ();
+  NS_TEST_EXPECT_MSG_EQ (queue->IsEmpty (), true, "The queue should have been flushed");
+  NS_TEST_EXPECT_MSG_EQ (m_drops, 7, "Flushed packets should be traced as dropped");
+}
+
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * \brief RingBuffer Queue TestSuite
+ */
+class RingBufferQueueTestSuite : public TestSuite
+{
+public:
+  RingBufferQueueTestSuite ()
+    : TestSuite ("ring-buffer-queue", UNIT)
+  {
+    AddTestCase (new RingBufferQueueTestCase (), TestCase::QUICK);
+  }
+};
+
+static RingBufferQueueTestSuite g_ringBufferQueueTestSuite; //!< Static variable for test initialization
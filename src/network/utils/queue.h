@@ -357,6 +357,25 @@ protected:
    */
   Ptr<const Item> DoPeek (ConstIterator pos) const;
 
+  /**
+   * \brief Update the statistics and fire the traces for an enqueued item
+   * \param item the item that was enqueued
+   *
+   * This method is called by DoEnqueue and by the subclasses that store the
+   * items in their own container rather than in the list of the base class.
+   */
+  void NotifyEnqueue (Ptr<Item> item);
+
+  /**
+   * \brief Update the statistics and fire the traces for a dequeued item
+   * \param item the item that was dequeued
+   *
+   * This method is called by DoDequeue and DoRemove and by the subclasses
+   * that store the items in their own container rather than in the list of
+   * the base class.
+   */
+  void NotifyDequeue (Ptr<Item> item);
+
   /**
    * \brief Drop a packet before enqueue
    * \param item item that was dropped
@@ -450,16 +469,7 @@ Queue<Item>::DoEnqueue (ConstIterator pos, Ptr<Item> item)
     }
 
   m_packets.insert (pos, item);
-
-  uint32_t size = item->GetSize ();
-  m_nBytes += size;
-  m_nTotalReceivedBytes += size;
-
-  m_nPackets++;
-  m_nTotalReceivedPackets++;
-
-  NS_LOG_LOGIC ("m_traceEnqueue (p)");
-  m_traceEnqueue (item);
+  NotifyEnqueue (item);
 
   return true;
 }
@@ -481,14 +491,7 @@ Queue<Item>::DoDequeue (ConstIterator pos)
 
   if (item != 0)
     {
-      NS_ASSERT (m_nBytes.Get () >= item->GetSize ());
-      NS_ASSERT (m_nPackets.Get () > 0);
-
-      m_nBytes -= item->GetSize ();
-      m_nPackets--;
-
-      NS_LOG_LOGIC ("m_traceDequeue (p)");
-      m_traceDequeue (item);
+      NotifyDequeue (item);
     }
   return item;
 }
@@ -510,21 +513,46 @@ Queue<Item>::DoRemove (ConstIterator pos)
 
   if (item != 0)
     {
-      NS_ASSERT (m_nBytes.Get () >= item->GetSize ());
-      NS_ASSERT (m_nPackets.Get () > 0);
-
-      m_nBytes -= item->GetSize ();
-      m_nPackets--;
-
       // packets are first dequeued and then dropped
-      NS_LOG_LOGIC ("m_traceDequeue (p)");
-      m_traceDequeue (item);
-
+      NotifyDequeue (item);
       DropAfterDequeue (item);
     }
   return item;
 }
 
+template <typename Item>
+void
+Queue<Item>::NotifyEnqueue (Ptr<Item> item)
+{
+  NS_LOG_FUNCTION (this << item);
+
+  uint32_t size = item->GetSize ();
+  m_nBytes += size;
+  m_nTotalReceivedBytes += size;
+
+  m_nPackets++;
+  m_nTotalReceivedPackets++;
+
+  NS_LOG_LOGIC ("m_traceEnqueue (p)");
+  m_traceEnqueue (item);
+}
+
+template <typename Item>
+void
+Queue<Item>::NotifyDequeue (Ptr<Item> item)
+{
+  NS_LOG_FUNCTION (this << item);
+
+  NS_ASSERT (m_nBytes.Get () >= item->GetSize ());
+  NS_ASSERT (m_nPackets.Get () > 0);
+
+  m_nBytes -= item->GetSize ();
+  m_nPackets--;
+
+  NS_LOG_LOGIC ("m_traceDequeue (p)");
+  m_traceDequeue (item);
+}
+
 template <typename Item>
 void
 Queue<Item>::Flush (void)
@@ -0,0 +1,312 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef RING_BUFFER_QUEUE_H
+#define RING_BUFFER_QUEUE_H
+
+#include "ns3/queue.h"
+#include <vector>
+#include <algorithm>
+
+namespace ns3 {
+
+/**
+ * \ingroup queue
+ *
+ * \brief A FIFO packet queue that drops tail-end packets on overflow and
+ * stores its items in a contiguous ring buffer
+ *
+ * This queue behaves exactly like a DropTailQueue (including the Enqueue,
+ * Dequeue and Drop traces), but it does not allocate a list node for each
+ * enqueued item: the items are kept in a circular array whose capacity
+ * doubles whenever it is exhausted and is never shrunk. In addition, it
+ * provides EnqueueBatch and DequeueBatch methods for devices that transmit
+ * or receive bursts of packets.
+ */
+template <typename Item>
+class RingBufferQueue : public Queue<Item>
+{
+public:
+  /**
+   * \brief Get the type ID.
+   * \return the object TypeId
+   */
+  static TypeId GetTypeId (void);
+  /**
+   * \brief RingBufferQueue Constructor
+   *
+   * Creates a ring buffer queue with a maximum size of 100 packets by default
+   */
+  RingBufferQueue ();
+
+  virtual ~RingBufferQueue ();
+
+  virtual bool Enqueue (Ptr<Item> item);
+  virtual Ptr<Item> Dequeue (void);
+  virtual Ptr<Item> Remove (void);
+  virtual Ptr<const Item> Peek (void) const;
+
+  /**
+   * Enqueue a batch of items, in order. Items that do not fit in the queue
+   * are dropped (and traced) as if they were enqueued one by one.
+   *
+   * \param items the items to enqueue
+   * \return the number of items that were actually enqueued
+   */
+  uint32_t EnqueueBatch (const std::vector<Ptr<Item> > &items);
+
+  /**
+   * Dequeue up to the given number of items, in order, and append them to
+   * the given vector.
+   *
+   * \param items the vector the dequeued items are appended to
+   * \param maxItems the maximum number of items to dequeue
+   * \return the number of items that were actually dequeued
+   */
+  uint32_t DequeueBatch (std::vector<Ptr<Item> > &items, uint32_t maxItems);
+
+  /**
+   * \return the number of items the ring buffer can hold before growing
+   */
+  uint32_t GetCapacity (void) const;
+
+protected:
+  virtual void DoDispose (void);
+
+private:
+  using Queue<Item>::GetCurrentSize;
+  using Queue<Item>::GetMaxSize;
+  using Queue<Item>::NotifyEnqueue;
+  using Queue<Item>::NotifyDequeue;
+  using Queue<Item>::DropBeforeEnqueue;
+  using Queue<Item>::DropAfterDequeue;
+
+  /**
+   * Pop the item at the head of the ring buffer, without any accounting.
+   * \return the item at the head of the ring buffer
+   */
+  Ptr<Item> Pop (void);
+
+  /**
+   * Double the capacity of the ring buffer, preserving the order of the items.
+   */
+  void Grow (void);
+
+  std::vector<Ptr<Item> > m_items;  //!< the ring buffer (the size is a power of two)
+  uint32_t m_head;                  //!< index of the first item
+  uint32_t m_count;                 //!< number of items in the ring buffer
+
+  NS_LOG_TEMPLATE_DECLARE;     //!< redefinition of the log component
+};
+
+
+/**
+ * Implementation of the templates declared above.
+ */
+
+template <typename Item>
+TypeId
+RingBufferQueue<Item>::GetTypeId (void)
+{
+  static TypeId tid = TypeId (("ns3::RingBufferQueue<" + GetTypeParamName<RingBufferQueue<Item> > () + ">").c_str ())
+    .SetParent<Queue<Item> > ()
+    .SetGroupName ("Network")
+    .template AddConstructor<RingBufferQueue<Item> > ()
+  ;
+  return tid;
+}
+
+template <typename Item>
+RingBufferQueue<Item>::RingBufferQueue () :
+  Queue<Item> (),
+  m_items (16),
+  m_head (0),
+  m_count (0),
+  NS_LOG_TEMPLATE_DEFINE ("RingBufferQueue")
+{
+  NS_LOG_FUNCTION (this);
+}
+
+template <typename Item>
+RingBufferQueue<Item>::~RingBufferQueue ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+template <typename Item>
+void
+RingBufferQueue<Item>::DoDispose (void)
+{
+  NS_LOG_FUNCTION (this);
+  m_items.clear ();
+  m_head = 0;
+  m_count = 0;
+  Queue<Item>::DoDispose ();
+}
+
+template <typename Item>
+bool
+RingBufferQueue<Item>::Enqueue (Ptr<Item> item)
+{
+  NS_LOG_FUNCTION (this << item);
+
+  if (GetCurrentSize () + item > GetMaxSize ())
+    {
+      NS_LOG_LOGIC ("Queue full -- dropping pkt");
+      DropBeforeEnqueue (item);
+      return false;
+    }
+
+  if (m_count == m_items.size ())
+    {
+      Grow ();
+    }
+  m_items[(m_head + m_count) & (m_items.size () - 1)] = item;
+  m_count++;
+
+  NotifyEnqueue (item);
+  return true;
+}
+
+template <typename Item>
+Ptr<Item>
+RingBufferQueue<Item>::Dequeue (void)
+{
+  NS_LOG_FUNCTION (this);
+
+  if (m_count == 0)
+    {
+      NS_LOG_LOGIC ("Queue empty");
+      return 0;
+    }
+
+  Ptr<Item> item = Pop ();
+  NotifyDequeue (item);
+
+  NS_LOG_LOGIC ("Popped " << item);
+
+  return item;
+}
+
+template <typename Item>
+Ptr<Item>
+RingBufferQueue<Item>::Remove (void)
+{
+  NS_LOG_FUNCTION (this);
+
+  if (m_count == 0)
+    {
+      NS_LOG_LOGIC ("Queue empty");
+      return 0;
+    }
+
+  Ptr<Item> item = Pop ();
+  // packets are first dequeued and then dropped
+  NotifyDequeue (item);
+  DropAfterDequeue (item);
+
+  NS_LOG_LOGIC ("Removed " << item);
+
+  return item;
+}
+
+template <typename Item>
+Ptr<const Item>
+RingBufferQueue<Item>::Peek (void) const
+{
+  NS_LOG_FUNCTION (this);
+
+  if (m_count == 0)
+    {
+      NS_LOG_LOGIC ("Queue empty");
+      return 0;
+    }
+
+  return m_items[m_head];
+}
+
+template <typename Item>
+uint32_t
+RingBufferQueue<Item>::EnqueueBatch (const std::vector<Ptr<Item> > &items)
+{
+  NS_LOG_FUNCTION (this << items.size ());
+
+  uint32_t enqueued = 0;
+  for (typename std::vector<Ptr<Item> >::const_iterator i = items.begin (); i != items.end (); ++i)
+    {
+      if (Enqueue (*i))
+        {
+          enqueued++;
+        }
+    }
+  return enqueued;
+}
+
+template <typename Item>
+uint32_t
+RingBufferQueue<Item>::DequeueBatch (std::vector<Ptr<Item> > &items, uint32_t maxItems)
+{
+  NS_LOG_FUNCTION (this << maxItems);
+
+  uint32_t n = std::min (m_count, maxItems);
+  items.reserve (items.size () + n);
+  for (uint32_t i = 0; i < n; i++)
+    {
+      Ptr<Item> item = Pop ();
+      NotifyDequeue (item);
+      items.push_back (item);
+    }
+  return n;
+}
+
+template <typename Item>
+uint32_t
+RingBufferQueue<Item>::GetCapacity (void) const
+{
+  return m_items.size ();
+}
+
+template <typename Item>
+Ptr<Item>
+RingBufferQueue<Item>::Pop (void)
+{
+  NS_ASSERT (m_count > 0);
+  Ptr<Item> item = m_items[m_head];
+  m_items[m_head] = 0;
+  m_head = (m_head + 1) & (m_items.size () - 1);
+  m_count--;
+  return item;
+}
+
+template <typename Item>
+void
+RingBufferQueue<Item>::Grow (void)
+{
+  NS_LOG_FUNCTION (this);
+
+  uint32_t capacity = std::max<uint32_t> (m_items.size (), 1);
+  std::vector<Ptr<Item> > items (2 * capacity);
+  for (uint32_t i = 0; i < m_count; i++)
+    {
+      items[i] = m_items[(m_head + i) & (capacity - 1)];
+    }
+  m_items.swap (items);
+  m_head = 0;
+}
+
+} // namespace ns3
+
+#endif /* RING_BUFFER_QUEUE_H */
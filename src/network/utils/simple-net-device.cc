@@ -20,6 +20,7 @@
 #include "simple-net-device.h"
 #include "simple-channel.h"
 #include "ns3/node.h"
+#include "ns3/node-list.h"
 #include "ns3/packet.h"
 #include "ns3/log.h"
 #include "ns3/pointer.h"
@@ -358,6 +359,7 @@ SimpleNetDevice::SetAddress (Address address)
 {
   NS_LOG_FUNCTION (this << address);
   m_address = Mac48Address::ConvertFrom (address);
+  NodeList::NotifyAddressChange (this);
 }
 Address 
 SimpleNetDevice::GetAddress (void) const
@@ -347,19 +347,7 @@ Ipv4NixVectorRouting::GetNodeByIp (Ipv4Address dest)
 { 
   NS_LOG_FUNCTION_NOARGS ();
 
-  NodeContainer allNodes = NodeContainer::GetGlobal ();
-  Ptr<Node> destNode;
-
-  for (NodeContainer::Iterator i = allNodes.Begin (); i != allNodes.End (); ++i)
-    {
-      Ptr<Node> node = *i;
-      Ptr<Ipv4> ipv4 = node->GetObject<Ipv4> ();
-      if (ipv4->GetInterfaceForAddress (dest) != -1)
-        {
-          destNode = node;
-          break;
-        }
-    }
+  Ptr<Node> destNode = NodeList::GetNodeByAddress (dest);
 
   if (!destNode)
     {
@@ -20,6 +20,7 @@
 #include "openflow-switch-net-device.h"
 #include "ns3/udp-l4-protocol.h"
 #include "ns3/tcp-l4-protocol.h"
+#include "ns3/node-list.h"
 
 namespace ns3 {
 
@@ -221,6 +222,7 @@ OpenFlowSwitchNetDevice::SetAddress (Address address)
 {
   NS_LOG_FUNCTION_NOARGS ();
   m_address = Mac48Address::ConvertFrom (address);
+  NodeList::NotifyAddressChange (this);
 }
 
 Address
@@ -77,5 +77,11 @@ Kun2600MhzPropagationLossModel::DoAssignStreams (int64_t stream)
   return 0;
 }
 
+bool
+Kun2600MhzPropagationLossModel::DoIsDeterministic (void) const
+{
+  return true;
+}
+
 
 } // namespace ns3
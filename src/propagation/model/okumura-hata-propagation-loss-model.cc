@@ -158,5 +158,11 @@ OkumuraHataPropagationLossModel::DoAssignStreams (int64_t stream)
   return 0;
 }
 
+bool
+OkumuraHataPropagationLossModel::DoIsDeterministic (void) const
+{
+  return true;
+}
+
 
 } // namespace ns3
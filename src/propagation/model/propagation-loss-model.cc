@@ -44,12 +44,21 @@ PropagationLossModel::GetTypeId (void)
   static TypeId tid = TypeId ("ns3::PropagationLossModel")
     .SetParent<Object> ()
     .SetGroupName ("Propagation")
+    .AddAttribute ("CacheRxPower",
+                   "If true, cache the reception power computed by the chain of loss models "
+                   "for each pair of stationary mobility models, until one of them notifies "
+                   "a course change. Only effective if all the models of the chain are "
+                   "deterministic.",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&PropagationLossModel::m_cacheRxPower),
+                   MakeBooleanChecker ())
   ;
   return tid;
 }
 
 PropagationLossModel::PropagationLossModel ()
-  : m_next (0)
+  : m_next (0),
+    m_cacheRxPower (false)
 {
 }
 
@@ -57,9 +66,35 @@ PropagationLossModel::~PropagationLossModel ()
 {
 }
 
+void
+PropagationLossModel::DoDispose (void)
+{
+  NS_LOG_FUNCTION (this);
+  ClearCache ();
+  Object::DoDispose ();
+}
+
+void
+PropagationLossModel::ClearCache (void)
+{
+  NS_LOG_FUNCTION (this);
+  // the callbacks were connected from a const method
+  const PropagationLossModel *self = this;
+  for (std::unordered_map<const MobilityModel *, WatchedModel>::iterator it = m_watched.begin ();
+       it != m_watched.end (); it++)
+    {
+      it->second.model->TraceDisconnectWithoutContext ("CourseChange",
+                                                       MakeCallback (&PropagationLossModel::CourseChanged, self));
+    }
+  m_watched.clear ();
+  m_cache.clear ();
+}
+
 void
 PropagationLossModel::SetNext (Ptr<PropagationLossModel> next)
 {
+  // the cached values were computed with the previous chain
+  ClearCache ();
   m_next = next;
 }
 
@@ -73,6 +108,110 @@ double
 PropagationLossModel::CalcRxPower (double txPowerDbm,
                                    Ptr<MobilityModel> a,
                                    Ptr<MobilityModel> b) const
+{
+  if (!m_cacheRxPower || !IsDeterministic ())
+    {
+      return DoCalcRxPowerChain (txPowerDbm, a, b);
+    }
+  Vector va = a->GetVelocity ();
+  Vector vb = b->GetVelocity ();
+  if (va.x != 0 || va.y != 0 || va.z != 0 || vb.x != 0 || vb.y != 0 || vb.z != 0)
+    {
+      // the position of a moving model changes without course change
+      // notifications, hence the value could not be invalidated
+      return DoCalcRxPowerChain (txPowerDbm, a, b);
+    }
+  Path path (PeekPointer (a), PeekPointer (b));
+  std::unordered_map<Path, CachedRxPower, PathHash>::iterator it = m_cache.find (path);
+  if (it != m_cache.end () && it->second.txPowerDbm == txPowerDbm)
+    {
+      return it->second.rxPowerDbm;
+    }
+  double rxPowerDbm = DoCalcRxPowerChain (txPowerDbm, a, b);
+  if (it != m_cache.end ())
+    {
+      it->second.txPowerDbm = txPowerDbm;
+      it->second.rxPowerDbm = rxPowerDbm;
+    }
+  else
+    {
+      CachedRxPower cached;
+      cached.txPowerDbm = txPowerDbm;
+      cached.rxPowerDbm = rxPowerDbm;
+      m_cache.insert (std::make_pair (path, cached));
+      Watch (a, PeekPointer (b));
+      Watch (b, PeekPointer (a));
+    }
+  return rxPowerDbm;
+}
+
+void
+PropagationLossModel::CalcRxPower (double txPowerDbm,
+                                   Ptr<MobilityModel> a,
+                                   const std::vector<Ptr<MobilityModel> > &b,
+                                   std::vector<double> &rxPowerDbm) const
+{
+  NS_LOG_FUNCTION (this << txPowerDbm << a << b.size ());
+  rxPowerDbm.assign (b.size (), txPowerDbm);
+  CalcRxPowerBatch (a, b, rxPowerDbm);
+}
+
+void
+PropagationLossModel::CalcRxPowerBatch (Ptr<MobilityModel> a,
+                                        const std::vector<Ptr<MobilityModel> > &b,
+                                        std::vector<double> &powerDbm) const
+{
+  if (m_cacheRxPower)
+    {
+      // the cache is looked up for each destination
+      for (std::size_t i = 0; i < b.size (); i++)
+        {
+          powerDbm[i] = CalcRxPower (powerDbm[i], a, b[i]);
+        }
+      return;
+    }
+  DoCalcRxPowerBatch (a, b, powerDbm);
+  if (m_next != 0)
+    {
+      m_next->CalcRxPowerBatch (a, b, powerDbm);
+    }
+}
+
+void
+PropagationLossModel::DoCalcRxPowerBatch (Ptr<MobilityModel> a,
+                                          const std::vector<Ptr<MobilityModel> > &b,
+                                          std::vector<double> &powerDbm) const
+{
+  for (std::size_t i = 0; i < b.size (); i++)
+    {
+      powerDbm[i] = DoCalcRxPower (powerDbm[i], a, b[i]);
+    }
+}
+
+void
+PropagationLossModel::GetDistances (Ptr<MobilityModel> a,
+                                    const std::vector<Ptr<MobilityModel> > &b,
+                                    std::vector<double> &distances)
+{
+  // same computation as MobilityModel::GetDistanceFrom, with the square
+  // roots taken in a separate loop free of virtual calls
+  Vector position = a->GetPosition ();
+  distances.resize (b.size ());
+  for (std::size_t i = 0; i < b.size (); i++)
+    {
+      Vector diff = b[i]->GetPosition () - position;
+      distances[i] = diff.x * diff.x + diff.y * diff.y + diff.z * diff.z;
+    }
+  for (std::size_t i = 0; i < distances.size (); i++)
+    {
+      distances[i] = std::sqrt (distances[i]);
+    }
+}
+
+double
+PropagationLossModel::DoCalcRxPowerChain (double txPowerDbm,
+                                          Ptr<MobilityModel> a,
+                                          Ptr<MobilityModel> b) const
 {
   double self = DoCalcRxPower (txPowerDbm, a, b);
   if (m_next != 0)
@@ -82,6 +221,65 @@ PropagationLossModel::CalcRxPower (double txPowerDbm,
   return self;
 }
 
+bool
+PropagationLossModel::IsDeterministic (void) const
+{
+  return DoIsDeterministic () && (m_next == 0 || m_next->IsDeterministic ());
+}
+
+bool
+PropagationLossModel::DoIsDeterministic (void) const
+{
+  return false;
+}
+
+void
+PropagationLossModel::Watch (Ptr<MobilityModel> model, const MobilityModel *peer) const
+{
+  std::unordered_map<const MobilityModel *, WatchedModel>::iterator it = m_watched.find (PeekPointer (model));
+  if (it == m_watched.end ())
+    {
+      NS_LOG_DEBUG ("watching the course changes of " << model);
+      // holding a reference to the model prevents its address from being
+      // reused by another model while cached values refer to it
+      WatchedModel watched;
+      watched.model = model;
+      it = m_watched.insert (std::make_pair (PeekPointer (model), watched)).first;
+      model->TraceConnectWithoutContext ("CourseChange",
+                                         MakeCallback (&PropagationLossModel::CourseChanged, this));
+    }
+  it->second.peers.insert (peer);
+}
+
+void
+PropagationLossModel::CourseChanged (Ptr<const MobilityModel> model) const
+{
+  NS_LOG_FUNCTION (this << model);
+  std::unordered_map<const MobilityModel *, WatchedModel>::iterator it = m_watched.find (PeekPointer (model));
+  if (it == m_watched.end ())
+    {
+      return;
+    }
+  for (std::unordered_set<const MobilityModel *>::const_iterator peer = it->second.peers.begin ();
+       peer != it->second.peers.end (); peer++)
+    {
+      m_cache.erase (Path (PeekPointer (model), *peer));
+      m_cache.erase (Path (*peer, PeekPointer (model)));
+      if (*peer != PeekPointer (model))
+        {
+          m_watched.find (*peer)->second.peers.erase (PeekPointer (model));
+        }
+    }
+  it->second.peers.clear ();
+}
+
+std::size_t
+PropagationLossModel::PathHash::operator() (const Path &path) const
+{
+  std::size_t h = std::hash<const MobilityModel *> () (path.first);
+  return h ^ (std::hash<const MobilityModel *> () (path.second) + 0x9e3779b9 + (h << 6) + (h >> 2));
+}
+
 int64_t
 PropagationLossModel::AssignStreams (int64_t stream)
 {
@@ -271,12 +469,35 @@ FriisPropagationLossModel::DoCalcRxPower (double txPowerDbm,
   return txPowerDbm - std::max (lossDb, m_minLoss);
 }
 
+void
+FriisPropagationLossModel::DoCalcRxPowerBatch (Ptr<MobilityModel> a,
+                                               const std::vector<Ptr<MobilityModel> > &b,
+                                               std::vector<double> &powerDbm) const
+{
+  std::vector<double> distances;
+  GetDistances (a, b, distances);
+  double numerator = m_lambda * m_lambda;
+  for (std::size_t i = 0; i < distances.size (); i++)
+    {
+      double distance = distances[i];
+      double denominator = 16 * M_PI * M_PI * distance * distance * m_systemLoss;
+      double lossDb = distance <= 0 ? m_minLoss : std::max (-10 * log10 (numerator / denominator), m_minLoss);
+      powerDbm[i] -= lossDb;
+    }
+}
+
 int64_t
 FriisPropagationLossModel::DoAssignStreams (int64_t stream)
 {
   return 0;
 }
 
+bool
+FriisPropagationLossModel::DoIsDeterministic (void) const
+{
+  return true;
+}
+
 // ------------------------------------------------------------------------- //
 // -- Two-Ray Ground Model ported from NS-2 -- tomhewer@mac.com -- Nov09 //
 
@@ -445,12 +666,62 @@ TwoRayGroundPropagationLossModel::DoCalcRxPower (double txPowerDbm,
     }
 }
 
+void
+TwoRayGroundPropagationLossModel::DoCalcRxPowerBatch (Ptr<MobilityModel> a,
+                                                      const std::vector<Ptr<MobilityModel> > &b,
+                                                      std::vector<double> &powerDbm) const
+{
+  // gather the distances and the antenna heights once
+  Vector position = a->GetPosition ();
+  double txAntHeight = position.z + m_heightAboveZ;
+  std::vector<double> distances (b.size ());
+  std::vector<double> rxAntHeights (b.size ());
+  for (std::size_t i = 0; i < b.size (); i++)
+    {
+      Vector rxPosition = b[i]->GetPosition ();
+      Vector diff = rxPosition - position;
+      distances[i] = std::sqrt (diff.x * diff.x + diff.y * diff.y + diff.z * diff.z);
+      rxAntHeights[i] = rxPosition.z + m_heightAboveZ;
+    }
+  double numerator = m_lambda * m_lambda;
+  for (std::size_t i = 0; i < distances.size (); i++)
+    {
+      double distance = distances[i];
+      if (distance <= m_minDistance)
+        {
+          continue;
+        }
+      double dCross = (4 * M_PI * txAntHeight * rxAntHeights[i]) / m_lambda;
+      double tmp;
+      if (distance <= dCross)
+        {
+          tmp = M_PI * distance;
+          double denominator = 16 * tmp * tmp * m_systemLoss;
+          powerDbm[i] += 10 * std::log10 (numerator / denominator);
+        }
+      else
+        {
+          tmp = txAntHeight * rxAntHeights[i];
+          double rayNumerator = tmp * tmp;
+          tmp = distance * distance;
+          double rayDenominator = tmp * tmp * m_systemLoss;
+          powerDbm[i] += 10 * std::log10 (rayNumerator / rayDenominator);
+        }
+    }
+}
+
 int64_t
 TwoRayGroundPropagationLossModel::DoAssignStreams (int64_t stream)
 {
   return 0;
 }
 
+bool
+TwoRayGroundPropagationLossModel::DoIsDeterministic (void) const
+{
+  return true;
+}
+
 // ------------------------------------------------------------------------- //
 
 NS_OBJECT_ENSURE_REGISTERED (LogDistancePropagationLossModel);
@@ -534,12 +805,34 @@ LogDistancePropagationLossModel::DoCalcRxPower (double txPowerDbm,
   return txPowerDbm + rxc;
 }
 
+void
+LogDistancePropagationLossModel::DoCalcRxPowerBatch (Ptr<MobilityModel> a,
+                                                     const std::vector<Ptr<MobilityModel> > &b,
+                                                     std::vector<double> &powerDbm) const
+{
+  std::vector<double> distances;
+  GetDistances (a, b, distances);
+  for (std::size_t i = 0; i < distances.size (); i++)
+    {
+      double distance = distances[i];
+      double rxc = distance <= m_referenceDistance ? -m_referenceLoss
+        : -m_referenceLoss - 10 * m_exponent * std::log10 (distance / m_referenceDistance);
+      powerDbm[i] += rxc;
+    }
+}
+
 int64_t
 LogDistancePropagationLossModel::DoAssignStreams (int64_t stream)
 {
   return 0;
 }
 
+bool
+LogDistancePropagationLossModel::DoIsDeterministic (void) const
+{
+  return true;
+}
+
 // ------------------------------------------------------------------------- //
 
 NS_OBJECT_ENSURE_REGISTERED (ThreeLogDistancePropagationLossModel);
@@ -636,12 +929,53 @@ ThreeLogDistancePropagationLossModel::DoCalcRxPower (double txPowerDbm,
   return txPowerDbm - pathLossDb;
 }
 
+void
+ThreeLogDistancePropagationLossModel::DoCalcRxPowerBatch (Ptr<MobilityModel> a,
+                                                          const std::vector<Ptr<MobilityModel> > &b,
+                                                          std::vector<double> &powerDbm) const
+{
+  std::vector<double> distances;
+  GetDistances (a, b, distances);
+  // the loss at the start of the second and third fields, summed in the
+  // same order as DoCalcRxPower
+  double lossDb1 = m_referenceLoss + 10 * m_exponent0 * std::log10 (m_distance1 / m_distance0);
+  double lossDb2 = lossDb1 + 10 * m_exponent1 * std::log10 (m_distance2 / m_distance1);
+  for (std::size_t i = 0; i < distances.size (); i++)
+    {
+      double distance = distances[i];
+      double pathLossDb;
+      if (distance < m_distance0)
+        {
+          pathLossDb = 0;
+        }
+      else if (distance < m_distance1)
+        {
+          pathLossDb = m_referenceLoss + 10 * m_exponent0 * std::log10 (distance / m_distance0);
+        }
+      else if (distance < m_distance2)
+        {
+          pathLossDb = lossDb1 + 10 * m_exponent1 * std::log10 (distance / m_distance1);
+        }
+      else
+        {
+          pathLossDb = lossDb2 + 10 * m_exponent2 * std::log10 (distance / m_distance2);
+        }
+      powerDbm[i] -= pathLossDb;
+    }
+}
+
 int64_t
 ThreeLogDistancePropagationLossModel::DoAssignStreams (int64_t stream)
 {
   return 0;
 }
 
+bool
+ThreeLogDistancePropagationLossModel::DoIsDeterministic (void) const
+{
+  return true;
+}
+
 // ------------------------------------------------------------------------- //
 
 NS_OBJECT_ENSURE_REGISTERED (NakagamiPropagationLossModel);
@@ -804,6 +1138,12 @@ FixedRssLossModel::DoAssignStreams (int64_t stream)
   return 0;
 }
 
+bool
+FixedRssLossModel::DoIsDeterministic (void) const
+{
+  return true;
+}
+
 // ------------------------------------------------------------------------- //
 
 NS_OBJECT_ENSURE_REGISTERED (MatrixPropagationLossModel);
@@ -924,12 +1264,31 @@ RangePropagationLossModel::DoCalcRxPower (double txPowerDbm,
     }
 }
 
+void
+RangePropagationLossModel::DoCalcRxPowerBatch (Ptr<MobilityModel> a,
+                                               const std::vector<Ptr<MobilityModel> > &b,
+                                               std::vector<double> &powerDbm) const
+{
+  std::vector<double> distances;
+  GetDistances (a, b, distances);
+  for (std::size_t i = 0; i < distances.size (); i++)
+    {
+      powerDbm[i] = distances[i] <= m_range ? powerDbm[i] : -1000;
+    }
+}
+
 int64_t
 RangePropagationLossModel::DoAssignStreams (int64_t stream)
 {
   return 0;
 }
 
+bool
+RangePropagationLossModel::DoIsDeterministic (void) const
+{
+  return true;
+}
+
 // ------------------------------------------------------------------------- //
 
 } // namespace ns3
@@ -28,6 +28,9 @@
 #include "ns3/object.h"
 #include "ns3/random-variable-stream.h"
 #include <map>
+#include <vector>
+#include <unordered_map>
+#include <unordered_set>
 
 namespace ns3 {
 
@@ -45,6 +48,15 @@ class MobilityModel;
  *
  * Calculate the receive power (dbm) from a transmit power (dbm)
  * and a mobility model for the source and destination positions.
+ *
+ * If the CacheRxPower attribute is set, the receive power computed by the
+ * whole chain of loss models is cached for each (source, destination) pair
+ * of mobility models, as long as all the models of the chain are
+ * deterministic (see IsDeterministic) and neither the source nor the
+ * destination moves. A cached value is discarded whenever the source or
+ * the destination notifies a course change, or when the transmit power
+ * differs from the one it was computed for. Changing the attributes of the
+ * loss models during the simulation is not reflected by the cached values.
  */
 class PropagationLossModel : public Object
 {
@@ -65,7 +77,8 @@ public:
    *
    * This method of chaining propagation loss models only works commutatively
    * if the propagation loss of all models in the chain are independent
-   * of transmit power.
+   * of transmit power. The reception powers cached by this model, if
+   * any, are discarded.
    */
   void SetNext (Ptr<PropagationLossModel> next);
 
@@ -93,6 +106,30 @@ public:
                       Ptr<MobilityModel> a,
                       Ptr<MobilityModel> b) const;
 
+  /**
+   * Returns the Rx Power at many destinations taking into account all the
+   * PropagationLossModel(s) chained to the current one. This is equivalent
+   * to calling CalcRxPower for each destination in turn, but the models
+   * which implement DoCalcRxPowerBatch compute the loss to all the
+   * destinations at once.
+   *
+   * \param txPowerDbm current transmission power (in dBm)
+   * \param a the mobility model of the source
+   * \param b the mobility models of the destinations
+   * \param rxPowerDbm the reception power at each destination (in dBm)
+   */
+  void CalcRxPower (double txPowerDbm,
+                    Ptr<MobilityModel> a,
+                    const std::vector<Ptr<MobilityModel> > &b,
+                    std::vector<double> &rxPowerDbm) const;
+
+  /**
+   * \return true if the reception power computed by this model and by all
+   *         the models chained to it only depends on the transmission power
+   *         and on the positions of the source and of the destination
+   */
+  bool IsDeterministic (void) const;
+
   /**
    * If this loss model uses objects of type RandomVariableStream,
    * set the stream numbers to the integers starting with the offset
@@ -106,6 +143,20 @@ public:
    */
   int64_t AssignStreams (int64_t stream);
 
+protected:
+  virtual void DoDispose (void);
+
+  /**
+   * Compute the distance from a source to many destinations.
+   *
+   * \param a the mobility model of the source
+   * \param b the mobility models of the destinations
+   * \param distances the distance to each destination (m)
+   */
+  static void GetDistances (Ptr<MobilityModel> a,
+                            const std::vector<Ptr<MobilityModel> > &b,
+                            std::vector<double> &distances);
+
 private:
   /**
    * \brief Copy constructor
@@ -140,7 +191,110 @@ private:
    */
   virtual int64_t DoAssignStreams (int64_t stream) = 0;
 
+  /**
+   * Computes the Rx Power at many destinations taking into account only the
+   * particular PropagationLossModel. The default implementation calls
+   * DoCalcRxPower for each destination in turn; subclasses can override it
+   * to process all the destinations in tight loops.
+   *
+   * \param a the mobility model of the source
+   * \param b the mobility models of the destinations
+   * \param powerDbm the transmission power for each destination on input,
+   *        and the reception power at each destination on output (in dBm)
+   */
+  virtual void DoCalcRxPowerBatch (Ptr<MobilityModel> a,
+                                   const std::vector<Ptr<MobilityModel> > &b,
+                                   std::vector<double> &powerDbm) const;
+
+  /**
+   * Computes the Rx Power at many destinations taking into account all the
+   * PropagationLossModel(s) chained to the current one.
+   *
+   * \param a the mobility model of the source
+   * \param b the mobility models of the destinations
+   * \param powerDbm the transmission power for each destination on input,
+   *        and the reception power at each destination on output (in dBm)
+   */
+  void CalcRxPowerBatch (Ptr<MobilityModel> a,
+                         const std::vector<Ptr<MobilityModel> > &b,
+                         std::vector<double> &powerDbm) const;
+
+  /**
+   * Subclasses whose reception power only depends on the transmission power
+   * and on the positions of the source and of the destination (i.e., which
+   * neither draw random variables nor keep a state that changes over time)
+   * can return true, so that their results can be cached. The default
+   * implementation returns false.
+   *
+   * \return true if this particular model is deterministic
+   */
+  virtual bool DoIsDeterministic (void) const;
+
+  /**
+   * Returns the Rx Power taking into account all the PropagationLossModel(s)
+   * chained to the current one, without looking up the cache.
+   *
+   * \param txPowerDbm current transmission power (in dBm)
+   * \param a the mobility model of the source
+   * \param b the mobility model of the destination
+   * \returns the reception power after adding/multiplying propagation loss (in dBm)
+   */
+  double DoCalcRxPowerChain (double txPowerDbm,
+                             Ptr<MobilityModel> a,
+                             Ptr<MobilityModel> b) const;
+
+  /**
+   * Discard the cached values and stop watching the mobility models.
+   */
+  void ClearCache (void);
+
+  /**
+   * Start watching the course changes of a mobility model, if not done yet.
+   *
+   * \param model the mobility model
+   * \param peer the mobility model it has a cached value with
+   */
+  void Watch (Ptr<MobilityModel> model, const MobilityModel *peer) const;
+
+  /**
+   * Discard the cached values involving a mobility model which notified a
+   * course change.
+   *
+   * \param model the mobility model
+   */
+  void CourseChanged (Ptr<const MobilityModel> model) const;
+
+  /// (source, destination) pair of mobility models
+  typedef std::pair<const MobilityModel *, const MobilityModel *> Path;
+
+  /// Hash function for a (source, destination) pair of mobility models
+  struct PathHash
+  {
+    /**
+     * \param path the (source, destination) pair
+     * \return the hash of the pair
+     */
+    std::size_t operator() (const Path &path) const;
+  };
+
+  /// A cached reception power
+  struct CachedRxPower
+  {
+    double txPowerDbm; //!< the transmission power the value was computed for (dBm)
+    double rxPowerDbm; //!< the reception power (dBm)
+  };
+
+  /// A mobility model whose course changes are watched
+  struct WatchedModel
+  {
+    Ptr<MobilityModel> model;                        //!< the mobility model
+    std::unordered_set<const MobilityModel *> peers; //!< the models it has cached values with
+  };
+
   Ptr<PropagationLossModel> m_next; //!< Next propagation loss model in the list
+  bool m_cacheRxPower;              //!< whether to cache the reception power
+  mutable std::unordered_map<Path, CachedRxPower, PathHash> m_cache;         //!< cached reception powers
+  mutable std::unordered_map<const MobilityModel *, WatchedModel> m_watched; //!< watched mobility models
 };
 
 /**
@@ -321,7 +475,11 @@ private:
   virtual double DoCalcRxPower (double txPowerDbm,
                                 Ptr<MobilityModel> a,
                                 Ptr<MobilityModel> b) const;
+  virtual void DoCalcRxPowerBatch (Ptr<MobilityModel> a,
+                                   const std::vector<Ptr<MobilityModel> > &b,
+                                   std::vector<double> &powerDbm) const;
   virtual int64_t DoAssignStreams (int64_t stream);
+  virtual bool DoIsDeterministic (void) const;
 
   /**
    * Transforms a Dbm value to Watt
@@ -441,7 +599,11 @@ private:
   virtual double DoCalcRxPower (double txPowerDbm,
                                 Ptr<MobilityModel> a,
                                 Ptr<MobilityModel> b) const;
+  virtual void DoCalcRxPowerBatch (Ptr<MobilityModel> a,
+                                   const std::vector<Ptr<MobilityModel> > &b,
+                                   std::vector<double> &powerDbm) const;
   virtual int64_t DoAssignStreams (int64_t stream);
+  virtual bool DoIsDeterministic (void) const;
 
   /**
    * Transforms a Dbm value to Watt
@@ -529,7 +691,11 @@ private:
   virtual double DoCalcRxPower (double txPowerDbm,
                                 Ptr<MobilityModel> a,
                                 Ptr<MobilityModel> b) const;
+  virtual void DoCalcRxPowerBatch (Ptr<MobilityModel> a,
+                                   const std::vector<Ptr<MobilityModel> > &b,
+                                   std::vector<double> &powerDbm) const;
   virtual int64_t DoAssignStreams (int64_t stream);
+  virtual bool DoIsDeterministic (void) const;
 
   /**
    *  Creates a default reference loss model
@@ -612,7 +778,11 @@ private:
   virtual double DoCalcRxPower (double txPowerDbm,
                                 Ptr<MobilityModel> a,
                                 Ptr<MobilityModel> b) const;
+  virtual void DoCalcRxPowerBatch (Ptr<MobilityModel> a,
+                                   const std::vector<Ptr<MobilityModel> > &b,
+                                   std::vector<double> &powerDbm) const;
   virtual int64_t DoAssignStreams (int64_t stream);
+  virtual bool DoIsDeterministic (void) const;
 
   double m_distance0; //!< Beginning of the first (near) distance field
   double m_distance1; //!< Beginning of the second (middle) distance field.
@@ -747,6 +917,7 @@ private:
                                 Ptr<MobilityModel> b) const;
 
   virtual int64_t DoAssignStreams (int64_t stream);
+  virtual bool DoIsDeterministic (void) const;
   double m_rss; //!< the received signal strength
 };
 
@@ -851,7 +1022,11 @@ private:
   virtual double DoCalcRxPower (double txPowerDbm,
                                 Ptr<MobilityModel> a,
                                 Ptr<MobilityModel> b) const;
+  virtual void DoCalcRxPowerBatch (Ptr<MobilityModel> a,
+                                   const std::vector<Ptr<MobilityModel> > &b,
+                                   std::vector<double> &powerDbm) const;
   virtual int64_t DoAssignStreams (int64_t stream);
+  virtual bool DoIsDeterministic (void) const;
 private:
   double m_range; //!< Maximum Transmission Range (meters)
 };
@@ -21,8 +21,13 @@
 #include "ns3/test.h"
 #include "ns3/config.h"
 #include "ns3/double.h"
+#include "ns3/boolean.h"
 #include "ns3/propagation-loss-model.h"
 #include "ns3/constant-position-mobility-model.h"
+#include "ns3/constant-velocity-mobility-model.h"
+#include "ns3/random-waypoint-mobility-model.h"
+#include "ns3/position-allocator.h"
+#include "ns3/pointer.h"
 #include "ns3/simulator.h"
 
 using namespace ns3;
@@ -436,6 +441,195 @@ RangePropagationLossModelTestCase::DoRun (void)
   Simulator::Destroy ();
 }
 
+class CachedPropagationLossModelTestCase : public TestCase
+{
+public:
+  CachedPropagationLossModelTestCase ();
+  virtual ~CachedPropagationLossModelTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+CachedPropagationLossModelTestCase::CachedPropagationLossModelTestCase ()
+  : TestCase ("Test the caching of the reception power by a chain of PropagationLossModels")
+{
+}
+
+CachedPropagationLossModelTestCase::~CachedPropagationLossModelTestCase ()
+{
+}
+
+void
+CachedPropagationLossModelTestCase::DoRun (void)
+{
+  Ptr<MobilityModel> a = CreateObject<ConstantPositionMobilityModel> ();
+  a->SetPosition (Vector (0,0,0));
+  Ptr<MobilityModel> b = CreateObject<ConstantPositionMobilityModel> ();
+  b->SetPosition (Vector (50,0,0));
+
+  // a cached chain and an identical uncached chain
+  Ptr<FriisPropagationLossModel> cached = CreateObject<FriisPropagationLossModel> ();
+  cached->SetAttribute ("CacheRxPower", BooleanValue (true));
+  Ptr<LogDistancePropagationLossModel> cachedNext = CreateObject<LogDistancePropagationLossModel> ();
+  cached->SetNext (cachedNext);
+  Ptr<FriisPropagationLossModel> reference = CreateObject<FriisPropagationLossModel> ();
+  Ptr<LogDistancePropagationLossModel> referenceNext = CreateObject<LogDistancePropagationLossModel> ();
+  reference->SetNext (referenceNext);
+  NS_TEST_ASSERT_MSG_EQ (cached->IsDeterministic (), true, "Friis and log distance models are deterministic");
+
+  double txPowerDbm = 16.0206;
+  double rxPowerDbm = reference->CalcRxPower (txPowerDbm, a, b);
+  NS_TEST_EXPECT_MSG_EQ (cached->CalcRxPower (txPowerDbm, a, b), rxPowerDbm, "Got unexpected rcv power");
+  NS_TEST_EXPECT_MSG_EQ (cached->CalcRxPower (txPowerDbm, b, a), reference->CalcRxPower (txPowerDbm, b, a),
+                         "Got unexpected rcv power in the reverse direction");
+
+  // the attributes of the models are not watched, hence the cached value is still used
+  cachedNext->SetAttribute ("Exponent", DoubleValue (3.5));
+  referenceNext->SetAttribute ("Exponent", DoubleValue (3.5));
+  NS_TEST_EXPECT_MSG_EQ (cached->CalcRxPower (txPowerDbm, a, b), rxPowerDbm, "The cached value should have been used");
+
+  // but changing the next model discards the cached values
+  cached->SetNext (cachedNext);
+  NS_TEST_EXPECT_MSG_EQ (cached->CalcRxPower (txPowerDbm, a, b), reference->CalcRxPower (txPowerDbm, a, b),
+                         "The cached value should have been discarded by SetNext");
+
+  // a different transmission power is not served from the cache
+  NS_TEST_EXPECT_MSG_EQ (cached->CalcRxPower (txPowerDbm + 3, a, b), reference->CalcRxPower (txPowerDbm + 3, a, b),
+                         "Got unexpected rcv power for a different transmission power");
+
+  // a course change invalidates the cached values in both directions
+  b->SetPosition (Vector (100,0,0));
+  NS_TEST_EXPECT_MSG_EQ (cached->CalcRxPower (txPowerDbm, a, b), reference->CalcRxPower (txPowerDbm, a, b),
+                         "Got unexpected rcv power after a course change");
+  NS_TEST_EXPECT_MSG_EQ (cached->CalcRxPower (txPowerDbm, b, a), reference->CalcRxPower (txPowerDbm, b, a),
+                         "Got unexpected rcv power in the reverse direction after a course change");
+  a->SetPosition (Vector (0,10,0));
+  NS_TEST_EXPECT_MSG_EQ (cached->CalcRxPower (txPowerDbm, b, a), reference->CalcRxPower (txPowerDbm, b, a),
+                         "Got unexpected rcv power after a course change of the destination");
+
+  // the reception power is not cached for moving models
+  Ptr<ConstantVelocityMobilityModel> c = CreateObject<ConstantVelocityMobilityModel> ();
+  c->SetPosition (Vector (0,0,20));
+  c->SetVelocity (Vector (1,0,0));
+  NS_TEST_EXPECT_MSG_EQ (cached->CalcRxPower (txPowerDbm, a, c), reference->CalcRxPower (txPowerDbm, a, c),
+                         "Got unexpected rcv power for a moving destination");
+  cachedNext->SetAttribute ("Exponent", DoubleValue (3));
+  referenceNext->SetAttribute ("Exponent", DoubleValue (3));
+  NS_TEST_EXPECT_MSG_EQ (cached->CalcRxPower (txPowerDbm, a, c), reference->CalcRxPower (txPowerDbm, a, c),
+                         "The rcv power should not have been cached for a moving destination");
+
+  // moving a paused lazy random waypoint model invalidates the cached values
+  Ptr<ListPositionAllocator> waypoints = CreateObject<ListPositionAllocator> ();
+  waypoints->Add (Vector (0,0,0));
+  Ptr<RandomWaypointMobilityModel> d = CreateObject<RandomWaypointMobilityModel> ();
+  d->SetAttribute ("Lazy", BooleanValue (true));
+  d->SetAttribute ("PositionAllocator", PointerValue (waypoints));
+  d->SetPosition (Vector (50,0,0));
+  d->Initialize ();
+  NS_TEST_EXPECT_MSG_EQ (cached->CalcRxPower (txPowerDbm, a, d), reference->CalcRxPower (txPowerDbm, a, d),
+                         "Got unexpected rcv power for a paused destination");
+  d->SetPosition (Vector (200,0,0));
+  NS_TEST_EXPECT_MSG_EQ (cached->CalcRxPower (txPowerDbm, a, d), reference->CalcRxPower (txPowerDbm, a, d),
+                         "Got unexpected rcv power after moving a lazy destination");
+
+  // nor when a model of the chain is not deterministic
+  Ptr<MatrixPropagationLossModel> matrix = CreateObject<MatrixPropagationLossModel> ();
+  matrix->SetDefaultLoss (10);
+  cachedNext->SetNext (matrix);
+  NS_TEST_ASSERT_MSG_EQ (cached->IsDeterministic (), false, "The matrix model is not deterministic");
+  double first = cached->CalcRxPower (txPowerDbm, a, b);
+  matrix->SetDefaultLoss (20);
+  NS_TEST_EXPECT_MSG_EQ_TOL (cached->CalcRxPower (txPowerDbm, a, b), first - 10, 1e-9,
+                             "The rcv power should not have been cached for a stochastic chain");
+
+  cached->Dispose ();
+  Simulator::Destroy ();
+}
+
+class BatchPropagationLossModelTestCase : public TestCase
+{
+public:
+  BatchPropagationLossModelTestCase ();
+  virtual ~BatchPropagationLossModelTestCase ();
+
+private:
+  virtual void DoRun (void);
+  /**
+   * Check that the batch and the per-destination reception powers are equal
+   * \param model the first model of the chain
+   * \param name the name of the chain
+   */
+  void CheckBatch (Ptr<PropagationLossModel> model, std::string name);
+
+  Ptr<MobilityModel> m_source;                     //!< the source
+  std::vector<Ptr<MobilityModel> > m_destinations; //!< the destinations
+};
+
+BatchPropagationLossModelTestCase::BatchPropagationLossModelTestCase ()
+  : TestCase ("Test the computation of the reception power at many destinations at once")
+{
+}
+
+BatchPropagationLossModelTestCase::~BatchPropagationLossModelTestCase ()
+{
+}
+
+void
+BatchPropagationLossModelTestCase::CheckBatch (Ptr<PropagationLossModel> model, std::string name)
+{
+  double txPowerDbm = 16.0206;
+  std::vector<double> rxPowersDbm;
+  model->CalcRxPower (txPowerDbm, m_source, m_destinations, rxPowersDbm);
+  NS_TEST_ASSERT_MSG_EQ (rxPowersDbm.size (), m_destinations.size (), name << ": wrong number of rcv powers");
+  for (std::size_t i = 0; i < m_destinations.size (); i++)
+    {
+      NS_TEST_EXPECT_MSG_EQ (rxPowersDbm[i], model->CalcRxPower (txPowerDbm, m_source, m_destinations[i]),
+                             name << ": got unexpected rcv power for destination " << i);
+    }
+}
+
+void
+BatchPropagationLossModelTestCase::DoRun (void)
+{
+  m_source = CreateObject<ConstantPositionMobilityModel> ();
+  m_source->SetPosition (Vector (0,0,1.5));
+  // destinations in all the regions of the models, including the source position
+  double distances[] = {0, 0.5, 1, 10, 99.9, 100, 127.1, 200, 500, 1000, 5000};
+  for (uint32_t i = 0; i < sizeof (distances) / sizeof (distances[0]); i++)
+    {
+      Ptr<MobilityModel> destination = CreateObject<ConstantPositionMobilityModel> ();
+      destination->SetPosition (Vector (distances[i],0,1.5 + i % 3));
+      m_destinations.push_back (destination);
+    }
+
+  CheckBatch (CreateObject<FriisPropagationLossModel> (), "Friis");
+  CheckBatch (CreateObject<TwoRayGroundPropagationLossModel> (), "TwoRayGround");
+  CheckBatch (CreateObject<LogDistancePropagationLossModel> (), "LogDistance");
+  CheckBatch (CreateObject<ThreeLogDistancePropagationLossModel> (), "ThreeLogDistance");
+  Ptr<RangePropagationLossModel> range = CreateObject<RangePropagationLossModel> ();
+  range->SetAttribute ("MaxRange", DoubleValue (127.2));
+  CheckBatch (range, "Range");
+
+  // models without a batch implementation and chains
+  Ptr<MatrixPropagationLossModel> matrix = CreateObject<MatrixPropagationLossModel> ();
+  matrix->SetDefaultLoss (10);
+  matrix->SetLoss (m_source, m_destinations[3], 20);
+  CheckBatch (matrix, "Matrix");
+  Ptr<FriisPropagationLossModel> friis = CreateObject<FriisPropagationLossModel> ();
+  Ptr<ThreeLogDistancePropagationLossModel> threeLog = CreateObject<ThreeLogDistancePropagationLossModel> ();
+  friis->SetNext (threeLog);
+  threeLog->SetNext (matrix);
+  CheckBatch (friis, "Friis+ThreeLogDistance+Matrix");
+  threeLog->SetNext (0);
+  friis->SetAttribute ("CacheRxPower", BooleanValue (true));
+  CheckBatch (friis, "cached Friis+ThreeLogDistance");
+
+  m_source = 0;
+  m_destinations.clear ();
+  Simulator::Destroy ();
+}
+
 class PropagationLossModelsTestSuite : public TestSuite
 {
 public:
@@ -450,6 +644,8 @@ PropagationLossModelsTestSuite::PropagationLossModelsTestSuite ()
   AddTestCase (new LogDistancePropagationLossModelTestCase, TestCase::QUICK);
   AddTestCase (new MatrixPropagationLossModelTestCase, TestCase::QUICK);
   AddTestCase (new RangePropagationLossModelTestCase, TestCase::QUICK);
+  AddTestCase (new CachedPropagationLossModelTestCase, TestCase::QUICK);
+  AddTestCase (new BatchPropagationLossModelTestCase, TestCase::QUICK);
 }
 
 static PropagationLossModelsTestSuite propagationLossModelsTestSuite;
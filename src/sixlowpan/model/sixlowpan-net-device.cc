@@ -20,6 +20,7 @@
  */
 
 #include "ns3/node.h"
+#include "ns3/node-list.h"
 #include "ns3/channel.h"
 #include "ns3/packet.h"
 #include "ns3/log.h"
@@ -290,6 +291,7 @@ void SixLowPanNetDevice::SetAddress (Address address)
   NS_ASSERT_MSG ( m_netDevice != 0, "Sixlowpan: can't find any lower-layer protocol " << m_netDevice );
 
   m_netDevice->SetAddress (address);
+  NodeList::NotifyAddressChange (this);
 }
 
 Address SixLowPanNetDevice::GetAddress (void) const
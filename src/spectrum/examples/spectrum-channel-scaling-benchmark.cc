@@ -0,0 +1,161 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+//
+// This program measures how the cost of a transmission on a
+// MultiModelSpectrumChannel scales with the number of receivers.
+//
+// For 10, 100, ... up to --maxReceivers HalfDuplexIdealPhy receivers,
+// placed uniformly at random in a square of side --side meters, half of
+// them using SpectrumModelIsm2400MhzRes1Mhz and the other half a 5 MHz
+// resolution model of the same band, --nFrames signals (1000 by default)
+// are transmitted by randomly chosen PHYs, one at a time, on a channel with
+// a log-distance propagation loss model and a propagation delay. The wall
+// clock time per frame is reported for each number of receivers. The
+// receivers further than --maxRange meters from the transmitter are culled
+// by the channel when it is positive.
+//
+// Example: ./waf --run "spectrum-channel-scaling-benchmark --maxReceivers=10000 --maxRange=300"
+//
+
+#include <iostream>
+#include "ns3/command-line.h"
+#include "ns3/boolean.h"
+#include "ns3/double.h"
+#include "ns3/simulator.h"
+#include "ns3/random-variable-stream.h"
+#include "ns3/system-wall-clock-ms.h"
+#include "ns3/node.h"
+#include "ns3/constant-position-mobility-model.h"
+#include "ns3/propagation-loss-model.h"
+#include "ns3/propagation-delay-model.h"
+#include "ns3/multi-model-spectrum-channel.h"
+#include "ns3/half-duplex-ideal-phy.h"
+#include "ns3/spectrum-model-ism2400MHz-res1MHz.h"
+
+using namespace ns3;
+
+/**
+ * Transmit a signal from the given PHY
+ *
+ * \param channel the channel
+ * \param phy the transmitting PHY
+ * \param psd the transmitted PSD
+ */
+static void
+Transmit (Ptr<SpectrumChannel> channel, Ptr<SpectrumPhy> phy, Ptr<SpectrumValue> psd)
+{
+  Ptr<SpectrumSignalParameters> params = Create<SpectrumSignalParameters> ();
+  params->duration = MicroSeconds (100);
+  params->txPhy = phy;
+  params->psd = psd;
+  channel->StartTx (params);
+}
+
+/**
+ * Run the benchmark for the given number of receivers
+ *
+ * \param nReceivers the number of receivers
+ * \param nFrames the number of frames
+ * \param side the side of the square (m)
+ * \param maxRange the MaxRange attribute of the channel (m)
+ *
+ * \return the wall clock time (ms)
+ */
+static int64_t
+RunBenchmark (uint32_t nReceivers, uint32_t nFrames, double side, double maxRange)
+{
+  std::vector<double> centerFrequencies;
+  for (uint32_t i = 0; i < 20; i++)
+    {
+      centerFrequencies.push_back (2402.5e6 + i * 5e6);
+    }
+  Ptr<SpectrumModel> models[] = {SpectrumModelIsm2400MhzRes1Mhz, Create<SpectrumModel> (centerFrequencies)};
+
+  Ptr<MultiModelSpectrumChannel> channel = CreateObject<MultiModelSpectrumChannel> ();
+  channel->SetAttribute ("CachePsdConversions", BooleanValue (true));
+  channel->SetAttribute ("MaxRange", DoubleValue (maxRange));
+  channel->AddPropagationLossModel (CreateObject<LogDistancePropagationLossModel> ());
+  channel->SetPropagationDelayModel (CreateObject<ConstantSpeedPropagationDelayModel> ());
+
+  Ptr<UniformRandomVariable> random = CreateObject<UniformRandomVariable> ();
+  std::vector<Ptr<HalfDuplexIdealPhy> > phys;
+  std::vector<Ptr<SpectrumValue> > psds;
+  for (uint32_t i = 0; i < nReceivers; i++)
+    {
+      Ptr<Node> node = CreateObject<Node> ();
+      Ptr<MobilityModel> mobility = CreateObject<ConstantPositionMobilityModel> ();
+      mobility->SetPosition (Vector (random->GetValue (0, side), random->GetValue (0, side), 0));
+      node->AggregateObject (mobility);
+      Ptr<SpectrumValue> psd = Create<SpectrumValue> (models[i % 2]);
+      (*psd) = 1e-9;
+      Ptr<SpectrumValue> noisePsd = Create<SpectrumValue> (models[i % 2]);
+      (*noisePsd) = 1e-21;
+      Ptr<HalfDuplexIdealPhy> phy = CreateObject<HalfDuplexIdealPhy> ();
+      phy->SetMobility (mobility);
+      phy->SetChannel (channel);
+      phy->SetTxPowerSpectralDensity (psd);
+      phy->SetNoisePowerSpectralDensity (noisePsd);
+      channel->AddRx (phy);
+      phys.push_back (phy);
+      psds.push_back (psd);
+    }
+
+  for (uint32_t i = 0; i < nFrames; i++)
+    {
+      uint32_t sender = random->GetInteger (0, nReceivers - 1);
+      Simulator::Schedule (MilliSeconds (i), &Transmit, channel, phys[sender], psds[sender]);
+    }
+
+  SystemWallClockMs clock;
+  clock.Start ();
+  Simulator::Run ();
+  int64_t elapsed = clock.End ();
+
+  Simulator::Destroy ();
+  for (std::vector<Ptr<HalfDuplexIdealPhy> >::iterator it = phys.begin (); it != phys.end (); ++it)
+    {
+      (*it)->Dispose ();
+    }
+  channel->Dispose ();
+  return elapsed;
+}
+
+int
+main (int argc, char *argv[])
+{
+  uint32_t maxReceivers = 1000;
+  uint32_t nFrames = 1000;
+  double side = 1000;
+  double maxRange = 0;
+
+  CommandLine cmd;
+  cmd.AddValue ("maxReceivers", "Maximum number of receivers", maxReceivers);
+  cmd.AddValue ("nFrames", "Number of frames for each number of receivers", nFrames);
+  cmd.AddValue ("side", "Side of the square in which the receivers are placed (m)", side);
+  cmd.AddValue ("maxRange", "MaxRange attribute of the channel (m), zero for no limit", maxRange);
+  cmd.Parse (argc, argv);
+
+  for (uint32_t nReceivers = 10; nReceivers <= maxReceivers; nReceivers *= 10)
+    {
+      int64_t elapsed = RunBenchmark (nReceivers, nFrames, side, maxRange);
+      std::cout << "receivers=" << nReceivers
+                << " wall-clock=" << elapsed << "ms"
+                << " per-frame=" << elapsed * 1000.0 / nFrames << "us" << std::endl;
+    }
+
+  return 0;
+}
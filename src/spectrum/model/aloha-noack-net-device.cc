@@ -30,6 +30,7 @@
 #include "aloha-noack-mac-header.h"
 #include "aloha-noack-net-device.h"
 #include "ns3/llc-snap-header.h"
+#include "ns3/node-list.h"
 
 namespace ns3 {
 
@@ -185,6 +186,7 @@ AlohaNoackNetDevice::SetAddress (Address address)
 {
   NS_LOG_FUNCTION (this);
   m_address = Mac48Address::ConvertFrom (address);
+  NodeList::NotifyAddressChange (this);
 }
 
 Address
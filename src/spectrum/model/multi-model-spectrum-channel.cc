@@ -34,6 +34,8 @@
 #include <ns3/propagation-delay-model.h>
 #include <ns3/antenna-model.h>
 #include <ns3/angles.h>
+#include <ns3/boolean.h>
+#include <algorithm>
 #include <iostream>
 #include <utility>
 #include "multi-model-spectrum-channel.h"
@@ -82,6 +84,7 @@ RxSpectrumModelInfo::RxSpectrumModelInfo (Ptr<const SpectrumModel> rxSpectrumMod
 
 
 MultiModelSpectrumChannel::MultiModelSpectrumChannel ()
+  : m_maxRange (0)
 {
   NS_LOG_FUNCTION (this);
 }
@@ -92,6 +95,8 @@ MultiModelSpectrumChannel::DoDispose ()
   NS_LOG_FUNCTION (this);
   m_txSpectrumModelInfoMap.clear ();
   m_rxSpectrumModelInfoMap.clear ();
+  m_phys.clear ();
+  m_phyRxSpectrumModelUids.clear ();
   SpectrumChannel::DoDispose ();
 }
 
@@ -102,7 +107,27 @@ MultiModelSpectrumChannel::GetTypeId (void)
     .SetParent<SpectrumChannel> ()
     .SetGroupName ("Spectrum")
     .AddConstructor<MultiModelSpectrumChannel> ()
-
+    .AddAttribute ("CachePsdConversions",
+                   "If true, the conversion of a transmitted PSD to the "
+                   "SpectrumModel of each receiver is kept and reused when "
+                   "the same SpectrumValue object is transmitted again, "
+                   "which is the case for PHYs reusing their Tx PSD, such as "
+                   "SpectrumWifiPhy. This requires that transmitted PSDs are "
+                   "not modified after being passed to StartTx.",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&MultiModelSpectrumChannel::m_cachePsdConversions),
+                   MakeBooleanChecker ())
+    .AddAttribute ("MaxRange",
+                   "If positive, the maximum distance (m) between the "
+                   "transmitter and a receiver for which a signal is passed "
+                   "to the receiver. Receivers further away are skipped "
+                   "before any loss is computed for them, which reduces the "
+                   "cost of a transmission in large topologies. Receivers "
+                   "without a MobilityModel are not affected. Zero means no "
+                   "limit.",
+                   DoubleValue (0),
+                   MakeDoubleAccessor (&MultiModelSpectrumChannel::m_maxRange),
+                   MakeDoubleChecker<double> (0))
   ;
   return tid;
 }
@@ -120,24 +145,25 @@ MultiModelSpectrumChannel::AddRx (Ptr<SpectrumPhy> phy)
 
   SpectrumModelUid_t rxSpectrumModelUid = rxSpectrumModel->GetUid ();
 
-  // remove a previous entry of this phy if it exists
-  // we need to scan for all rxSpectrumModel values since we don't
-  // know which spectrum model the phy had when it was previously added
+  // remove a previous entry of this phy if it exists, from the receivers
+  // of the spectrum model the phy had when it was previously added
   // (it's probably different than the current one)
-  for (RxSpectrumModelInfoMap_t::iterator rxInfoIterator = m_rxSpectrumModelInfoMap.begin ();
-       rxInfoIterator !=  m_rxSpectrumModelInfoMap.end ();
-       ++rxInfoIterator)
+  std::map<Ptr<SpectrumPhy>, SpectrumModelUid_t>::iterator uidIt = m_phyRxSpectrumModelUids.find (phy);
+  if (uidIt != m_phyRxSpectrumModelUids.end ())
     {
-      std::set<Ptr<SpectrumPhy> >::iterator phyIt = rxInfoIterator->second.m_rxPhySet.find (phy);
-      if (phyIt !=  rxInfoIterator->second.m_rxPhySet.end ())
-        {
-          rxInfoIterator->second.m_rxPhySet.erase (phyIt);
-          --m_numDevices;
-          break; // there should be at most one entry
-        }       
+      RxSpectrumModelInfoMap_t::iterator previousRxInfoIterator = m_rxSpectrumModelInfoMap.find (uidIt->second);
+      NS_ASSERT (previousRxInfoIterator != m_rxSpectrumModelInfoMap.end ());
+      std::vector<Ptr<SpectrumPhy> > &rxPhys = previousRxInfoIterator->second.m_rxPhys;
+      std::vector<Ptr<SpectrumPhy> >::iterator phyIt = std::find (rxPhys.begin (), rxPhys.end (), phy);
+      NS_ASSERT (phyIt != rxPhys.end ());
+      rxPhys.erase (phyIt);
+      uidIt->second = rxSpectrumModelUid;
+    }
+  else
+    {
+      m_phys.push_back (phy);
+      m_phyRxSpectrumModelUids.insert (std::make_pair (phy, rxSpectrumModelUid));
     }
-
-  ++m_numDevices;
 
   RxSpectrumModelInfoMap_t::iterator rxInfoIterator = m_rxSpectrumModelInfoMap.find (rxSpectrumModelUid);
 
@@ -147,9 +173,8 @@ MultiModelSpectrumChannel::AddRx (Ptr<SpectrumPhy> phy)
       std::pair<RxSpectrumModelInfoMap_t::iterator, bool> ret;
       ret = m_rxSpectrumModelInfoMap.insert (std::make_pair (rxSpectrumModelUid, RxSpectrumModelInfo (rxSpectrumModel)));
       NS_ASSERT (ret.second);
-      // also add the phy to the newly created set of SpectrumPhy for this RxSpectrumModel
-      std::pair<std::set<Ptr<SpectrumPhy> >::iterator, bool> ret2 = ret.first->second.m_rxPhySet.insert (phy);
-      NS_ASSERT (ret2.second);
+      // also add the phy to the newly created list of SpectrumPhy for this RxSpectrumModel
+      ret.first->second.m_rxPhys.push_back (phy);
 
       // and create the necessary converters for all the TX spectrum models that we know of
       for (TxSpectrumModelInfoMap_t::iterator txInfoIterator = m_txSpectrumModelInfoMap.begin ();
@@ -172,14 +197,13 @@ MultiModelSpectrumChannel::AddRx (Ptr<SpectrumPhy> phy)
   else
     {
       // spectrum model is already known, just add the device to the corresponding list
-      std::pair<std::set<Ptr<SpectrumPhy> >::iterator, bool> ret2 = rxInfoIterator->second.m_rxPhySet.insert (phy);
-      NS_ASSERT (ret2.second);
+      rxInfoIterator->second.m_rxPhys.push_back (phy);
     }
 
 }
 
 
-TxSpectrumModelInfoMap_t::const_iterator
+TxSpectrumModelInfoMap_t::iterator
 MultiModelSpectrumChannel::FindAndEventuallyAddTxSpectrumModel (Ptr<const SpectrumModel> txSpectrumModel)
 {
   NS_LOG_FUNCTION (this << txSpectrumModel);
@@ -234,11 +258,16 @@ MultiModelSpectrumChannel::StartTx (Ptr<SpectrumSignalParameters> txParams)
   m_txSigParamsTrace (txParamsTrace);
 
   Ptr<MobilityModel> txMobility = txParams->txPhy->GetMobility ();
+  Vector txPosition;
+  if (txMobility && m_maxRange > 0)
+    {
+      txPosition = txMobility->GetPosition ();
+    }
   SpectrumModelUid_t txSpectrumModelUid = txParams->psd->GetSpectrumModelUid ();
   NS_LOG_LOGIC (" txSpectrumModelUid " << txSpectrumModelUid);
 
   //
-  TxSpectrumModelInfoMap_t::const_iterator txInfoIteratorerator = FindAndEventuallyAddTxSpectrumModel (txParams->psd->GetSpectrumModel ());
+  TxSpectrumModelInfoMap_t::iterator txInfoIteratorerator = FindAndEventuallyAddTxSpectrumModel (txParams->psd->GetSpectrumModel ());
   NS_ASSERT (txInfoIteratorerator != m_txSpectrumModelInfoMap.end ());
 
   NS_LOG_LOGIC ("converter map for TX SpectrumModel with Uid " << txInfoIteratorerator->first);
@@ -267,88 +296,142 @@ MultiModelSpectrumChannel::StartTx (Ptr<SpectrumSignalParameters> txParams)
               // No converter means TX SpectrumModel is orthogonal to RX SpectrumModel
               continue;
             }
-          convertedTxPowerSpectrum = rxConverterIterator->second.Convert (txParams->psd);
+          if (m_cachePsdConversions)
+            {
+              ConvertedPsd &converted = txInfoIteratorerator->second.m_convertedPsdMap[rxSpectrumModelUid];
+              if (converted.m_txPsd != txParams->psd)
+                {
+                  converted.m_txPsd = txParams->psd;
+                  converted.m_rxPsd = rxConverterIterator->second.Convert (txParams->psd);
+                }
+              else
+                {
+                  NS_LOG_LOGIC (" reusing the last conversion of this txPowerSpectrum");
+                }
+              convertedTxPowerSpectrum = converted.m_rxPsd;
+            }
+          else
+            {
+              convertedTxPowerSpectrum = rxConverterIterator->second.Convert (txParams->psd);
+            }
         }
 
-
-      for (std::set<Ptr<SpectrumPhy> >::const_iterator rxPhyIterator = rxInfoIterator->second.m_rxPhySet.begin ();
-           rxPhyIterator != rxInfoIterator->second.m_rxPhySet.end ();
+      // the signal parameters of each receiver are copied from txParams,
+      // which hence carries the converted PSD while iterating over the
+      // receivers, so that the copy does not allocate a PSD to be discarded
+      Ptr<SpectrumValue> txPowerSpectrum = txParams->psd;
+      txParams->psd = convertedTxPowerSpectrum;
+
+
+      // the receivers of this Rx SpectrumModel, except the transmitter and
+      // the receivers beyond MaxRange, and the propagation gains to all of
+      // them, which are computed at once
+      const std::vector<Ptr<SpectrumPhy> > &rxPhys = rxInfoIterator->second.m_rxPhys;
+      std::vector<Ptr<SpectrumPhy> > receivers;
+      std::vector<Ptr<MobilityModel> > receiverMobilities;
+      receivers.reserve (rxPhys.size ());
+      receiverMobilities.reserve (rxPhys.size ());
+      for (std::vector<Ptr<SpectrumPhy> >::const_iterator rxPhyIterator = rxPhys.begin ();
+           rxPhyIterator != rxPhys.end ();
            ++rxPhyIterator)
         {
           NS_ASSERT_MSG ((*rxPhyIterator)->GetRxSpectrumModel ()->GetUid () == rxSpectrumModelUid,
                          "SpectrumModel change was not notified to MultiModelSpectrumChannel (i.e., AddRx should be called again after model is changed)");
 
-          if ((*rxPhyIterator) != txParams->txPhy)
+          if ((*rxPhyIterator) == txParams->txPhy)
             {
-              NS_LOG_LOGIC (" copying signal parameters " << txParams);
-              Ptr<SpectrumSignalParameters> rxParams = txParams->Copy ();
-              rxParams->psd = Copy<SpectrumValue> (convertedTxPowerSpectrum);
-              Time delay = MicroSeconds (0);
+              continue;
+            }
+          Ptr<MobilityModel> receiverMobility = (*rxPhyIterator)->GetMobility ();
+          if (txMobility && receiverMobility)
+            {
+              if (m_maxRange > 0 && CalculateDistance (txPosition, receiverMobility->GetPosition ()) > m_maxRange)
+                {
+                  NS_LOG_LOGIC ("receiver " << *rxPhyIterator << " beyond MaxRange");
+                  continue;
+                }
+              receiverMobilities.push_back (receiverMobility);
+            }
+          receivers.push_back (*rxPhyIterator);
+        }
+      std::vector<double> propagationGainsDb;
+      if (m_propagationLoss && !receiverMobilities.empty ())
+        {
+          m_propagationLoss->CalcRxPower (0, txMobility, receiverMobilities, propagationGainsDb);
+        }
+      std::vector<double>::const_iterator nextPropagationGainDb = propagationGainsDb.begin ();
+
+      for (std::vector<Ptr<SpectrumPhy> >::const_iterator rxPhyIterator = receivers.begin ();
+           rxPhyIterator != receivers.end ();
+           ++rxPhyIterator)
+        {
+          NS_LOG_LOGIC (" copying signal parameters " << txParams);
+          Ptr<SpectrumSignalParameters> rxParams = txParams->Copy ();
+          Time delay = MicroSeconds (0);
 
-              Ptr<MobilityModel> receiverMobility = (*rxPhyIterator)->GetMobility ();
+          Ptr<MobilityModel> receiverMobility = (*rxPhyIterator)->GetMobility ();
 
-              if (txMobility && receiverMobility)
+          if (txMobility && receiverMobility)
+            {
+              double pathLossDb = 0;
+              if (rxParams->txAntenna != 0)
+                {
+                  Angles txAngles (receiverMobility->GetPosition (), txMobility->GetPosition ());
+                  double txAntennaGain = rxParams->txAntenna->GetGainDb (txAngles);
+                  NS_LOG_LOGIC ("txAntennaGain = " << txAntennaGain << " dB");
+                  pathLossDb -= txAntennaGain;
+                }
+              Ptr<AntennaModel> rxAntenna = (*rxPhyIterator)->GetRxAntenna ();
+              if (rxAntenna != 0)
                 {
-                  double pathLossDb = 0;
-                  if (rxParams->txAntenna != 0)
-                    {
-                      Angles txAngles (receiverMobility->GetPosition (), txMobility->GetPosition ());
-                      double txAntennaGain = rxParams->txAntenna->GetGainDb (txAngles);
-                      NS_LOG_LOGIC ("txAntennaGain = " << txAntennaGain << " dB");
-                      pathLossDb -= txAntennaGain;
-                    }
-                  Ptr<AntennaModel> rxAntenna = (*rxPhyIterator)->GetRxAntenna ();
-                  if (rxAntenna != 0)
-                    {
-                      Angles rxAngles (txMobility->GetPosition (), receiverMobility->GetPosition ());
-                      double rxAntennaGain = rxAntenna->GetGainDb (rxAngles);
-                      NS_LOG_LOGIC ("rxAntennaGain = " << rxAntennaGain << " dB");
-                      pathLossDb -= rxAntennaGain;
-                    }
-                  if (m_propagationLoss)
-                    {
-                      double propagationGainDb = m_propagationLoss->CalcRxPower (0, txMobility, receiverMobility);
-                      NS_LOG_LOGIC ("propagationGainDb = " << propagationGainDb << " dB");
-                      pathLossDb -= propagationGainDb;
-                    }                    
-                  NS_LOG_LOGIC ("total pathLoss = " << pathLossDb << " dB");    
-                  m_pathLossTrace (txParams->txPhy, *rxPhyIterator, pathLossDb);
-                  if ( pathLossDb > m_maxLossDb)
-                    {
-                      // beyond range
-                      continue;
-                    }
-                  double pathGainLinear = std::pow (10.0, (-pathLossDb) / 10.0);
-                  *(rxParams->psd) *= pathGainLinear;              
-
-                  if (m_spectrumPropagationLoss)
-                    {
-                      rxParams->psd = m_spectrumPropagationLoss->CalcRxPowerSpectralDensity (rxParams->psd, txMobility, receiverMobility);
-                    }
-
-                  if (m_propagationDelay)
-                    {
-                      delay = m_propagationDelay->GetDelay (txMobility, receiverMobility);
-                    }
+                  Angles rxAngles (txMobility->GetPosition (), receiverMobility->GetPosition ());
+                  double rxAntennaGain = rxAntenna->GetGainDb (rxAngles);
+                  NS_LOG_LOGIC ("rxAntennaGain = " << rxAntennaGain << " dB");
+                  pathLossDb -= rxAntennaGain;
                 }
+              if (m_propagationLoss)
+                {
+                  double propagationGainDb = *nextPropagationGainDb++;
+                  NS_LOG_LOGIC ("propagationGainDb = " << propagationGainDb << " dB");
+                  pathLossDb -= propagationGainDb;
+                }                    
+              NS_LOG_LOGIC ("total pathLoss = " << pathLossDb << " dB");    
+              m_pathLossTrace (txParams->txPhy, *rxPhyIterator, pathLossDb);
+              if ( pathLossDb > m_maxLossDb)
+                {
+                  // beyond range
+                  continue;
+                }
+              double pathGainLinear = std::pow (10.0, (-pathLossDb) / 10.0);
+              *(rxParams->psd) *= pathGainLinear;              
 
-              Ptr<NetDevice> netDev = (*rxPhyIterator)->GetDevice ();
-              if (netDev)
+              if (m_spectrumPropagationLoss)
                 {
-                  // the receiver has a NetDevice, so we expect that it is attached to a Node
-                  uint32_t dstNode =  netDev->GetNode ()->GetId ();
-                  Simulator::ScheduleWithContext (dstNode, delay, &MultiModelSpectrumChannel::StartRx, this,
-                                                  rxParams, *rxPhyIterator);
+                  rxParams->psd = m_spectrumPropagationLoss->CalcRxPowerSpectralDensity (rxParams->psd, txMobility, receiverMobility);
                 }
-              else
+
+              if (m_propagationDelay)
                 {
-                  // the receiver is not attached to a NetDevice, so we cannot assume that it is attached to a node
-                  Simulator::Schedule (delay, &MultiModelSpectrumChannel::StartRx, this,
-                                       rxParams, *rxPhyIterator);
+                  delay = m_propagationDelay->GetDelay (txMobility, receiverMobility);
                 }
             }
-        }
 
+          Ptr<NetDevice> netDev = (*rxPhyIterator)->GetDevice ();
+          if (netDev)
+            {
+              // the receiver has a NetDevice, so we expect that it is attached to a Node
+              uint32_t dstNode =  netDev->GetNode ()->GetId ();
+              Simulator::ScheduleWithContext (dstNode, delay, &MultiModelSpectrumChannel::StartRx, this,
+                                              rxParams, *rxPhyIterator);
+            }
+          else
+            {
+              // the receiver is not attached to a NetDevice, so we cannot assume that it is attached to a node
+              Simulator::Schedule (delay, &MultiModelSpectrumChannel::StartRx, this,
+                                   rxParams, *rxPhyIterator);
+            }
+        }
+      txParams->psd = txPowerSpectrum;
     }
 
 }
@@ -363,39 +446,14 @@ MultiModelSpectrumChannel::StartRx (Ptr<SpectrumSignalParameters> params, Ptr<Sp
 std::size_t
 MultiModelSpectrumChannel::GetNDevices (void) const
 {
-  return m_numDevices;
+  return m_phys.size ();
 }
 
 Ptr<NetDevice>
 MultiModelSpectrumChannel::GetDevice (std::size_t i) const
 {
-  NS_ASSERT (i < m_numDevices);
-  // this method implementation is computationally intensive. This
-  // method would be faster if we actually used a std::vector for
-  // storing devices, which we don't due to the need to have fast 
-  // SpectrumModel conversions and to allow PHY devices to change a
-  // SpectrumModel at run time. Note that having this method slow is
-  // acceptable as it is not used much at run time (often not at all).
-  // On the other hand, having slow SpectrumModel conversion would be
-  // less acceptable. 
-  std::size_t j = 0;
-  for (RxSpectrumModelInfoMap_t::const_iterator rxInfoIterator = m_rxSpectrumModelInfoMap.begin ();
-       rxInfoIterator !=  m_rxSpectrumModelInfoMap.end ();
-       ++rxInfoIterator)
-    {
-      for (std::set<Ptr<SpectrumPhy> >::const_iterator phyIt = rxInfoIterator->second.m_rxPhySet.begin ();
-           phyIt != rxInfoIterator->second.m_rxPhySet.end ();
-           ++phyIt)        
-        {
-          if (j == i)
-            {
-              return (*phyIt)->GetDevice ();
-            }
-          j++;
-        }
-    }
-  NS_FATAL_ERROR ("m_numDevice > actual number of devices");
-  return 0;
+  NS_ASSERT (i < m_phys.size ());
+  return m_phys[i]->GetDevice ();
 }
 
 } // namespace ns3
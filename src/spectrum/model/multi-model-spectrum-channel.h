@@ -28,7 +28,7 @@
 #include <ns3/spectrum-propagation-loss-model.h>
 #include <ns3/propagation-delay-model.h>
 #include <map>
-#include <set>
+#include <vector>
 
 namespace ns3 {
 
@@ -39,6 +39,22 @@ namespace ns3 {
  */
 typedef std::map<SpectrumModelUid_t, SpectrumConverter> SpectrumConverterMap_t;
 
+/**
+ * \ingroup spectrum
+ * A Tx PSD and its conversion to a Rx spectrum model
+ */
+struct ConvertedPsd
+{
+  Ptr<const SpectrumValue> m_txPsd; //!< the Tx PSD
+  Ptr<SpectrumValue> m_rxPsd;       //!< the Tx PSD converted to the Rx spectrum model
+};
+
+/**
+ * \ingroup spectrum
+ * Container: SpectrumModelUid_t, ConvertedPsd
+ */
+typedef std::map<SpectrumModelUid_t, ConvertedPsd> ConvertedPsdMap_t;
+
 /**
  * \ingroup spectrum
  * The Tx spectrum model information. This class is used to convert
@@ -55,6 +71,7 @@ public:
 
   Ptr<const SpectrumModel> m_txSpectrumModel;     //!< Tx Spectrum model.
   SpectrumConverterMap_t m_spectrumConverterMap;  //!< Spectrum converter.
+  ConvertedPsdMap_t m_convertedPsdMap;            //!< Last PSD converted to each Rx Spectrum model.
 };
 
 
@@ -80,7 +97,7 @@ public:
   RxSpectrumModelInfo (Ptr<const SpectrumModel> rxSpectrumModel);
 
   Ptr<const SpectrumModel> m_rxSpectrumModel;  //!< Rx Spectrum model.
-  std::set<Ptr<SpectrumPhy> > m_rxPhySet;      //!< Container of the Rx Spectrum phy objects.
+  std::vector<Ptr<SpectrumPhy> > m_rxPhys;     //!< Container of the Rx Spectrum phy objects, in the order in which they were added.
 };
 
 /**
@@ -139,7 +156,7 @@ private:
    *
    * \return An iterator pointing to the corresponding entry in m_txSpectrumModelInfoMap
    */
-  TxSpectrumModelInfoMap_t::const_iterator FindAndEventuallyAddTxSpectrumModel (Ptr<const SpectrumModel> txSpectrumModel);
+  TxSpectrumModelInfoMap_t::iterator FindAndEventuallyAddTxSpectrumModel (Ptr<const SpectrumModel> txSpectrumModel);
 
   /**
    * Used internally to reschedule transmission after the propagation delay.
@@ -165,9 +182,28 @@ private:
   RxSpectrumModelInfoMap_t m_rxSpectrumModelInfoMap;
 
   /**
-   * Number of devices connected to the channel.
+   * All the SpectrumPhy instances connected to the channel, in the order
+   * in which they were first added, for GetDevice.
+   */
+  std::vector<Ptr<SpectrumPhy> > m_phys;
+
+  /**
+   * The Rx SpectrumModel with which each SpectrumPhy instance was last
+   * added, to find it when it is added again.
+   */
+  std::map<Ptr<SpectrumPhy>, SpectrumModelUid_t> m_phyRxSpectrumModelUids;
+
+  /**
+   * Maximum distance between the transmitter and the receivers for which
+   * signals are delivered, zero meaning no limit.
+   */
+  double m_maxRange;
+
+  /**
+   * Whether the conversion of a Tx PSD to each Rx SpectrumModel is reused
+   * when the same PSD object is transmitted again.
    */
-  std::size_t m_numDevices;
+  bool m_cachePsdConversions;
 
 };
 
@@ -106,6 +106,26 @@ SingleModelSpectrumChannel::StartTx (Ptr<SpectrumSignalParameters> txParams)
 
   Ptr<MobilityModel> senderMobility = txParams->txPhy->GetMobility ();
 
+  // compute the propagation gain to all the receivers at once
+  std::vector<double> propagationGainsDb;
+  if (senderMobility && m_propagationLoss)
+    {
+      std::vector<Ptr<MobilityModel> > receiverMobilities;
+      receiverMobilities.reserve (m_phyList.size ());
+      for (PhyList::const_iterator rxPhyIterator = m_phyList.begin ();
+           rxPhyIterator != m_phyList.end ();
+           ++rxPhyIterator)
+        {
+          Ptr<MobilityModel> receiverMobility = (*rxPhyIterator)->GetMobility ();
+          if ((*rxPhyIterator) != txParams->txPhy && receiverMobility)
+            {
+              receiverMobilities.push_back (receiverMobility);
+            }
+        }
+      m_propagationLoss->CalcRxPower (0, senderMobility, receiverMobilities, propagationGainsDb);
+    }
+  std::vector<double>::const_iterator nextPropagationGainDb = propagationGainsDb.begin ();
+
   for (PhyList::const_iterator rxPhyIterator = m_phyList.begin ();
        rxPhyIterator != m_phyList.end ();
        ++rxPhyIterator)
@@ -138,7 +158,7 @@ SingleModelSpectrumChannel::StartTx (Ptr<SpectrumSignalParameters> txParams)
                 }
               if (m_propagationLoss)
                 {
-                  double propagationGainDb = m_propagationLoss->CalcRxPower (0, senderMobility, receiverMobility);
+                  double propagationGainDb = *nextPropagationGainDb++;
                   NS_LOG_LOGIC ("propagationGainDb = " << propagationGainDb << " dB");
                   pathLossDb -= propagationGainDb;
                 }                    
@@ -22,20 +22,148 @@
 #include <ns3/spectrum-value.h>
 #include <ns3/math.h>
 #include <ns3/log.h>
+#include <map>
+#include <utility>
+#include <algorithm>
 
 namespace ns3 {
 
 NS_LOG_COMPONENT_DEFINE ("SpectrumValue");
 
+/**
+ * Maximum number of free value buffers of a given size. The free lists
+ * avoid allocating and freeing the values of the PSDs of the common
+ * spectrum models for every signal and every operation.
+ */
+static const size_t FREE_VALUES_MAX_SIZE = 64;
+
+/// Free value buffers, indexed by their number of values
+typedef std::map<size_t, std::vector<Values> > FreeValuesMap;
+
+/// Free value buffers, created upon the first release of a buffer
+static FreeValuesMap *g_freeValues = 0;
+
+/// Whether the free value buffers were destroyed, at the end of the program
+static bool g_freeValuesDestroyed = false;
+
+/**
+ * \ingroup spectrum
+ * Destroys the free value buffers at the end of the program
+ */
+static struct FreeValuesDestructor
+{
+  ~FreeValuesDestructor ()
+  {
+    delete g_freeValues;
+    g_freeValues = 0;
+    g_freeValuesDestroyed = true;
+  }
+} g_freeValuesDestructor; //!< destroys the free value buffers
+
+/**
+ * Take a buffer of the given size from the free list, if any
+ *
+ * \param size the number of values
+ * \param values the buffer to replace with a free buffer
+ * \return true if values was replaced with a free buffer of the given size
+ */
+static bool
+AllocateValues (size_t size, Values &values)
+{
+  if (g_freeValues == 0)
+    {
+      return false;
+    }
+  FreeValuesMap::iterator it = g_freeValues->find (size);
+  if (it == g_freeValues->end () || it->second.empty ())
+    {
+      return false;
+    }
+  values.swap (it->second.back ());
+  it->second.pop_back ();
+  return true;
+}
+
+/**
+ * Give a buffer back to the free list, unless the free list is full
+ *
+ * \param values the buffer, which is left empty
+ */
+static void
+ReleaseValues (Values &values)
+{
+  if (values.empty () || g_freeValuesDestroyed)
+    {
+      return;
+    }
+  if (g_freeValues == 0)
+    {
+      g_freeValues = new FreeValuesMap ();
+    }
+  std::vector<Values> &freeList = (*g_freeValues)[values.size ()];
+  if (freeList.size () < FREE_VALUES_MAX_SIZE)
+    {
+      freeList.push_back (Values ());
+      freeList.back ().swap (values);
+    }
+}
+
 SpectrumValue::SpectrumValue ()
 {
 }
 
 SpectrumValue::SpectrumValue (Ptr<const SpectrumModel> sof)
-  : m_spectrumModel (sof),
-    m_values (sof->GetNumBands ())
+  : m_spectrumModel (sof)
+{
+  if (AllocateValues (sof->GetNumBands (), m_values))
+    {
+      std::fill (m_values.begin (), m_values.end (), 0.0);
+    }
+  else
+    {
+      m_values.resize (sof->GetNumBands ());
+    }
+}
+
+SpectrumValue::SpectrumValue (const SpectrumValue& other)
+  : m_spectrumModel (other.m_spectrumModel)
 {
+  if (AllocateValues (other.m_values.size (), m_values))
+    {
+      std::copy (other.m_values.begin (), other.m_values.end (), m_values.begin ());
+    }
+  else
+    {
+      m_values = other.m_values;
+    }
+}
 
+SpectrumValue::SpectrumValue (SpectrumValue&& other)
+  : m_spectrumModel (other.m_spectrumModel)
+{
+  m_values.swap (other.m_values);
+}
+
+SpectrumValue::~SpectrumValue ()
+{
+  ReleaseValues (m_values);
+}
+
+SpectrumValue&
+SpectrumValue::operator= (const SpectrumValue& other)
+{
+  m_spectrumModel = other.m_spectrumModel;
+  m_values = other.m_values;
+  return *this;
+}
+
+SpectrumValue&
+SpectrumValue::operator= (SpectrumValue&& other)
+{
+  // the previous values are released with other
+  m_spectrumModel = other.m_spectrumModel;
+  m_values.swap (other.m_values);
+  return *this;
 }
 
 double&
@@ -106,17 +234,15 @@ SpectrumValue::ConstBandsEnd () const
 void
 SpectrumValue::Add (const SpectrumValue& x)
 {
-  Values::iterator it1 = m_values.begin ();
-  Values::const_iterator it2 = x.m_values.begin ();
-
   NS_ASSERT (m_spectrumModel == x.m_spectrumModel);
+  NS_ASSERT (x.m_values.size () >= m_values.size ());
 
-  while (it1 != m_values.end ())
+  // contiguous loop, which the compiler can vectorize
+  double *values = m_values.data ();
+  const double *other = x.m_values.data ();
+  for (size_t i = 0; i < m_values.size (); ++i)
     {
-      NS_ASSERT ( it2 != x.m_values.end ());
-      *it1 += *it2;
-      ++it1;
-      ++it2;
+      values[i] = values[i] + other[i];
     }
 }
 
@@ -124,12 +250,10 @@ SpectrumValue::Add (const SpectrumValue& x)
 void
 SpectrumValue::Add (double s)
 {
-  Values::iterator it1 = m_values.begin ();
-
-  while (it1 != m_values.end ())
+  double *values = m_values.data ();
+  for (size_t i = 0; i < m_values.size (); ++i)
     {
-      *it1 += s;
-      ++it1;
+      values[i] += s;
     }
 }
 
@@ -138,17 +262,15 @@ SpectrumValue::Add (double s)
 void
 SpectrumValue::Subtract (const SpectrumValue& x)
 {
-  Values::iterator it1 = m_values.begin ();
-  Values::const_iterator it2 = x.m_values.begin ();
-
   NS_ASSERT (m_spectrumModel == x.m_spectrumModel);
+  NS_ASSERT (x.m_values.size () >= m_values.size ());
 
-  while (it1 != m_values.end ())
+  // contiguous loop, which the compiler can vectorize
+  double *values = m_values.data ();
+  const double *other = x.m_values.data ();
+  for (size_t i = 0; i < m_values.size (); ++i)
     {
-      NS_ASSERT ( it2 != x.m_values.end ());
-      *it1 -= *it2;
-      ++it1;
-      ++it2;
+      values[i] = values[i] - other[i];
     }
 }
 
@@ -164,17 +286,15 @@ SpectrumValue::Subtract (double s)
 void
 SpectrumValue::Multiply (const SpectrumValue& x)
 {
-  Values::iterator it1 = m_values.begin ();
-  Values::const_iterator it2 = x.m_values.begin ();
-
   NS_ASSERT (m_spectrumModel == x.m_spectrumModel);
+  NS_ASSERT (x.m_values.size () >= m_values.size ());
 
-  while (it1 != m_values.end ())
+  // contiguous loop, which the compiler can vectorize
+  double *values = m_values.data ();
+  const double *other = x.m_values.data ();
+  for (size_t i = 0; i < m_values.size (); ++i)
     {
-      NS_ASSERT ( it2 != x.m_values.end ());
-      *it1 *= *it2;
-      ++it1;
-      ++it2;
+      values[i] = values[i] * other[i];
     }
 }
 
@@ -182,12 +302,10 @@ SpectrumValue::Multiply (const SpectrumValue& x)
 void
 SpectrumValue::Multiply (double s)
 {
-  Values::iterator it1 = m_values.begin ();
-
-  while (it1 != m_values.end ())
+  double *values = m_values.data ();
+  for (size_t i = 0; i < m_values.size (); ++i)
     {
-      *it1 *= s;
-      ++it1;
+      values[i] *= s;
     }
 }
 
@@ -197,17 +315,15 @@ SpectrumValue::Multiply (double s)
 void
 SpectrumValue::Divide (const SpectrumValue& x)
 {
-  Values::iterator it1 = m_values.begin ();
-  Values::const_iterator it2 = x.m_values.begin ();
-
   NS_ASSERT (m_spectrumModel == x.m_spectrumModel);
+  NS_ASSERT (x.m_values.size () >= m_values.size ());
 
-  while (it1 != m_values.end ())
+  // contiguous loop, which the compiler can vectorize
+  double *values = m_values.data ();
+  const double *other = x.m_values.data ();
+  for (size_t i = 0; i < m_values.size (); ++i)
     {
-      NS_ASSERT ( it2 != x.m_values.end ());
-      *it1 /= *it2;
-      ++it1;
-      ++it2;
+      values[i] = values[i] / other[i];
     }
 }
 
@@ -216,16 +332,46 @@ void
 SpectrumValue::Divide (double s)
 {
   NS_LOG_FUNCTION (this << s);
-  Values::iterator it1 = m_values.begin ();
+  double *values = m_values.data ();
+  for (size_t i = 0; i < m_values.size (); ++i)
+    {
+      values[i] /= s;
+    }
+}
 
-  while (it1 != m_values.end ())
+
+
+
+void
+SpectrumValue::SubtractFrom (const SpectrumValue& x)
+{
+  NS_ASSERT (m_spectrumModel == x.m_spectrumModel);
+  NS_ASSERT (x.m_values.size () >= m_values.size ());
+
+  // contiguous loop, which the compiler can vectorize
+  double *values = m_values.data ();
+  const double *other = x.m_values.data ();
+  for (size_t i = 0; i < m_values.size (); ++i)
     {
-      *it1 /= s;
-      ++it1;
+      values[i] = other[i] - values[i];
     }
 }
 
 
+void
+SpectrumValue::DivideInto (const SpectrumValue& x)
+{
+  NS_ASSERT (m_spectrumModel == x.m_spectrumModel);
+  NS_ASSERT (x.m_values.size () >= m_values.size ());
+
+  // contiguous loop, which the compiler can vectorize
+  double *values = m_values.data ();
+  const double *other = x.m_values.data ();
+  for (size_t i = 0; i < m_values.size (); ++i)
+    {
+      values[i] = other[i] / values[i];
+    }
+}
 
 
 void
@@ -603,6 +749,188 @@ Log (const SpectrumValue& arg)
   return res;
 }
 
+SpectrumValue
+operator+ (SpectrumValue&& lhs, const SpectrumValue& rhs)
+{
+  lhs.Add (rhs);
+  return std::move (lhs);
+}
+
+SpectrumValue
+operator+ (const SpectrumValue& lhs, SpectrumValue&& rhs)
+{
+  rhs.Add (lhs);
+  return std::move (rhs);
+}
+
+SpectrumValue
+operator+ (SpectrumValue&& lhs, SpectrumValue&& rhs)
+{
+  lhs.Add (rhs);
+  return std::move (lhs);
+}
+
+SpectrumValue
+operator+ (SpectrumValue&& lhs, double rhs)
+{
+  lhs.Add (rhs);
+  return std::move (lhs);
+}
+
+SpectrumValue
+operator+ (double lhs, SpectrumValue&& rhs)
+{
+  rhs.Add (lhs);
+  return std::move (rhs);
+}
+
+SpectrumValue
+operator- (SpectrumValue&& lhs, const SpectrumValue& rhs)
+{
+  lhs.Subtract (rhs);
+  return std::move (lhs);
+}
+
+SpectrumValue
+operator- (const SpectrumValue& lhs, SpectrumValue&& rhs)
+{
+  rhs.SubtractFrom (lhs);
+  return std::move (rhs);
+}
+
+SpectrumValue
+operator- (SpectrumValue&& lhs, SpectrumValue&& rhs)
+{
+  lhs.Subtract (rhs);
+  return std::move (lhs);
+}
+
+SpectrumValue
+operator- (SpectrumValue&& lhs, double rhs)
+{
+  lhs.Subtract (rhs);
+  return std::move (lhs);
+}
+
+SpectrumValue
+operator- (double lhs, SpectrumValue&& rhs)
+{
+  rhs.Subtract (lhs);
+  return std::move (rhs);
+}
+
+SpectrumValue
+operator* (SpectrumValue&& lhs, const SpectrumValue& rhs)
+{
+  lhs.Multiply (rhs);
+  return std::move (lhs);
+}
+
+SpectrumValue
+operator* (const SpectrumValue& lhs, SpectrumValue&& rhs)
+{
+  rhs.Multiply (lhs);
+  return std::move (rhs);
+}
+
+SpectrumValue
+operator* (SpectrumValue&& lhs, SpectrumValue&& rhs)
+{
+  lhs.Multiply (rhs);
+  return std::move (lhs);
+}
+
+SpectrumValue
+operator* (SpectrumValue&& lhs, double rhs)
+{
+  lhs.Multiply (rhs);
+  return std::move (lhs);
+}
+
+SpectrumValue
+operator* (double lhs, SpectrumValue&& rhs)
+{
+  rhs.Multiply (lhs);
+  return std::move (rhs);
+}
+
+SpectrumValue
+operator/ (SpectrumValue&& lhs, const SpectrumValue& rhs)
+{
+  lhs.Divide (rhs);
+  return std::move (lhs);
+}
+
+SpectrumValue
+operator/ (const SpectrumValue& lhs, SpectrumValue&& rhs)
+{
+  rhs.DivideInto (lhs);
+  return std::move (rhs);
+}
+
+SpectrumValue
+operator/ (SpectrumValue&& lhs, SpectrumValue&& rhs)
+{
+  lhs.Divide (rhs);
+  return std::move (lhs);
+}
+
+SpectrumValue
+operator/ (SpectrumValue&& lhs, double rhs)
+{
+  lhs.Divide (rhs);
+  return std::move (lhs);
+}
+
+SpectrumValue
+operator/ (double lhs, SpectrumValue&& rhs)
+{
+  rhs.Divide (lhs);
+  return std::move (rhs);
+}
+
+SpectrumValue
+operator- (SpectrumValue&& rhs)
+{
+  rhs.ChangeSign ();
+  return std::move (rhs);
+}
+
+SpectrumValue
+Pow (double lhs, SpectrumValue&& rhs)
+{
+  rhs.Exp (lhs);
+  return std::move (rhs);
+}
+
+SpectrumValue
+Pow (SpectrumValue&& lhs, double rhs)
+{
+  lhs.Pow (rhs);
+  return std::move (lhs);
+}
+
+SpectrumValue
+Log10 (SpectrumValue&& arg)
+{
+  arg.Log10 ();
+  return std::move (arg);
+}
+
+SpectrumValue
+Log2 (SpectrumValue&& arg)
+{
+  arg.Log2 ();
+  return std::move (arg);
+}
+
+SpectrumValue
+Log (SpectrumValue&& arg)
+{
+  arg.Log ();
+  return std::move (arg);
+}
+
 SpectrumValue&
 SpectrumValue::operator+= (const SpectrumValue& rhs)
 {
@@ -80,6 +80,45 @@ public:
 
   SpectrumValue ();
 
+  /**
+   * Copy constructor, which takes the storage of the values from the free
+   * list of value buffers when possible
+   *
+   * @param other the SpectrumValue to copy
+   */
+  SpectrumValue (const SpectrumValue& other);
+
+  /**
+   * Move constructor
+   *
+   * @param other the SpectrumValue whose values are moved
+   */
+  SpectrumValue (SpectrumValue&& other);
+
+  /**
+   * Destructor, which returns the storage of the values to the free list
+   * of value buffers
+   */
+  ~SpectrumValue ();
+
+  /**
+   * Copy assignment operator
+   *
+   * @param other the SpectrumValue to copy
+   *
+   * @return a reference to this SpectrumValue
+   */
+  SpectrumValue& operator= (const SpectrumValue& other);
+
+  /**
+   * Move assignment operator
+   *
+   * @param other the SpectrumValue whose values are moved
+   *
+   * @return a reference to this SpectrumValue
+   */
+  SpectrumValue& operator= (SpectrumValue&& other);
+
 
   /**
    * Access value at given frequency index
@@ -297,6 +336,271 @@ public:
    */
   friend SpectrumValue operator- (const SpectrumValue& rhs);
 
+  /*
+   * The following operators and functions take a temporary SpectrumValue
+   * as an operand, and store their result in the values of this operand
+   * rather than in a newly allocated SpectrumValue, so that an expression
+   * such as a / (b - a + c) allocates the values of a single SpectrumValue.
+   * Their results are identical to the ones of the operators and functions
+   * above.
+   */
+
+  /**
+   * addition operator, reusing the values of a temporary operand
+   *
+   * @param lhs Left Hand Side of the operator
+   * @param rhs Right Hand Side of the operator
+   *
+   * @return the result of the operation
+   */
+  friend SpectrumValue operator+ (SpectrumValue&& lhs, const SpectrumValue& rhs);
+
+  /**
+   * addition operator, reusing the values of a temporary operand
+   *
+   * @param lhs Left Hand Side of the operator
+   * @param rhs Right Hand Side of the operator
+   *
+   * @return the result of the operation
+   */
+  friend SpectrumValue operator+ (const SpectrumValue& lhs, SpectrumValue&& rhs);
+
+  /**
+   * addition operator, reusing the values of a temporary operand
+   *
+   * @param lhs Left Hand Side of the operator
+   * @param rhs Right Hand Side of the operator
+   *
+   * @return the result of the operation
+   */
+  friend SpectrumValue operator+ (SpectrumValue&& lhs, SpectrumValue&& rhs);
+
+  /**
+   * addition operator, reusing the values of a temporary operand
+   *
+   * @param lhs Left Hand Side of the operator
+   * @param rhs Right Hand Side of the operator
+   *
+   * @return the result of the operation
+   */
+  friend SpectrumValue operator+ (SpectrumValue&& lhs, double rhs);
+
+  /**
+   * addition operator, reusing the values of a temporary operand
+   *
+   * @param lhs Left Hand Side of the operator
+   * @param rhs Right Hand Side of the operator
+   *
+   * @return the result of the operation
+   */
+  friend SpectrumValue operator+ (double lhs, SpectrumValue&& rhs);
+
+  /**
+   * subtraction operator, reusing the values of a temporary operand
+   *
+   * @param lhs Left Hand Side of the operator
+   * @param rhs Right Hand Side of the operator
+   *
+   * @return the result of the operation
+   */
+  friend SpectrumValue operator- (SpectrumValue&& lhs, const SpectrumValue& rhs);
+
+  /**
+   * subtraction operator, reusing the values of a temporary operand
+   *
+   * @param lhs Left Hand Side of the operator
+   * @param rhs Right Hand Side of the operator
+   *
+   * @return the result of the operation
+   */
+  friend SpectrumValue operator- (const SpectrumValue& lhs, SpectrumValue&& rhs);
+
+  /**
+   * subtraction operator, reusing the values of a temporary operand
+   *
+   * @param lhs Left Hand Side of the operator
+   * @param rhs Right Hand Side of the operator
+   *
+   * @return the result of the operation
+   */
+  friend SpectrumValue operator- (SpectrumValue&& lhs, SpectrumValue&& rhs);
+
+  /**
+   * subtraction operator, reusing the values of a temporary operand
+   *
+   * @param lhs Left Hand Side of the operator
+   * @param rhs Right Hand Side of the operator
+   *
+   * @return the result of the operation
+   */
+  friend SpectrumValue operator- (SpectrumValue&& lhs, double rhs);
+
+  /**
+   * subtraction operator, reusing the values of a temporary operand
+   *
+   * @param lhs Left Hand Side of the operator
+   * @param rhs Right Hand Side of the operator
+   *
+   * @return the result of the operation
+   */
+  friend SpectrumValue operator- (double lhs, SpectrumValue&& rhs);
+
+  /**
+   * multiplication operator, reusing the values of a temporary operand
+   *
+   * @param lhs Left Hand Side of the operator
+   * @param rhs Right Hand Side of the operator
+   *
+   * @return the result of the operation
+   */
+  friend SpectrumValue operator* (SpectrumValue&& lhs, const SpectrumValue& rhs);
+
+  /**
+   * multiplication operator, reusing the values of a temporary operand
+   *
+   * @param lhs Left Hand Side of the operator
+   * @param rhs Right Hand Side of the operator
+   *
+   * @return the result of the operation
+   */
+  friend SpectrumValue operator* (const SpectrumValue& lhs, SpectrumValue&& rhs);
+
+  /**
+   * multiplication operator, reusing the values of a temporary operand
+   *
+   * @param lhs Left Hand Side of the operator
+   * @param rhs Right Hand Side of the operator
+   *
+   * @return the result of the operation
+   */
+  friend SpectrumValue operator* (SpectrumValue&& lhs, SpectrumValue&& rhs);
+
+  /**
+   * multiplication operator, reusing the values of a temporary operand
+   *
+   * @param lhs Left Hand Side of the operator
+   * @param rhs Right Hand Side of the operator
+   *
+   * @return the result of the operation
+   */
+  friend SpectrumValue operator* (SpectrumValue&& lhs, double rhs);
+
+  /**
+   * multiplication operator, reusing the values of a temporary operand
+   *
+   * @param lhs Left Hand Side of the operator
+   * @param rhs Right Hand Side of the operator
+   *
+   * @return the result of the operation
+   */
+  friend SpectrumValue operator* (double lhs, SpectrumValue&& rhs);
+
+  /**
+   * division operator, reusing the values of a temporary operand
+   *
+   * @param lhs Left Hand Side of the operator
+   * @param rhs Right Hand Side of the operator
+   *
+   * @return the result of the operation
+   */
+  friend SpectrumValue operator/ (SpectrumValue&& lhs, const SpectrumValue& rhs);
+
+  /**
+   * division operator, reusing the values of a temporary operand
+   *
+   * @param lhs Left Hand Side of the operator
+   * @param rhs Right Hand Side of the operator
+   *
+   * @return the result of the operation
+   */
+  friend SpectrumValue operator/ (const SpectrumValue& lhs, SpectrumValue&& rhs);
+
+  /**
+   * division operator, reusing the values of a temporary operand
+   *
+   * @param lhs Left Hand Side of the operator
+   * @param rhs Right Hand Side of the operator
+   *
+   * @return the result of the operation
+   */
+  friend SpectrumValue operator/ (SpectrumValue&& lhs, SpectrumValue&& rhs);
+
+  /**
+   * division operator, reusing the values of a temporary operand
+   *
+   * @param lhs Left Hand Side of the operator
+   * @param rhs Right Hand Side of the operator
+   *
+   * @return the result of the operation
+   */
+  friend SpectrumValue operator/ (SpectrumValue&& lhs, double rhs);
+
+  /**
+   * division operator, reusing the values of a temporary operand
+   *
+   * @param lhs Left Hand Side of the operator
+   * @param rhs Right Hand Side of the operator
+   *
+   * @return the result of the operation
+   */
+  friend SpectrumValue operator/ (double lhs, SpectrumValue&& rhs);
+
+  /**
+   * unary minus operator, reusing the values of a temporary operand
+   *
+   * @param rhs Right Hand Side of the operator
+   *
+   * @return the value of - rhs
+   */
+  friend SpectrumValue operator- (SpectrumValue&& rhs);
+
+  /**
+   * Pow function, reusing the values of a temporary operand
+   *
+   * @param lhs the base
+   * @param rhs the exponent
+   *
+   * @return the value in base raised to each value in the exponent
+   */
+  friend SpectrumValue Pow (double lhs, SpectrumValue&& rhs);
+
+  /**
+   * Pow function, reusing the values of a temporary operand
+   *
+   * @param lhs the base
+   * @param rhs the exponent
+   *
+   * @return the value in base raised to the exponent
+   */
+  friend SpectrumValue Pow (SpectrumValue&& lhs, double rhs);
+
+  /**
+   * Log10 function, reusing the values of a temporary operand
+   *
+   * @param arg the argument
+   *
+   * @return the logarithm in base 10 of all values in the argument
+   */
+  friend SpectrumValue Log10 (SpectrumValue&& arg);
+
+  /**
+   * Log2 function, reusing the values of a temporary operand
+   *
+   * @param arg the argument
+   *
+   * @return the logarithm in base 2 of all values in the argument
+   */
+  friend SpectrumValue Log2 (SpectrumValue&& arg);
+
+  /**
+   * Log function, reusing the values of a temporary operand
+   *
+   * @param arg the argument
+   *
+   * @return the logarithm in base e of all values in the argument
+   */
+  friend SpectrumValue Log (SpectrumValue&& arg);
+
 
   /**
    * left shift operator
@@ -555,6 +859,16 @@ private:
    * \param s flat value
    */
   void Divide (double s);
+  /**
+   * Subtracts the current elements from a SpectrumValue (element by element)
+   * \param x SpectrumValue
+   */
+  void SubtractFrom (const SpectrumValue& x);
+  /**
+   * Divides a SpectrumValue by the current elements (element by element)
+   * \param x SpectrumValue
+   */
+  void DivideInto (const SpectrumValue& x);
   /**
    * Change the values sign
    */
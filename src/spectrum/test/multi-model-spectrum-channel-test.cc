@@ -0,0 +1,247 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <ns3/simulator.h>
+#include <ns3/double.h>
+#include <ns3/test.h>
+#include <ns3/node.h>
+#include <ns3/simple-net-device.h>
+#include <ns3/constant-position-mobility-model.h>
+#include <ns3/friis-spectrum-propagation-loss.h>
+#include <ns3/propagation-loss-model.h>
+#include <ns3/multi-model-spectrum-channel.h>
+#include <ns3/spectrum-phy.h>
+#include <ns3/spectrum-signal-parameters.h>
+#include <ns3/antenna-model.h>
+
+using namespace ns3;
+
+/**
+ * \ingroup spectrum-tests
+ *
+ * \brief SpectrumPhy counting the signals it receives
+ */
+class MultiModelTestPhy : public SpectrumPhy
+{
+public:
+  /**
+   * Constructor
+   * \param rxSpectrumModel the Rx SpectrumModel
+   */
+  MultiModelTestPhy (Ptr<const SpectrumModel> rxSpectrumModel)
+    : m_rxSpectrumModel (rxSpectrumModel),
+      m_nRx (0)
+  {
+  }
+
+  virtual void SetDevice (Ptr<NetDevice> d)
+  {
+    m_device = d;
+  }
+  virtual Ptr<NetDevice> GetDevice () const
+  {
+    return m_device;
+  }
+  virtual void SetMobility (Ptr<MobilityModel> m)
+  {
+    m_mobility = m;
+  }
+  virtual Ptr<MobilityModel> GetMobility ()
+  {
+    return m_mobility;
+  }
+  virtual void SetChannel (Ptr<SpectrumChannel> c)
+  {
+  }
+  virtual Ptr<const SpectrumModel> GetRxSpectrumModel () const
+  {
+    return m_rxSpectrumModel;
+  }
+  virtual Ptr<AntennaModel> GetRxAntenna ()
+  {
+    return 0;
+  }
+  virtual void StartRx (Ptr<SpectrumSignalParameters> params)
+  {
+    m_nRx++;
+  }
+
+  Ptr<const SpectrumModel> m_rxSpectrumModel; //!< the Rx SpectrumModel
+  Ptr<NetDevice> m_device;                    //!< the device
+  Ptr<MobilityModel> m_mobility;              //!< the mobility model
+  uint32_t m_nRx;                             //!< number of received signals
+
+protected:
+  virtual void DoDispose ()
+  {
+    m_device = 0;
+    m_mobility = 0;
+    SpectrumPhy::DoDispose ();
+  }
+};
+
+/**
+ * \ingroup spectrum-tests
+ *
+ * \brief MultiModelSpectrumChannel receivers test
+ *
+ * Check that the devices of a MultiModelSpectrumChannel are listed in the
+ * order in which their PHYs were first added, including when a PHY changes
+ * its SpectrumModel, and that the signals are delivered to the receivers
+ * of every non-orthogonal SpectrumModel within MaxRange only.
+ */
+class MultiModelSpectrumChannelTestCase : public TestCase
+{
+public:
+  MultiModelSpectrumChannelTestCase ();
+  virtual ~MultiModelSpectrumChannelTestCase ();
+
+private:
+  virtual void DoRun (void);
+  /**
+   * Create a PHY attached to a new device and node at the given position
+   * \param model the Rx SpectrumModel
+   * \param x the x-coordinate (m)
+   * \return the PHY
+   */
+  Ptr<MultiModelTestPhy> CreatePhy (Ptr<const SpectrumModel> model, double x);
+  /**
+   * Transmit a signal from the given PHY
+   * \param phy the transmitting PHY
+   * \param model the SpectrumModel of the transmitted PSD
+   */
+  void Send (Ptr<MultiModelTestPhy> phy, Ptr<const SpectrumModel> model);
+
+  Ptr<MultiModelSpectrumChannel> m_channel; //!< the channel
+};
+
+MultiModelSpectrumChannelTestCase::MultiModelSpectrumChannelTestCase ()
+  : TestCase ("Check the receivers of MultiModelSpectrumChannel")
+{
+}
+
+MultiModelSpectrumChannelTestCase::~MultiModelSpectrumChannelTestCase ()
+{
+}
+
+Ptr<MultiModelTestPhy>
+MultiModelSpectrumChannelTestCase::CreatePhy (Ptr<const SpectrumModel> model, double x)
+{
+  Ptr<Node> node = CreateObject<Node> ();
+  Ptr<SimpleNetDevice> device = CreateObject<SimpleNetDevice> ();
+  node->AddDevice (device);
+  Ptr<MobilityModel> mobility = CreateObject<ConstantPositionMobilityModel> ();
+  mobility->SetPosition (Vector (x, 0, 0));
+  Ptr<MultiModelTestPhy> phy = Create<MultiModelTestPhy> (model);
+  phy->SetDevice (device);
+  phy->SetMobility (mobility);
+  m_channel->AddRx (phy);
+  return phy;
+}
+
+void
+MultiModelSpectrumChannelTestCase::Send (Ptr<MultiModelTestPhy> phy, Ptr<const SpectrumModel> model)
+{
+  Ptr<SpectrumSignalParameters> params = Create<SpectrumSignalParameters> ();
+  params->duration = MicroSeconds (100);
+  params->txPhy = phy;
+  params->psd = Create<SpectrumValue> (model);
+  (*params->psd) = 1e-9;
+  m_channel->StartTx (params);
+  Simulator::Run ();
+}
+
+void
+MultiModelSpectrumChannelTestCase::DoRun (void)
+{
+  std::vector<double> f1;
+  f1.push_back (1.0e9);
+  f1.push_back (2.0e9);
+  f1.push_back (3.0e9);
+  Ptr<SpectrumModel> model1 = Create<SpectrumModel> (f1);
+  std::vector<double> f2;
+  f2.push_back (1.5e9);
+  f2.push_back (2.5e9);
+  Ptr<SpectrumModel> model2 = Create<SpectrumModel> (f2);
+  std::vector<double> f3;
+  f3.push_back (5.0e9);
+  f3.push_back (6.0e9);
+  Ptr<SpectrumModel> model3 = Create<SpectrumModel> (f3);
+
+  m_channel = CreateObject<MultiModelSpectrumChannel> ();
+  m_channel->AddPropagationLossModel (CreateObject<FriisPropagationLossModel> ());
+  m_channel->AddSpectrumPropagationLossModel (CreateObject<FriisSpectrumPropagationLossModel> ());
+
+  std::vector<Ptr<MultiModelTestPhy> > phys;
+  phys.push_back (CreatePhy (model1, 0));
+  phys.push_back (CreatePhy (model2, 10));
+  phys.push_back (CreatePhy (model1, 20));
+  phys.push_back (CreatePhy (model3, 30));
+  phys.push_back (CreatePhy (model2, 40));
+
+  // a PHY switching to another SpectrumModel keeps its device index
+  phys[2]->m_rxSpectrumModel = model2;
+  m_channel->AddRx (phys[2]);
+  NS_TEST_ASSERT_MSG_EQ (m_channel->GetNDevices (), phys.size (), "Unexpected number of devices");
+  for (std::size_t i = 0; i < phys.size (); i++)
+    {
+      NS_TEST_EXPECT_MSG_EQ (m_channel->GetDevice (i), phys[i]->GetDevice (), "Unexpected device " << i);
+    }
+
+  // the receivers of the SpectrumModels overlapping model1 get the signal
+  Send (phys[0], model1);
+  uint32_t expected[] = {0, 1, 1, 0, 1};
+  for (std::size_t i = 0; i < phys.size (); i++)
+    {
+      NS_TEST_EXPECT_MSG_EQ (phys[i]->m_nRx, expected[i], "Unexpected number of signals received by PHY " << i);
+    }
+
+  // unless they are beyond MaxRange
+  m_channel->SetAttribute ("MaxRange", DoubleValue (25));
+  Send (phys[0], model1);
+  uint32_t expectedInRange[] = {0, 2, 2, 0, 1};
+  for (std::size_t i = 0; i < phys.size (); i++)
+    {
+      NS_TEST_EXPECT_MSG_EQ (phys[i]->m_nRx, expectedInRange[i], "Unexpected number of signals received by PHY " << i << " with MaxRange");
+    }
+
+  Simulator::Destroy ();
+  m_channel->Dispose ();
+  m_channel = 0;
+  for (std::size_t i = 0; i < phys.size (); i++)
+    {
+      phys[i]->Dispose ();
+    }
+}
+
+/**
+ * \ingroup spectrum-tests
+ *
+ * \brief MultiModelSpectrumChannel Test Suite
+ */
+class MultiModelSpectrumChannelTestSuite : public TestSuite
+{
+public:
+  MultiModelSpectrumChannelTestSuite ();
+};
+
+MultiModelSpectrumChannelTestSuite::MultiModelSpectrumChannelTestSuite ()
+  : TestSuite ("multi-model-spectrum-channel", UNIT)
+{
+  AddTestCase (new MultiModelSpectrumChannelTestCase, TestCase::QUICK);
+}
+
+static MultiModelSpectrumChannelTestSuite g_multiModelSpectrumChannelTestSuite; //!< the test suite
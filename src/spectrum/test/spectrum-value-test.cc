@@ -77,6 +77,117 @@ SpectrumValueTestCase::DoRun (void)
 
 
 
+/**
+ * Check that the operators which reuse the values of a temporary operand
+ * give exactly the same results as the operators on named operands, and
+ * that the values of a new SpectrumValue are zero when their storage is
+ * reused from a destroyed SpectrumValue.
+ */
+class SpectrumValueTemporaryTestCase : public TestCase
+{
+public:
+  SpectrumValueTemporaryTestCase ();
+  virtual ~SpectrumValueTemporaryTestCase ();
+  virtual void DoRun (void);
+
+private:
+  /**
+   * Check that two SpectrumValues are identical
+   * \param x the value computed with temporary operands
+   * \param y the value computed with named operands
+   * \param name the name of the expression
+   */
+  void CheckIdentical (const SpectrumValue& x, const SpectrumValue& y, std::string name);
+};
+
+SpectrumValueTemporaryTestCase::SpectrumValueTemporaryTestCase ()
+  : TestCase ("SpectrumValue operators with temporary operands")
+{
+}
+
+SpectrumValueTemporaryTestCase::~SpectrumValueTemporaryTestCase ()
+{
+}
+
+void
+SpectrumValueTemporaryTestCase::CheckIdentical (const SpectrumValue& x, const SpectrumValue& y, std::string name)
+{
+  NS_TEST_ASSERT_MSG_EQ (x.GetSpectrumModelUid (), y.GetSpectrumModelUid (), name);
+  for (size_t i = 0; i < y.GetSpectrumModel ()->GetNumBands (); i++)
+    {
+      NS_TEST_EXPECT_MSG_EQ (x[i], y[i], name << " differs at index " << i);
+    }
+}
+
+void
+SpectrumValueTemporaryTestCase::DoRun (void)
+{
+  std::vector<double> freqs;
+  for (int i = 1; i <= 5; i++)
+    {
+      freqs.push_back (i);
+    }
+  Ptr<SpectrumModel> f = Create<SpectrumModel> (freqs);
+
+  SpectrumValue v1 (f), v2 (f), v3 (f);
+  for (size_t i = 0; i < 5; i++)
+    {
+      v1[i] = 0.3 + 0.7 * i;
+      v2[i] = 1.1 / (i + 1);
+      v3[i] = 2.9 - 0.45 * i;
+    }
+
+  // interference-like expression, with (const&, &&), (&&, const&) operands
+  SpectrumValue t1 = v2 - v1;
+  SpectrumValue t2 = t1 + v3;
+  CheckIdentical (v1 / (v2 - v1 + v3), v1 / t2, "v1 / (v2 - v1 + v3)");
+
+  // (&&, &&) and (&&, double) operands
+  SpectrumValue t3 = v1 * 2.0;
+  SpectrumValue t4 = t3 + v2;
+  SpectrumValue t5 = v3 - 1.5;
+  SpectrumValue t6 = t4 * t5;
+  SpectrumValue t7 = v2 * v2;
+  CheckIdentical ((v1 * 2.0 + v2) * (v3 - 1.5) / (v2 * v2), t6 / t7, "(v1 * 2 + v2) * (v3 - 1.5) / (v2 * v2)");
+
+  // (const&, &&) operands of each operator
+  SpectrumValue t8 = v2 * v3;
+  CheckIdentical (v1 + (v2 * v3), v1 + t8, "v1 + (v2 * v3)");
+  CheckIdentical (v1 - (v2 * v3), v1 - t8, "v1 - (v2 * v3)");
+  CheckIdentical (v1 * (v2 * v3), v1 * t8, "v1 * (v2 * v3)");
+  CheckIdentical (v1 / (v2 * v3), v1 / t8, "v1 / (v2 * v3)");
+
+  // (double, &&) operands of each operator
+  SpectrumValue t9 = v1 + v2;
+  CheckIdentical ((v1 + v2) - (v2 * v3), t9 - t8, "(v1 + v2) - (v2 * v3)");
+  CheckIdentical ((v1 + v2) / (v2 * v3), t9 / t8, "(v1 + v2) / (v2 * v3)");
+  CheckIdentical (3.0 + (v1 + v2), 3.0 + t9, "3 + (v1 + v2)");
+  CheckIdentical (3.0 - (v1 + v2), 3.0 - t9, "3 - (v1 + v2)");
+  CheckIdentical (3.0 * (v1 + v2), 3.0 * t9, "3 * (v1 + v2)");
+  CheckIdentical (3.0 / (v1 + v2), 3.0 / t9, "3 / (v1 + v2)");
+
+  // unary minus and functions
+  CheckIdentical (-(v1 + v2), -t9, "-(v1 + v2)");
+  CheckIdentical (Pow (v1 + v2, 0.5), Pow (t9, 0.5), "Pow (v1 + v2, 0.5)");
+  CheckIdentical (Pow (10.0, v1 + v2), Pow (10.0, t9), "Pow (10, v1 + v2)");
+  CheckIdentical (Log10 (v1 + v2), Log10 (t9), "Log10 (v1 + v2)");
+  CheckIdentical (Log2 (v1 + v2), Log2 (t9), "Log2 (v1 + v2)");
+  CheckIdentical (Log (v1 + v2), Log (t9), "Log (v1 + v2)");
+
+  // the storage of destroyed values is reused, and must be reset
+  for (int i = 0; i < 3; i++)
+    {
+      SpectrumValue used = v1 + v2;
+      SpectrumValue unused (f);
+      for (size_t j = 0; j < 5; j++)
+        {
+          NS_TEST_EXPECT_MSG_EQ (unused[j], 0.0, "The values of a new SpectrumValue should be zero");
+        }
+    }
+}
+
+
+
 
 
 
@@ -241,6 +352,8 @@ SpectrumValueTestSuite::SpectrumValueTestSuite ()
   tv1rs3 = v1 >> 3;
   AddTestCase (new SpectrumValueTestCase (tv1rs3, v1rs3, "tv1rs3 = v1 >> 3"), TestCase::QUICK);
 
+  AddTestCase (new SpectrumValueTemporaryTestCase, TestCase::QUICK);
+
 
 }
 
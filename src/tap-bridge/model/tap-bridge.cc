@@ -20,6 +20,7 @@
 #include "tap-encode-decode.h"
 
 #include "ns3/node.h"
+#include "ns3/node-list.h"
 #include "ns3/channel.h"
 #include "ns3/packet.h"
 #include "ns3/ethernet-header.h"
@@ -1024,6 +1025,7 @@ TapBridge::SetAddress (Address address)
 {
   NS_LOG_FUNCTION (address);
   m_address = Mac48Address::ConvertFrom (address);
+  NodeList::NotifyAddressChange (this);
 }
 
 Address 
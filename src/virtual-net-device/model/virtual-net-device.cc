@@ -27,6 +27,7 @@
 #include "ns3/channel.h"
 #include "ns3/trace-source-accessor.h"
 #include "ns3/uinteger.h"
+#include "ns3/node-list.h"
 
 
 namespace ns3 {
@@ -196,6 +197,7 @@ void
 VirtualNetDevice::SetAddress (Address addr)
 {
   m_myAddress = addr;
+  NodeList::NotifyAddressChange (this);
 }
 
 uint16_t
@@ -19,6 +19,7 @@
  */
 #include <algorithm>
 #include "ns3/node.h"
+#include "ns3/node-list.h"
 #include "ns3/wifi-phy.h"
 #include "ns3/llc-snap-header.h"
 #include "ns3/channel.h"
@@ -525,6 +526,7 @@ WaveNetDevice::SetAddress (Address address)
     {
       i->second->SetAddress (Mac48Address::ConvertFrom (address));
     }
+  NodeList::NotifyAddressChange (this);
 }
 Address
 WaveNetDevice::GetAddress (void) const
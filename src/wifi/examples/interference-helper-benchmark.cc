@@ -0,0 +1,203 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+//
+// This program measures the cost of the interference computations performed
+// by the InterferenceHelper of a single receiver in a dense BSS.
+//
+// The receiver hears --nStations stations (100 by default), each of which
+// transmits --frameSize byte frames (1500 by default) at 54 Mbps, separated
+// by exponentially distributed intervals of mean --interval (20 ms by default),
+// so that most frames overlap with other frames. The receiver locks onto a
+// frame whenever it is idle, and computes the PER of the PLCP header and of
+// the payload, exactly as WifiPhy does. No PHY, MAC or channel object is
+// involved, hence the wall clock time reported at the end of the simulation
+// is dominated by the InterferenceHelper.
+//
+// Example: ./waf --run "interference-helper-benchmark --nStations=100 --simTime=10"
+//
+
+#include <iostream>
+#include "ns3/command-line.h"
+#include "ns3/simulator.h"
+#include "ns3/packet.h"
+#include "ns3/double.h"
+#include "ns3/random-variable-stream.h"
+#include "ns3/system-wall-clock-ms.h"
+#include "ns3/interference-helper.h"
+#include "ns3/nist-error-rate-model.h"
+#include "ns3/yans-wifi-phy.h"
+#include "ns3/wifi-utils.h"
+
+using namespace ns3;
+
+/// Dense BSS interference benchmark
+class DenseBssBenchmark
+{
+public:
+  /**
+   * Constructor
+   * \param nStations the number of transmitting stations
+   * \param frameSize the size of the frames (bytes)
+   * \param interval the mean interval between two frames of a station
+   */
+  DenseBssBenchmark (uint32_t nStations, uint32_t frameSize, Time interval);
+  /**
+   * Run the benchmark
+   * \param simTime the simulation time
+   */
+  void Run (Time simTime);
+
+private:
+  /**
+   * A station transmits a frame
+   * \param station the index of the station
+   */
+  void Transmit (uint32_t station);
+  /**
+   * The receiver reaches the end of the PLCP header of the frame it locked onto
+   * \param event the frame
+   */
+  void EndPlcpHeader (Ptr<Event> event);
+  /**
+   * The receiver reaches the end of the frame it locked onto
+   * \param event the frame
+   */
+  void EndReceive (Ptr<Event> event);
+
+  uint32_t m_nStations;                     ///< number of stations
+  Ptr<Packet> m_packet;                     ///< the frame transmitted by all stations
+  WifiTxVector m_txVector;                  ///< the TXVECTOR of the frames
+  Time m_duration;                          ///< the duration of the frames
+  Ptr<ExponentialRandomVariable> m_interval; ///< interval between two frames of a station
+  Ptr<UniformRandomVariable> m_rxPower;     ///< receive power (dBm)
+  InterferenceHelper m_interference;        ///< the interference helper under test
+  bool m_rxing;                             ///< whether the receiver is locked onto a frame
+  uint64_t m_signals;                       ///< number of signals added
+  uint64_t m_receptions;                    ///< number of frames the receiver locked onto
+  uint64_t m_successes;                     ///< number of frames that would have been received
+  Ptr<UniformRandomVariable> m_random;      ///< random variable to draw the outcome of receptions
+};
+
+DenseBssBenchmark::DenseBssBenchmark (uint32_t nStations, uint32_t frameSize, Time interval)
+  : m_nStations (nStations),
+    m_rxing (false),
+    m_signals (0),
+    m_receptions (0),
+    m_successes (0)
+{
+  m_packet = Create<Packet> (frameSize);
+  m_txVector.SetMode (WifiPhy::GetOfdmRate54Mbps ());
+  m_txVector.SetPreambleType (WIFI_PREAMBLE_LONG);
+  m_txVector.SetChannelWidth (20);
+  Ptr<YansWifiPhy> phy = CreateObject<YansWifiPhy> ();
+  phy->ConfigureStandard (WIFI_PHY_STANDARD_80211a);
+  m_duration = phy->CalculateTxDuration (frameSize, m_txVector, phy->GetFrequency ());
+
+  m_interval = CreateObject<ExponentialRandomVariable> ();
+  m_interval->SetAttribute ("Mean", DoubleValue (interval.GetSeconds ()));
+  m_rxPower = CreateObject<UniformRandomVariable> ();
+  m_rxPower->SetAttribute ("Min", DoubleValue (-90));
+  m_rxPower->SetAttribute ("Max", DoubleValue (-40));
+  m_random = CreateObject<UniformRandomVariable> ();
+
+  m_interference.SetNoiseFigure (DbToRatio (7));
+  m_interference.SetErrorRateModel (CreateObject<NistErrorRateModel> ());
+}
+
+void
+DenseBssBenchmark::Run (Time simTime)
+{
+  for (uint32_t i = 0; i < m_nStations; i++)
+    {
+      Simulator::Schedule (Seconds (m_interval->GetValue ()), &DenseBssBenchmark::Transmit, this, i);
+    }
+  Simulator::Stop (simTime);
+
+  SystemWallClockMs clock;
+  clock.Start ();
+  Simulator::Run ();
+  int64_t elapsed = clock.End ();
+  Simulator::Destroy ();
+
+  std::cout << "stations=" << m_nStations
+            << " frame-duration=" << m_duration.GetMicroSeconds () << "us"
+            << " signals=" << m_signals
+            << " receptions=" << m_receptions
+            << " successes=" << m_successes
+            << " wall-clock=" << elapsed << "ms";
+  if (elapsed > 0)
+    {
+      std::cout << " signals/s=" << m_signals * 1000.0 / elapsed;
+    }
+  std::cout << std::endl;
+}
+
+void
+DenseBssBenchmark::Transmit (uint32_t station)
+{
+  m_signals++;
+  Ptr<Event> event = m_interference.Add (m_packet, m_txVector, m_duration, DbmToW (m_rxPower->GetValue ()));
+  if (!m_rxing)
+    {
+      m_rxing = true;
+      m_receptions++;
+      m_interference.NotifyRxStart ();
+      Simulator::Schedule (WifiPhy::CalculatePlcpPreambleAndHeaderDuration (m_txVector),
+                           &DenseBssBenchmark::EndPlcpHeader, this, event);
+      Simulator::Schedule (m_duration, &DenseBssBenchmark::EndReceive, this, event);
+    }
+  Simulator::Schedule (m_duration + Seconds (m_interval->GetValue ()), &DenseBssBenchmark::Transmit, this, station);
+}
+
+void
+DenseBssBenchmark::EndPlcpHeader (Ptr<Event> event)
+{
+  m_interference.CalculatePlcpHeaderSnrPer (event);
+}
+
+void
+DenseBssBenchmark::EndReceive (Ptr<Event> event)
+{
+  InterferenceHelper::SnrPer snrPer = m_interference.CalculatePlcpPayloadSnrPer (event);
+  m_interference.NotifyRxEnd ();
+  m_rxing = false;
+  if (m_random->GetValue () > snrPer.per)
+    {
+      m_successes++;
+    }
+}
+
+int
+main (int argc, char *argv[])
+{
+  uint32_t nStations = 100;
+  uint32_t frameSize = 1500;
+  double interval = 0.02;
+  double simTime = 10;
+
+  CommandLine cmd;
+  cmd.AddValue ("nStations", "Number of stations heard by the receiver", nStations);
+  cmd.AddValue ("frameSize", "Size of the frames (bytes)", frameSize);
+  cmd.AddValue ("interval", "Mean interval between two frames of a station (s)", interval);
+  cmd.AddValue ("simTime", "Simulation time (s)", simTime);
+  cmd.Parse (argc, argv);
+
+  DenseBssBenchmark benchmark (nStations, frameSize, Seconds (interval));
+  benchmark.Run (Seconds (simTime));
+
+  return 0;
+}
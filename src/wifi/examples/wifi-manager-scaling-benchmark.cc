@@ -0,0 +1,112 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+//
+// This program measures how the cost of the per-frame operations of a
+// WifiRemoteStationManager scales with the number of remote stations, e.g.,
+// for an AP with many associated stations or a mesh point with many peers.
+//
+// For 1, 10, 100, ... up to --maxStations remote stations, the manager
+// selected with --manager (ns3::ArfWifiManager by default) is asked for the
+// TXVECTOR of a data frame and is notified that the frame was acknowledged,
+// --nFrames times (100000 by default), for each remote station in turn. The
+// wall clock time per frame is reported for each number of stations.
+//
+// Example: ./waf --run "wifi-manager-scaling-benchmark --manager=ns3::MinstrelWifiManager"
+//
+
+#include <iostream>
+#include "ns3/command-line.h"
+#include "ns3/object-factory.h"
+#include "ns3/packet.h"
+#include "ns3/system-wall-clock-ms.h"
+#include "ns3/yans-wifi-phy.h"
+#include "ns3/nist-error-rate-model.h"
+#include "ns3/wifi-remote-station-manager.h"
+#include "ns3/wifi-mac-header.h"
+
+using namespace ns3;
+
+/**
+ * Run the benchmark for the given number of remote stations
+ *
+ * \param managerType the TypeId name of the remote station manager
+ * \param nStations the number of remote stations
+ * \param nFrames the number of frames
+ *
+ * \return the wall clock time (ms)
+ */
+static int64_t
+RunBenchmark (std::string managerType, uint32_t nStations, uint32_t nFrames)
+{
+  Ptr<YansWifiPhy> phy = CreateObject<YansWifiPhy> ();
+  phy->ConfigureStandard (WIFI_PHY_STANDARD_80211a);
+  phy->SetErrorRateModel (CreateObject<NistErrorRateModel> ());
+  ObjectFactory factory;
+  factory.SetTypeId (managerType);
+  Ptr<WifiRemoteStationManager> manager = factory.Create<WifiRemoteStationManager> ();
+  manager->SetupPhy (phy);
+  manager->Initialize ();
+
+  std::vector<Mac48Address> addresses;
+  for (uint32_t i = 0; i < nStations; i++)
+    {
+      addresses.push_back (Mac48Address::Allocate ());
+    }
+  WifiMacHeader hdr;
+  hdr.SetType (WIFI_MAC_DATA);
+  Ptr<Packet> packet = Create<Packet> (1000);
+
+  SystemWallClockMs clock;
+  clock.Start ();
+  for (uint32_t i = 0; i < nFrames; i++)
+    {
+      Mac48Address address = addresses[i % nStations];
+      hdr.SetAddr1 (address);
+      WifiTxVector txVector = manager->GetDataTxVector (address, &hdr, packet);
+      manager->ReportDataOk (address, &hdr, 100, txVector.GetMode (), 100, packet->GetSize ());
+    }
+  int64_t elapsed = clock.End ();
+
+  manager->Dispose ();
+  phy->Dispose ();
+  return elapsed;
+}
+
+int
+main (int argc, char *argv[])
+{
+  std::string manager = "ns3::ArfWifiManager";
+  uint32_t maxStations = 1000;
+  uint32_t nFrames = 100000;
+
+  CommandLine cmd;
+  cmd.AddValue ("manager", "TypeId name of the remote station manager", manager);
+  cmd.AddValue ("maxStations", "Maximum number of remote stations", maxStations);
+  cmd.AddValue ("nFrames", "Number of frames for each number of remote stations", nFrames);
+  cmd.Parse (argc, argv);
+
+  std::cout << manager << std::endl;
+  for (uint32_t nStations = 1; nStations <= maxStations; nStations *= 10)
+    {
+      int64_t elapsed = RunBenchmark (manager, nStations, nFrames);
+      std::cout << "stations=" << nStations
+                << " wall-clock=" << elapsed << "ms"
+                << " per-frame=" << elapsed * 1000.0 / nFrames << "us" << std::endl;
+    }
+
+  return 0;
+}
@@ -0,0 +1,492 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+//
+// This program measures how the runtime of complete wifi simulations scales
+// with the size of the network, in order to detect runtime regressions of
+// dense-BSS scenarios between two versions of the simulator.
+//
+// Each run simulates --nAps BSSs on the same channel, with APs placed on a
+// grid 30 m apart and --nStas stations per BSS placed around their AP. Every
+// AP sends --packetSize byte packets to each of its stations every
+// --interval, through packet sockets (no IP stack is involved), using the
+// IdealWifiManager. The runs sweep all the combinations of the comma-separated
+// lists given with --nAps, --nStas, --standards (11a, 11n, 11ac, 11ax), --phys
+// (yans, spectrum) and --ampdu (0 disables A-MPDU aggregation, 1 keeps the
+// default settings).
+//
+// Each run is executed in a child process. For each run, the program reports
+// the number of events executed, the wall clock time of the setup and of the
+// simulation, the number of events executed per second, the peak resident set
+// size of the child process, the number of
+// PHY transmissions, of PHY receptions (i.e., of frames a PHY locked onto) and
+// of packets received by the stations, which tell how the work is shared
+// between the layers. The same seed is used for every run, hence two versions
+// of the simulator that are expected to behave identically must report the
+// same numbers of events and packets.
+//
+// Example: ./waf --run "wifi-scaling-benchmark --nStas=1,10,50 --standards=11ac --phys=yans,spectrum --format=csv"
+//
+
+#include <iostream>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <sys/resource.h>
+#include "ns3/command-line.h"
+#include "ns3/abort.h"
+#include "ns3/simulator.h"
+#include "ns3/rng-seed-manager.h"
+#include "ns3/system-wall-clock-ms.h"
+#include "ns3/boolean.h"
+#include "ns3/uinteger.h"
+#include "ns3/ssid.h"
+#include "ns3/node-container.h"
+#include "ns3/traced-callback.h"
+#include "ns3/packet-socket-helper.h"
+#include "ns3/packet-socket-client.h"
+#include "ns3/packet-socket-server.h"
+#include "ns3/mobility-helper.h"
+#include "ns3/multi-model-spectrum-channel.h"
+#include "ns3/propagation-loss-model.h"
+#include "ns3/propagation-delay-model.h"
+#include "ns3/yans-wifi-helper.h"
+#include "ns3/spectrum-wifi-helper.h"
+#include "ns3/wifi-net-device.h"
+#include "ns3/wifi-phy.h"
+
+using namespace ns3;
+
+/// Parameters of a run
+struct BenchmarkParameters
+{
+  uint32_t nAps;          ///< number of APs
+  uint32_t nStas;         ///< number of stations per AP
+  std::string standard;   ///< the standard (11a, 11n, 11ac or 11ax)
+  std::string phy;        ///< the PHY type (yans or spectrum)
+  bool ampdu;             ///< whether A-MPDU aggregation is enabled
+  uint32_t packetSize;    ///< the size of the packets (bytes)
+  Time interval;          ///< the interval between two packets to a station
+  Time simTime;           ///< the simulation time
+};
+
+/// Results of a run
+struct BenchmarkResults
+{
+  uint64_t events;        ///< number of events executed
+  int64_t setupTime;      ///< wall clock time of the setup (ms)
+  int64_t runTime;        ///< wall clock time of the simulation (ms)
+  long peakRss;           ///< peak resident set size of the run (KB)
+  uint64_t phyTx;         ///< number of PHY transmissions
+  uint64_t phyRx;         ///< number of frames the PHYs locked onto
+  uint64_t packetsRx;     ///< number of packets received by the stations
+};
+
+static uint64_t g_phyTx;     ///< number of PHY transmissions of the current run
+static uint64_t g_phyRx;     ///< number of PHY receptions of the current run
+static uint64_t g_packetsRx; ///< number of packets received in the current run
+
+/**
+ * PHY transmission callback
+ * \param packet the packet
+ */
+static void
+PhyTx (Ptr<const Packet> packet)
+{
+  g_phyTx++;
+}
+
+/**
+ * PHY reception callback
+ * \param packet the packet
+ */
+static void
+PhyRx (Ptr<const Packet> packet)
+{
+  g_phyRx++;
+}
+
+/**
+ * Packet socket server reception callback
+ * \param packet the packet
+ * \param from the address of the sender
+ */
+static void
+PacketRx (Ptr<const Packet> packet, const Address &from)
+{
+  g_packetsRx++;
+}
+
+/**
+ * \param list a comma-separated list
+ * \return the elements of the list
+ */
+static std::vector<std::string>
+SplitList (std::string list)
+{
+  std::vector<std::string> elements;
+  std::istringstream iss (list);
+  std::string element;
+  while (std::getline (iss, element, ','))
+    {
+      if (!element.empty ())
+        {
+          elements.push_back (element);
+        }
+    }
+  return elements;
+}
+
+/**
+ * \param standard the name of a standard (11a, 11n, 11ac or 11ax)
+ * \return the corresponding WifiPhyStandard
+ */
+static WifiPhyStandard
+GetStandard (std::string standard)
+{
+  if (standard == "11a")
+    {
+      return WIFI_PHY_STANDARD_80211a;
+    }
+  else if (standard == "11n")
+    {
+      return WIFI_PHY_STANDARD_80211n_5GHZ;
+    }
+  else if (standard == "11ac")
+    {
+      return WIFI_PHY_STANDARD_80211ac;
+    }
+  else if (standard == "11ax")
+    {
+      return WIFI_PHY_STANDARD_80211ax_5GHZ;
+    }
+  NS_FATAL_ERROR ("Unknown standard " << standard);
+  return WIFI_PHY_STANDARD_UNSPECIFIED;
+}
+
+/**
+ * \param usage the resource usage of a process
+ * \return the peak resident set size of the process (KB)
+ */
+static long
+GetPeakRss (const struct rusage &usage)
+{
+#ifdef __APPLE__
+  return usage.ru_maxrss / 1024;
+#else
+  return usage.ru_maxrss;
+#endif
+}
+
+/**
+ * Run the benchmark for the given parameters
+ *
+ * \param params the parameters of the run
+ *
+ * \return the results of the run
+ */
+static BenchmarkResults
+RunBenchmark (const BenchmarkParameters &params)
+{
+  g_phyTx = 0;
+  g_phyRx = 0;
+  g_packetsRx = 0;
+  RngSeedManager::SetSeed (1);
+  RngSeedManager::SetRun (1);
+
+  SystemWallClockMs clock;
+  clock.Start ();
+
+  NodeContainer aps;
+  aps.Create (params.nAps);
+  NodeContainer stas;
+  stas.Create (params.nAps * params.nStas);
+
+  WifiHelper wifi;
+  wifi.SetStandard (GetStandard (params.standard));
+  wifi.SetRemoteStationManager ("ns3::IdealWifiManager");
+
+  YansWifiPhyHelper yansPhy = YansWifiPhyHelper::Default ();
+  SpectrumWifiPhyHelper spectrumPhy = SpectrumWifiPhyHelper::Default ();
+  WifiPhyHelper *phy;
+  if (params.phy == "yans")
+    {
+      YansWifiChannelHelper channel = YansWifiChannelHelper::Default ();
+      yansPhy.SetChannel (channel.Create ());
+      phy = &yansPhy;
+    }
+  else if (params.phy == "spectrum")
+    {
+      Ptr<MultiModelSpectrumChannel> channel = CreateObject<MultiModelSpectrumChannel> ();
+      channel->AddPropagationLossModel (CreateObject<LogDistancePropagationLossModel> ());
+      channel->SetPropagationDelayModel (CreateObject<ConstantSpeedPropagationDelayModel> ());
+      spectrumPhy.SetChannel (channel);
+      phy = &spectrumPhy;
+    }
+  else
+    {
+      NS_FATAL_ERROR ("Unknown PHY type " << params.phy);
+    }
+
+  NetDeviceContainer apDevices;
+  NetDeviceContainer staDevices;
+  WifiMacHelper mac;
+  for (uint32_t i = 0; i < params.nAps; i++)
+    {
+      std::ostringstream oss;
+      oss << "bss-" << i;
+      Ssid ssid (oss.str ());
+      mac.SetType ("ns3::ApWifiMac", "Ssid", SsidValue (ssid));
+      if (!params.ampdu)
+        {
+          mac.SetType ("ns3::ApWifiMac", "Ssid", SsidValue (ssid),
+                       "BE_MaxAmpduSize", UintegerValue (0));
+        }
+      apDevices.Add (wifi.Install (*phy, mac, aps.Get (i)));
+      mac.SetType ("ns3::StaWifiMac", "Ssid", SsidValue (ssid));
+      if (!params.ampdu)
+        {
+          mac.SetType ("ns3::StaWifiMac", "Ssid", SsidValue (ssid),
+                       "BE_MaxAmpduSize", UintegerValue (0));
+        }
+      NodeContainer bssStas;
+      for (uint32_t j = 0; j < params.nStas; j++)
+        {
+          bssStas.Add (stas.Get (i * params.nStas + j));
+        }
+      staDevices.Add (wifi.Install (*phy, mac, bssStas));
+    }
+
+  MobilityHelper mobility;
+  Ptr<ListPositionAllocator> positions = CreateObject<ListPositionAllocator> ();
+  uint32_t gridWidth = 1;
+  while (gridWidth * gridWidth < params.nAps)
+    {
+      gridWidth++;
+    }
+  for (uint32_t i = 0; i < params.nAps; i++)
+    {
+      positions->Add (Vector (30.0 * (i % gridWidth), 30.0 * (i / gridWidth), 0));
+    }
+  for (uint32_t i = 0; i < params.nAps; i++)
+    {
+      for (uint32_t j = 0; j < params.nStas; j++)
+        {
+          // stations on circles of 2 to 10 m around their AP
+          double angle = 2 * M_PI * j / params.nStas;
+          double radius = 2 + 8.0 * j / params.nStas;
+          positions->Add (Vector (30.0 * (i % gridWidth) + radius * std::cos (angle),
+                                  30.0 * (i / gridWidth) + radius * std::sin (angle), 0));
+        }
+    }
+  mobility.SetPositionAllocator (positions);
+  mobility.Install (aps);
+  mobility.Install (stas);
+
+  PacketSocketHelper packetSocket;
+  packetSocket.Install (aps);
+  packetSocket.Install (stas);
+  for (uint32_t i = 0; i < params.nAps * params.nStas; i++)
+    {
+      Ptr<NetDevice> apDevice = apDevices.Get (i / params.nStas);
+      PacketSocketAddress remote;
+      remote.SetSingleDevice (apDevice->GetIfIndex ());
+      remote.SetPhysicalAddress (staDevices.Get (i)->GetAddress ());
+      remote.SetProtocol (1);
+      Ptr<PacketSocketClient> client = CreateObject<PacketSocketClient> ();
+      client->SetRemote (remote);
+      client->SetAttribute ("PacketSize", UintegerValue (params.packetSize));
+      client->SetAttribute ("MaxPackets", UintegerValue (0));
+      client->SetAttribute ("Interval", TimeValue (params.interval));
+      // spread the start times so that the stations do not contend in lockstep
+      client->SetStartTime (Seconds (0.5) + params.interval * (i % params.nStas) / params.nStas);
+      apDevice->GetNode ()->AddApplication (client);
+
+      PacketSocketAddress local;
+      local.SetSingleDevice (staDevices.Get (i)->GetIfIndex ());
+      local.SetProtocol (1);
+      Ptr<PacketSocketServer> server = CreateObject<PacketSocketServer> ();
+      server->SetLocal (local);
+      stas.Get (i)->AddApplication (server);
+      server->TraceConnectWithoutContext ("Rx", MakeCallback (&PacketRx));
+    }
+
+  NetDeviceContainer devices (apDevices, staDevices);
+  for (NetDeviceContainer::Iterator it = devices.Begin (); it != devices.End (); it++)
+    {
+      Ptr<WifiPhy> wifiPhy = DynamicCast<WifiNetDevice> (*it)->GetPhy ();
+      wifiPhy->TraceConnectWithoutContext ("PhyTxBegin", MakeCallback (&PhyTx));
+      wifiPhy->TraceConnectWithoutContext ("PhyRxBegin", MakeCallback (&PhyRx));
+    }
+
+  BenchmarkResults results;
+  results.setupTime = clock.End ();
+
+  Simulator::Stop (params.simTime);
+  clock.Start ();
+  Simulator::Run ();
+  results.runTime = clock.End ();
+  results.events = Simulator::GetEventCount ();
+  Simulator::Destroy ();
+
+  results.peakRss = 0;
+  results.phyTx = g_phyTx;
+  results.phyRx = g_phyRx;
+  results.packetsRx = g_packetsRx;
+  return results;
+}
+
+/**
+ * Run a simulation in a child process, since the peak resident set size
+ * of a process cannot decrease from one run to the next
+ * \param params the parameters of the run
+ * \return the results of the run
+ */
+static BenchmarkResults
+RunBenchmarkInChild (const BenchmarkParameters &params)
+{
+  int fds[2];
+  NS_ABORT_MSG_IF (pipe (fds) != 0, "Could not create a pipe");
+  pid_t pid = fork ();
+  NS_ABORT_MSG_IF (pid < 0, "Could not fork");
+  if (pid == 0)
+    {
+      close (fds[0]);
+      BenchmarkResults results = RunBenchmark (params);
+      ssize_t written = write (fds[1], &results, sizeof (results));
+      _exit (written == sizeof (results) ? 0 : 1);
+    }
+  close (fds[1]);
+  BenchmarkResults results;
+  ssize_t nread = read (fds[0], &results, sizeof (results));
+  close (fds[0]);
+  int status;
+  struct rusage usage;
+  NS_ABORT_MSG_IF (wait4 (pid, &status, 0, &usage) != pid, "Could not wait for the run");
+  NS_ABORT_MSG_IF (nread != sizeof (results) || !WIFEXITED (status) || WEXITSTATUS (status) != 0,
+                   "The run of " << params.nAps << " APs and " << params.nStas << " stations per AP failed");
+  results.peakRss = GetPeakRss (usage);
+  return results;
+}
+
+int
+main (int argc, char *argv[])
+{
+  std::string nApsList = "1";
+  std::string nStasList = "1,10,50";
+  std::string standards = "11a,11n,11ac,11ax";
+  std::string phys = "yans,spectrum";
+  std::string ampduList = "1";
+  uint32_t packetSize = 1000;
+  double interval = 0.001;
+  double simTime = 2;
+  std::string format = "text";
+  std::string output = "";
+
+  CommandLine cmd;
+  cmd.AddValue ("nAps", "Comma-separated list of numbers of APs", nApsList);
+  cmd.AddValue ("nStas", "Comma-separated list of numbers of stations per AP", nStasList);
+  cmd.AddValue ("standards", "Comma-separated list of standards (11a, 11n, 11ac, 11ax)", standards);
+  cmd.AddValue ("phys", "Comma-separated list of PHY types (yans, spectrum)", phys);
+  cmd.AddValue ("ampdu", "Comma-separated list of A-MPDU settings (0 disables aggregation, 1 keeps the defaults)", ampduList);
+  cmd.AddValue ("packetSize", "Size of the packets (bytes)", packetSize);
+  cmd.AddValue ("interval", "Interval between two packets sent by an AP to a station (s)", interval);
+  cmd.AddValue ("simTime", "Simulation time of each run (s)", simTime);
+  cmd.AddValue ("format", "Format of the results (text or csv)", format);
+  cmd.AddValue ("output", "File to write the results to (standard output if empty)", output);
+  cmd.Parse (argc, argv);
+
+  std::ofstream file;
+  if (!output.empty ())
+    {
+      file.open (output.c_str ());
+      if (!file.is_open ())
+        {
+          NS_FATAL_ERROR ("Could not open " << output);
+        }
+    }
+  std::ostream &os = output.empty () ? std::cout : file;
+  if (format == "csv")
+    {
+      os << "nAps,nStas,standard,phy,ampdu,events,setupMs,runMs,eventsPerSecond,peakRssKb,phyTx,phyRx,packetsRx" << std::endl;
+    }
+
+  std::vector<std::string> apsElements = SplitList (nApsList);
+  std::vector<std::string> stasElements = SplitList (nStasList);
+  std::vector<std::string> standardElements = SplitList (standards);
+  std::vector<std::string> phyElements = SplitList (phys);
+  std::vector<std::string> ampduElements = SplitList (ampduList);
+
+  BenchmarkParameters params;
+  params.packetSize = packetSize;
+  params.interval = Seconds (interval);
+  params.simTime = Seconds (simTime);
+  for (std::vector<std::string>::const_iterator s = standardElements.begin (); s != standardElements.end (); s++)
+    {
+      for (std::vector<std::string>::const_iterator p = phyElements.begin (); p != phyElements.end (); p++)
+        {
+          for (std::vector<std::string>::const_iterator a = ampduElements.begin (); a != ampduElements.end (); a++)
+            {
+              for (std::vector<std::string>::const_iterator ap = apsElements.begin (); ap != apsElements.end (); ap++)
+                {
+                  for (std::vector<std::string>::const_iterator sta = stasElements.begin (); sta != stasElements.end (); sta++)
+                    {
+                      params.standard = *s;
+                      params.phy = *p;
+                      params.ampdu = (*a != "0");
+                      params.nAps = std::atoi (ap->c_str ());
+                      params.nStas = std::atoi (sta->c_str ());
+                      NS_ABORT_MSG_IF (params.nAps == 0 || params.nStas == 0, "There must be at least one AP and one station per AP");
+                      os.flush ();
+                      BenchmarkResults results = RunBenchmarkInChild (params);
+                      double eventsPerSecond = results.runTime > 0 ? results.events * 1000.0 / results.runTime : 0;
+                      if (format == "csv")
+                        {
+                          os << params.nAps << "," << params.nStas << "," << params.standard
+                             << "," << params.phy << "," << params.ampdu
+                             << "," << results.events << "," << results.setupTime
+                             << "," << results.runTime << "," << eventsPerSecond
+                             << "," << results.peakRss << "," << results.phyTx
+                             << "," << results.phyRx << "," << results.packetsRx << std::endl;
+                        }
+                      else
+                        {
+                          os << "aps=" << params.nAps
+                             << " stas=" << params.nStas
+                             << " standard=" << params.standard
+                             << " phy=" << params.phy
+                             << " ampdu=" << params.ampdu
+                             << " events=" << results.events
+                             << " setup=" << results.setupTime << "ms"
+                             << " run=" << results.runTime << "ms"
+                             << " events/s=" << eventsPerSecond
+                             << " peak-rss=" << results.peakRss << "KB"
+                             << " phy-tx=" << results.phyTx
+                             << " phy-rx=" << results.phyRx
+                             << " packets-rx=" << results.packetsRx << std::endl;
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+  return 0;
+}
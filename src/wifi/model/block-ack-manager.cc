@@ -40,6 +40,11 @@ BlockAckManager::Item::Item (Ptr<const Packet> packet, const WifiMacHeader &hdr,
   NS_LOG_FUNCTION (this << packet << hdr << tStamp);
 }
 
+BlockAckManager::RetryInfo::RetryInfo ()
+  : nPackets (0)
+{
+}
+
 Bar::Bar ()
 {
   NS_LOG_FUNCTION (this);
@@ -78,6 +83,7 @@ BlockAckManager::~BlockAckManager ()
   m_queue = 0;
   m_agreements.clear ();
   m_retryPackets.clear ();
+  m_retryIndex.clear ();
 }
 
 bool
@@ -160,6 +166,7 @@ BlockAckManager::DestroyAgreement (Mac48Address recipient, uint8_t tid)
               i++;
             }
         }
+      m_retryIndex.erase (std::make_pair (recipient, tid));
       m_agreements.erase (it);
       //remove scheduled bar
       for (std::list<Bar>::const_iterator i = m_bars.begin (); i != m_bars.end (); )
@@ -280,6 +287,7 @@ BlockAckManager::GetNextPacket (WifiMacHeader &hdr, bool removePacket)
                 {
                   //Standard says the originator should not send a packet with seqnum < winstart
                   NS_LOG_DEBUG ("The Retry packet have sequence number < WinStartO --> Discard " << (*it)->hdr.GetSequenceNumber () << " " << agreement->second.first.GetStartingSequence ());
+                  RemoveFromRetryIndex (recipient, tid, (*it)->hdr.GetSequenceNumber ());
                   agreement->second.second.erase ((*it));
                   it = m_retryPackets.erase (it);
                   continue;
@@ -326,6 +334,7 @@ BlockAckManager::GetNextPacket (WifiMacHeader &hdr, bool removePacket)
           if (removePacket)
             {
               NS_LOG_INFO ("Retry packet seq = " << hdr.GetSequenceNumber ());
+              RemoveFromRetryIndex (recipient, tid, hdr.GetSequenceNumber ());
               it = m_retryPackets.erase (it);
               NS_LOG_DEBUG ("Removed one packet, retry buffer size = " << m_retryPackets.size ());
             }
@@ -344,6 +353,10 @@ BlockAckManager::PeekNextPacketByTidAndAddress (WifiMacHeader &hdr, uint8_t tid,
   Mac48Address recipient = hdr.GetAddr1 ();
   AgreementsI agreement = m_agreements.find (std::make_pair (recipient, tid));
   NS_ASSERT (agreement != m_agreements.end ());
+  if (GetRetryInfo (recipient, tid) == 0)
+    {
+      return packet;
+    }
   std::list<PacketQueueI>::const_iterator it = m_retryPackets.begin ();
   for (; it != m_retryPackets.end (); it++)
     {
@@ -357,6 +370,7 @@ BlockAckManager::PeekNextPacketByTidAndAddress (WifiMacHeader &hdr, uint8_t tid,
             {
               //standard says the originator should not send a packet with seqnum < winstart
               NS_LOG_DEBUG ("The Retry packet have sequence number < WinStartO --> Discard " << (*it)->hdr.GetSequenceNumber () << " " << agreement->second.first.GetStartingSequence ());
+              RemoveFromRetryIndex (recipient, tid, (*it)->hdr.GetSequenceNumber ());
               agreement->second.second.erase ((*it));
               it = m_retryPackets.erase (it);
               it--;
@@ -398,7 +412,11 @@ BlockAckManager::PeekNextPacketByTidAndAddress (WifiMacHeader &hdr, uint8_t tid,
 bool
 BlockAckManager::RemovePacket (uint8_t tid, Mac48Address recipient, uint16_t seqnumber)
 {
-
+  const RetryInfo *retryInfo = GetRetryInfo (recipient, tid);
+  if (retryInfo == 0 || !retryInfo->sequences.test (seqnumber))
+    {
+      return false;
+    }
   std::list<PacketQueueI>::const_iterator it = m_retryPackets.begin ();
   for (; it != m_retryPackets.end (); it++)
     {
@@ -409,6 +427,7 @@ BlockAckManager::RemovePacket (uint8_t tid, Mac48Address recipient, uint16_t seq
       if ((*it)->hdr.GetAddr1 () == recipient && (*it)->hdr.GetQosTid () == tid && (*it)->hdr.GetSequenceNumber () == seqnumber)
         {
           WifiMacHeader hdr = (*it)->hdr;
+          RemoveFromRetryIndex (recipient, tid, seqnumber);
           AgreementsI i = m_agreements.find (std::make_pair (recipient, tid));
           i->second.second.erase ((*it));
           m_retryPackets.erase (it);
@@ -468,31 +487,14 @@ BlockAckManager::GetNRetryNeededPackets (Mac48Address recipient, uint8_t tid) co
 {
   NS_LOG_FUNCTION (this << recipient << +tid);
   uint32_t nPackets = 0;
-  uint16_t currentSeq = 0;
   if (ExistsAgreement (recipient, tid))
     {
-      std::list<PacketQueueI>::const_iterator it = m_retryPackets.begin ();
-      while (it != m_retryPackets.end ())
+      /* a sequence number is in the retry queue at most once per agreement,
+         hence a fragmented packet is counted as one packet */
+      const RetryInfo *retryInfo = GetRetryInfo (recipient, tid);
+      if (retryInfo != 0)
         {
-          if (!(*it)->hdr.IsQosData ())
-            {
-              NS_FATAL_ERROR ("Packet in blockAck manager retry queue is not Qos Data");
-            }
-          if ((*it)->hdr.GetAddr1 () == recipient && (*it)->hdr.GetQosTid () == tid)
-            {
-              currentSeq = (*it)->hdr.GetSequenceNumber ();
-              nPackets++;
-              /* a fragmented packet must be counted as one packet */
-              while (it != m_retryPackets.end () && (*it)->hdr.GetSequenceNumber () == currentSeq)
-                {
-                  it++;
-                }
-            }
-          //go to next packet
-          else
-            {
-              it++;
-            }
+          nPackets = retryInfo->nPackets;
         }
     }
   return nPackets;
@@ -515,21 +517,9 @@ BlockAckManager::SetWifiRemoteStationManager (const Ptr<WifiRemoteStationManager
 bool
 BlockAckManager::AlreadyExists (uint16_t currentSeq, Mac48Address recipient, uint8_t tid) const
 {
-  std::list<PacketQueueI>::const_iterator it = m_retryPackets.begin ();
-  while (it != m_retryPackets.end ())
-    {
-      NS_LOG_FUNCTION (this << (*it)->hdr.GetType ());
-      if (!(*it)->hdr.IsQosData ())
-        {
-          NS_FATAL_ERROR ("Packet in blockAck manager retry queue is not Qos Data");
-        }
-      if ((*it)->hdr.GetAddr1 () == recipient && (*it)->hdr.GetQosTid () == tid && currentSeq == (*it)->hdr.GetSequenceNumber ())
-        {
-          return true;
-        }
-      it++;
-    }
-  return false;
+  NS_LOG_FUNCTION (this << currentSeq << recipient << +tid);
+  const RetryInfo *retryInfo = GetRetryInfo (recipient, tid);
+  return (retryInfo != 0 && retryInfo->sequences.test (currentSeq));
 }
 
 void
@@ -808,6 +798,12 @@ void
 BlockAckManager::RemoveFromRetryQueue (Mac48Address address, uint8_t tid, uint16_t seq)
 {
   /* remove retry packet iterator if it's present in retry queue */
+  const RetryInfo *retryInfo = GetRetryInfo (address, tid);
+  if (retryInfo == 0 || !retryInfo->sequences.test (seq))
+    {
+      return;
+    }
+  RemoveFromRetryIndex (address, tid, seq);
   std::list<PacketQueueI>::const_iterator it = m_retryPackets.begin ();
   while (it != m_retryPackets.end ())
     {
@@ -894,6 +890,10 @@ uint16_t
 BlockAckManager::GetSeqNumOfNextRetryPacket (Mac48Address recipient, uint8_t tid) const
 {
   NS_LOG_FUNCTION (this << recipient << +tid);
+  if (GetRetryInfo (recipient, tid) == 0)
+    {
+      return 4096;
+    }
   std::list<PacketQueueI>::const_iterator it = m_retryPackets.begin ();
   while (it != m_retryPackets.end ())
     {
@@ -926,6 +926,10 @@ void
 BlockAckManager::InsertInRetryQueue (PacketQueueI item)
 {
   NS_LOG_INFO ("Adding to retry queue " << (*item).hdr.GetSequenceNumber ());
+  RetryInfo &retryInfo = m_retryIndex[std::make_pair (item->hdr.GetAddr1 (), item->hdr.GetQosTid ())];
+  NS_ASSERT (!retryInfo.sequences.test (item->hdr.GetSequenceNumber ()));
+  retryInfo.sequences.set (item->hdr.GetSequenceNumber ());
+  retryInfo.nPackets++;
   if (m_retryPackets.size () == 0)
     {
       m_retryPackets.push_back (item);
@@ -951,4 +955,27 @@ BlockAckManager::InsertInRetryQueue (PacketQueueI item)
     }
 }
 
+const BlockAckManager::RetryInfo *
+BlockAckManager::GetRetryInfo (Mac48Address recipient, uint8_t tid) const
+{
+  RetryIndex::const_iterator it = m_retryIndex.find (std::make_pair (recipient, tid));
+  if (it == m_retryIndex.end ())
+    {
+      return 0;
+    }
+  return &it->second;
+}
+
+void
+BlockAckManager::RemoveFromRetryIndex (Mac48Address recipient, uint8_t tid, uint16_t seq)
+{
+  RetryIndex::iterator it = m_retryIndex.find (std::make_pair (recipient, tid));
+  NS_ASSERT (it != m_retryIndex.end () && it->second.sequences.test (seq));
+  it->second.sequences.reset (seq);
+  if (--it->second.nPackets == 0)
+    {
+      m_retryIndex.erase (it);
+    }
+}
+
 } //namespace ns3
@@ -22,10 +22,13 @@
 #define BLOCK_ACK_MANAGER_H
 
 #include <map>
+#include <bitset>
+#include <unordered_map>
 #include "ns3/nstime.h"
 #include "wifi-mac-header.h"
 #include "originator-block-ack-agreement.h"
 #include "block-ack-type.h"
+#include "wifi-utils.h"
 
 namespace ns3 {
 
@@ -423,20 +426,35 @@ private:
    */
   typedef std::list<Item>::const_iterator PacketQueueCI;
   /**
-   * typedef for a map between MAC address and block ACK agreement.
+   * typedef for a map between MAC address and TID and block ACK agreement.
    */
-  typedef std::map<std::pair<Mac48Address, uint8_t>,
-                   std::pair<OriginatorBlockAckAgreement, PacketQueue> > Agreements;
+  typedef std::unordered_map<std::pair<Mac48Address, uint8_t>,
+                             std::pair<OriginatorBlockAckAgreement, PacketQueue>,
+                             WifiAddressTidHash> Agreements;
   /**
    * typedef for an iterator for Agreements.
    */
-  typedef std::map<std::pair<Mac48Address, uint8_t>,
-                   std::pair<OriginatorBlockAckAgreement, PacketQueue> >::iterator AgreementsI;
+  typedef Agreements::iterator AgreementsI;
   /**
    * typedef for a const iterator for Agreements.
    */
-  typedef std::map<std::pair<Mac48Address, uint8_t>,
-                   std::pair<OriginatorBlockAckAgreement, PacketQueue> >::const_iterator AgreementsCI;
+  typedef Agreements::const_iterator AgreementsCI;
+
+  /**
+   * The packets of a block ack agreement that are in the retransmission queue.
+   * A sequence number is in the retransmission queue at most once per agreement.
+   */
+  struct RetryInfo
+  {
+    RetryInfo ();
+    std::bitset<4096> sequences; ///< sequence numbers in the retransmission queue
+    uint32_t nPackets;           ///< number of packets in the retransmission queue
+  };
+  /**
+   * typedef for a map between MAC address and TID and the packets of the
+   * agreement in the retransmission queue.
+   */
+  typedef std::unordered_map<std::pair<Mac48Address, uint8_t>, RetryInfo, WifiAddressTidHash> RetryIndex;
 
   /**
    * A struct for packet, Wifi header, and timestamp.
@@ -476,6 +494,24 @@ private:
    */
   void RemoveFromRetryQueue (Mac48Address address, uint8_t tid, uint16_t seq);
 
+  /**
+   * Record that a packet is no longer in the retransmission queue.
+   * This method must be called whenever an item is erased from m_retryPackets.
+   *
+   * \param recipient recipient mac address of the packet
+   * \param tid Traffic ID of the packet
+   * \param seq sequence number of the packet
+   */
+  void RemoveFromRetryIndex (Mac48Address recipient, uint8_t tid, uint16_t seq);
+
+  /**
+   * \param recipient recipient mac address
+   * \param tid Traffic ID
+   * \return the packets of the agreement in the retransmission queue, or 0
+   *         if there are none
+   */
+  const RetryInfo * GetRetryInfo (Mac48Address recipient, uint8_t tid) const;
+
   /**
    * This data structure contains, for each block ack agreement (recipient, tid), a set of packets
    * for which an ack by block ack is requested.
@@ -490,6 +526,11 @@ private:
    * frame.
    */
   std::list<PacketQueueI> m_retryPackets;
+  /**
+   * For each agreement with packets in m_retryPackets, the sequence numbers
+   * of these packets, which avoids scanning m_retryPackets in most cases.
+   */
+  RetryIndex m_retryIndex;
   std::list<Bar> m_bars; ///< list of BARs
 
   uint8_t m_blockAckThreshold; ///< block ack threshold
@@ -118,7 +118,8 @@ ChannelAccessManager::ChannelAccessManager ()
     m_off (false),
     m_slot (Seconds (0.0)),
     m_sifs (Seconds (0.0)),
-    m_phyListener (0)
+    m_phyListener (0),
+    m_accessGrantStartValid (false)
 {
   NS_LOG_FUNCTION (this);
 }
@@ -181,6 +182,7 @@ ChannelAccessManager::SetSifs (Time sifs)
 {
   NS_LOG_FUNCTION (this << sifs);
   m_sifs = sifs;
+  InvalidateAccessGrantStart ();
 }
 
 void
@@ -188,6 +190,7 @@ ChannelAccessManager::SetEifsNoDifs (Time eifsNoDifs)
 {
   NS_LOG_FUNCTION (this << eifsNoDifs);
   m_eifsNoDifs = eifsNoDifs;
+  InvalidateAccessGrantStart ();
 }
 
 Time
@@ -402,10 +405,28 @@ ChannelAccessManager::AccessTimeout (void)
   DoRestartAccessTimeoutIfNeeded ();
 }
 
+void
+ChannelAccessManager::InvalidateAccessGrantStart (void)
+{
+  m_accessGrantStartValid = false;
+}
+
 Time
 ChannelAccessManager::GetAccessGrantStart (bool ignoreNav) const
 {
-  NS_LOG_FUNCTION (this);
+  NS_LOG_FUNCTION (this << ignoreNav);
+  if (!m_accessGrantStartValid)
+    {
+      m_accessGrantStart = DoGetAccessGrantStart (false);
+      m_accessGrantStartIgnoreNav = DoGetAccessGrantStart (true);
+      m_accessGrantStartValid = true;
+    }
+  return ignoreNav ? m_accessGrantStartIgnoreNav : m_accessGrantStart;
+}
+
+Time
+ChannelAccessManager::DoGetAccessGrantStart (bool ignoreNav) const
+{
   Time rxAccessStart;
   if (!m_rxing)
     {
@@ -469,9 +490,11 @@ Time
 ChannelAccessManager::GetBackoffEndFor (Ptr<Txop> state)
 {
   NS_LOG_FUNCTION (this << state);
-  NS_LOG_DEBUG ("Backoff start: " << GetBackoffStartFor (state).As (Time::US) <<
-                " end: " << (GetBackoffStartFor (state) + state->GetBackoffSlots () * m_slot).As (Time::US));
-  return GetBackoffStartFor (state) + (state->GetBackoffSlots () * m_slot);
+  Time backoffStart = GetBackoffStartFor (state);
+  Time backoffEnd = backoffStart + (state->GetBackoffSlots () * m_slot);
+  NS_LOG_DEBUG ("Backoff start: " << backoffStart.As (Time::US) <<
+                " end: " << backoffEnd.As (Time::US));
+  return backoffEnd;
 }
 
 void
@@ -560,6 +583,7 @@ ChannelAccessManager::NotifyRxStartNow (Time duration)
   m_lastRxStart = Simulator::Now ();
   m_lastRxDuration = duration;
   m_rxing = true;
+  InvalidateAccessGrantStart ();
 }
 
 void
@@ -570,6 +594,7 @@ ChannelAccessManager::NotifyRxEndOkNow (void)
   m_lastRxEnd = Simulator::Now ();
   m_lastRxReceivedOk = true;
   m_rxing = false;
+  InvalidateAccessGrantStart ();
 }
 
 void
@@ -580,6 +605,7 @@ ChannelAccessManager::NotifyRxEndErrorNow (void)
   m_lastRxEnd = Simulator::Now ();
   m_lastRxReceivedOk = false;
   m_rxing = false;
+  InvalidateAccessGrantStart ();
 }
 
 void
@@ -595,11 +621,13 @@ ChannelAccessManager::NotifyTxStartNow (Time duration)
       m_lastRxDuration = m_lastRxEnd - m_lastRxStart;
       m_lastRxReceivedOk = true;
       m_rxing = false;
+      InvalidateAccessGrantStart ();
     }
   NS_LOG_DEBUG ("tx start for " << duration);
   UpdateBackoff ();
   m_lastTxStart = Simulator::Now ();
   m_lastTxDuration = duration;
+  InvalidateAccessGrantStart ();
 }
 
 void
@@ -610,6 +638,7 @@ ChannelAccessManager::NotifyMaybeCcaBusyStartNow (Time duration)
   UpdateBackoff ();
   m_lastBusyStart = Simulator::Now ();
   m_lastBusyDuration = duration;
+  InvalidateAccessGrantStart ();
 }
 
 void
@@ -644,6 +673,7 @@ ChannelAccessManager::NotifySwitchingStartNow (Time duration)
     {
       m_lastCtsTimeoutEnd = now;
     }
+  InvalidateAccessGrantStart ();
 
   //Cancel timeout
   if (m_accessTimeout.IsRunning ())
@@ -669,6 +699,7 @@ ChannelAccessManager::NotifySwitchingStartNow (Time duration)
   NS_LOG_DEBUG ("switching start for " << duration);
   m_lastSwitchingStart = Simulator::Now ();
   m_lastSwitchingDuration = duration;
+  InvalidateAccessGrantStart ();
 
 }
 
@@ -758,6 +789,7 @@ ChannelAccessManager::NotifyNavResetNow (Time duration)
   UpdateBackoff ();
   m_lastNavStart = Simulator::Now ();
   m_lastNavDuration = duration;
+  InvalidateAccessGrantStart ();
   /**
    * If the nav reset indicates an end-of-nav which is earlier
    * than the previous end-of-nav, the expected end of backoff
@@ -780,6 +812,7 @@ ChannelAccessManager::NotifyNavStartNow (Time duration)
     {
       m_lastNavStart = Simulator::Now ();
       m_lastNavDuration = duration;
+      InvalidateAccessGrantStart ();
     }
 }
 
@@ -789,6 +822,7 @@ ChannelAccessManager::NotifyAckTimeoutStartNow (Time duration)
   NS_LOG_FUNCTION (this << duration);
   NS_ASSERT (m_lastAckTimeoutEnd < Simulator::Now ());
   m_lastAckTimeoutEnd = Simulator::Now () + duration;
+  InvalidateAccessGrantStart ();
 }
 
 void
@@ -796,6 +830,7 @@ ChannelAccessManager::NotifyAckTimeoutResetNow ()
 {
   NS_LOG_FUNCTION (this);
   m_lastAckTimeoutEnd = Simulator::Now ();
+  InvalidateAccessGrantStart ();
   DoRestartAccessTimeoutIfNeeded ();
 }
 
@@ -804,6 +839,7 @@ ChannelAccessManager::NotifyCtsTimeoutStartNow (Time duration)
 {
   NS_LOG_FUNCTION (this << duration);
   m_lastCtsTimeoutEnd = Simulator::Now () + duration;
+  InvalidateAccessGrantStart ();
 }
 
 void
@@ -811,6 +847,7 @@ ChannelAccessManager::NotifyCtsTimeoutResetNow ()
 {
   NS_LOG_FUNCTION (this);
   m_lastCtsTimeoutEnd = Simulator::Now ();
+  InvalidateAccessGrantStart ();
   DoRestartAccessTimeoutIfNeeded ();
 }
 
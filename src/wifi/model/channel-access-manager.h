@@ -268,13 +268,27 @@ private:
   Time MostRecent (Time a, Time b, Time c, Time d, Time e, Time f, Time g) const;
   /**
    * Access will never be granted to the medium _before_
-   * the time returned by this method.
+   * the time returned by this method. The result only depends on the
+   * state of the medium, hence it is cached until the state changes.
    *
    * \param ignoreNav flag whether NAV should be ignored
    *
    * \returns the absolute time at which access could start to be granted
    */
   Time GetAccessGrantStart (bool ignoreNav = false) const;
+  /**
+   * Compute the time returned by GetAccessGrantStart.
+   *
+   * \param ignoreNav flag whether NAV should be ignored
+   *
+   * \returns the absolute time at which access could start to be granted
+   */
+  Time DoGetAccessGrantStart (bool ignoreNav) const;
+  /**
+   * Invalidate the cached access grant start times. This must be called
+   * whenever the state of the medium changes.
+   */
+  void InvalidateAccessGrantStart (void);
   /**
    * Return the time when the backoff procedure
    * started for the given Txop.
@@ -346,6 +360,10 @@ private:
   Time m_slot;                  //!< the slot time
   Time m_sifs;                  //!< the SIFS time
   PhyListener* m_phyListener;   //!< the phy listener
+
+  mutable bool m_accessGrantStartValid;     //!< whether the cached access grant start times are valid
+  mutable Time m_accessGrantStart;          //!< the cached access grant start time
+  mutable Time m_accessGrantStartIgnoreNav; //!< the cached access grant start time, ignoring the NAV
 };
 
 } //namespace ns3
@@ -0,0 +1,96 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <cmath>
+#include <algorithm>
+#include "ns3/assert.h"
+#include "error-rate-table.h"
+
+namespace ns3 {
+
+const double ErrorRateTable::MIN_SNR_DB = -10.0;
+const double ErrorRateTable::MAX_SNR_DB = 60.0;
+const double ErrorRateTable::STEP_DB = 0.01;
+
+/**
+ * Bounds of the stored samples: below the lower bound, the bit error
+ * probability does not affect any realistic chunk (e^-700 * nbits), and
+ * above the upper bound no bit can be received (e^-e^7 is 0 in double
+ * precision).
+ */
+static const double MIN_SAMPLE = -700.0;
+static const double MAX_SAMPLE = 7.0;
+
+uint32_t
+ErrorRateTable::GetNSamples (void)
+{
+  return static_cast<uint32_t> ((MAX_SNR_DB - MIN_SNR_DB) / STEP_DB + 0.5) + 1;
+}
+
+double
+ErrorRateTable::GetSnr (uint32_t i)
+{
+  return std::pow (10.0, (MIN_SNR_DB + i * STEP_DB) / 10.0);
+}
+
+bool
+ErrorRateTable::IsInRange (double snr)
+{
+  static const double minSnr = GetSnr (0);
+  static const double maxSnr = GetSnr (GetNSamples () - 1);
+  return snr >= minSnr && snr <= maxSnr;
+}
+
+ErrorRateTable::ErrorRateTable (const std::vector<double> &successRates)
+{
+  NS_ASSERT (successRates.size () == GetNSamples ());
+  m_samples.reserve (successRates.size ());
+  for (std::vector<double>::const_iterator i = successRates.begin (); i != successRates.end (); i++)
+    {
+      // log (-log (1)) is -inf and log (-log (0)) is +inf, hence the bounds
+      double sample = std::log (-std::log (*i));
+      m_samples.push_back (std::max (MIN_SAMPLE, std::min (sample, MAX_SAMPLE)));
+    }
+}
+
+double
+ErrorRateTable::GetChunkSuccessRate (double snr, uint64_t nbits) const
+{
+  NS_ASSERT (IsInRange (snr));
+  if (nbits == 0)
+    {
+      return 1.0;
+    }
+  double position = (10.0 * std::log10 (snr) - MIN_SNR_DB) / STEP_DB;
+  uint32_t i = std::min (static_cast<uint32_t> (position), static_cast<uint32_t> (m_samples.size () - 2));
+  double fraction = position - i;
+  // the success rate of a bit is exp (-exp (sample)), hence the success
+  // rate of the chunk is exp (-nbits * exp (sample))
+  if (m_samples[i] > 0 || m_samples[i + 1] > 0)
+    {
+      // the bit error probability is close to 1, where the samples vary
+      // steeply (and saturate once the error probability is clamped to 1):
+      // interpolate the success rates instead, which are then close to 0
+      // for any chunk larger than a few bits
+      double low = std::exp (-static_cast<double> (nbits) * std::exp (m_samples[i]));
+      double high = std::exp (-static_cast<double> (nbits) * std::exp (m_samples[i + 1]));
+      return low + fraction * (high - low);
+    }
+  double sample = m_samples[i] + fraction * (m_samples[i + 1] - m_samples[i]);
+  return std::exp (-static_cast<double> (nbits) * std::exp (sample));
+}
+
+} //namespace ns3
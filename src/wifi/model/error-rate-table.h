@@ -0,0 +1,84 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef ERROR_RATE_TABLE_H
+#define ERROR_RATE_TABLE_H
+
+#include <vector>
+#include <stdint.h>
+
+namespace ns3 {
+
+/**
+ * \ingroup wifi
+ * \brief a table of the success rate of a single bit as a function of the SNR
+ *
+ * The error rate models for OFDM modulations compute the success rate of a
+ * chunk of nbits bits as (1 - pe)^nbits, where the bit error probability pe
+ * only depends on the SNR for a given mode. Evaluating pe (erfc and the FEC
+ * union bounds) is expensive, hence the tabulated error rate models sample
+ * 1 - pe once, at regular intervals of SNR in dB, and interpolate between the
+ * samples. The table is only defined between MIN_SNR_DB and MAX_SNR_DB; the
+ * models use the analytic expressions outside this range.
+ *
+ * To keep the relative interpolation error small over the many orders of
+ * magnitude covered by pe, the table stores log (-log (1 - pe)), which is a
+ * smooth function of the SNR in dB, and interpolates it linearly.
+ */
+class ErrorRateTable
+{
+public:
+  static const double MIN_SNR_DB; //!< the SNR (dB) of the first sample
+  static const double MAX_SNR_DB; //!< the SNR (dB) of the last sample
+  static const double STEP_DB;    //!< the SNR (dB) interval between two samples
+
+  /**
+   * \return the number of samples in a table
+   */
+  static uint32_t GetNSamples (void);
+  /**
+   * \param i the index of a sample
+   * \return the SNR (linear ratio) of the sample
+   */
+  static double GetSnr (uint32_t i);
+  /**
+   * \param snr the SNR (linear ratio)
+   * \return true if the table can be used for the given SNR
+   */
+  static bool IsInRange (double snr);
+
+  /**
+   * Create a table from the success rates of a single bit.
+   *
+   * \param successRates the success rate of a single bit at the SNR of
+   *        each sample, i.e., GetNSamples () values
+   */
+  ErrorRateTable (const std::vector<double> &successRates);
+
+  /**
+   * \param snr the SNR (linear ratio), which must be in range
+   * \param nbits the number of bits in the chunk
+   * \return the interpolated success rate of the chunk
+   */
+  double GetChunkSuccessRate (double snr, uint64_t nbits) const;
+
+private:
+  std::vector<double> m_samples; //!< log (-log (success rate of a bit)) at each sample
+};
+
+} //namespace ns3
+
+#endif /* ERROR_RATE_TABLE_H */
@@ -25,6 +25,7 @@
 #include "interference-helper.h"
 #include "wifi-phy.h"
 #include "error-rate-model.h"
+#include <algorithm>
 
 namespace ns3 {
 
@@ -211,8 +212,10 @@ InterferenceHelper::AppendEvent (Ptr<Event> event)
                          GetNextPosition (event->GetStartTime ()));
     }
   auto first = AddNiChangeEvent (event->GetStartTime (), NiChange (previousPowerStart, event));
+  // inserting the last NiChange may invalidate the iterator to the first one
+  std::size_t firstIndex = first - m_niChanges.begin ();
   auto last = AddNiChangeEvent (event->GetEndTime (), NiChange (previousPowerEnd, event));
-  for (auto i = first; i != last; ++i)
+  for (auto i = m_niChanges.begin () + firstIndex; i != last; ++i)
     {
       i->second.AddPower (event->GetRxPowerW ());
     }
@@ -237,17 +240,17 @@ double
 InterferenceHelper::CalculateNoiseInterferenceW (Ptr<Event> event, NiChanges *ni) const
 {
   double noiseInterference = m_firstPower;
-  auto it = m_niChanges.find (event->GetStartTime ());
+  auto it = Find (event->GetStartTime ());
   for (; it != m_niChanges.end () && it->second.GetEvent () != event; ++it)
     {
       noiseInterference = it->second.GetPower ();
     }
-  ni->emplace (event->GetStartTime (), NiChange (0, event));
+  ni->emplace_back (event->GetStartTime (), NiChange (0, event));
   while (++it != m_niChanges.end () && it->second.GetEvent () != event)
     {
-      ni->insert (*it);
+      ni->push_back (*it);
     }
-  ni->emplace (event->GetEndTime (), NiChange (0, event));
+  ni->emplace_back (event->GetEndTime (), NiChange (0, event));
   return noiseInterference;
 }
 
@@ -740,6 +743,7 @@ struct InterferenceHelper::SnrPer
 InterferenceHelper::CalculatePlcpPayloadSnrPer (Ptr<Event> event) const
 {
   NiChanges ni;
+  ni.reserve (m_niChanges.size () + 1);
   double noiseInterferenceW = CalculateNoiseInterferenceW (event, &ni);
   double snr = CalculateSnr (event->GetRxPowerW (),
                              noiseInterferenceW,
@@ -760,6 +764,7 @@ struct InterferenceHelper::SnrPer
 InterferenceHelper::CalculatePlcpHeaderSnrPer (Ptr<Event> event) const
 {
   NiChanges ni;
+  ni.reserve (m_niChanges.size () + 1);
   double noiseInterferenceW = CalculateNoiseInterferenceW (event, &ni);
   double snr = CalculateSnr (event->GetRxPowerW (),
                              noiseInterferenceW,
@@ -776,6 +781,47 @@ InterferenceHelper::CalculatePlcpHeaderSnrPer (Ptr<Event> event) const
   return snrPer;
 }
 
+struct InterferenceHelper::SnrPer
+InterferenceHelper::CalculateAverageSnrPer (Ptr<Event> event, double *headerPer) const
+{
+  NS_LOG_FUNCTION (this << event);
+  const WifiTxVector txVector = event->GetTxVector ();
+  double powerW = event->GetRxPowerW ();
+  // integrate the noise and interference power from the start to the end of the event
+  auto it = Find (event->GetStartTime ());
+  while (it != m_niChanges.end () && it->second.GetEvent () != event)
+    {
+      ++it;
+    }
+  double noiseInterferenceW = m_firstPower;
+  double energy = 0;
+  Time previous = event->GetStartTime ();
+  while (++it != m_niChanges.end () && it->second.GetEvent () != event)
+    {
+      energy += noiseInterferenceW * (it->first - previous).GetSeconds ();
+      noiseInterferenceW = it->second.GetPower () - powerW;
+      previous = it->first;
+    }
+  energy += noiseInterferenceW * (event->GetEndTime () - previous).GetSeconds ();
+  Time duration = event->GetEndTime () - event->GetStartTime ();
+  double snr = CalculateSnr (powerW, energy / duration.GetSeconds (), txVector.GetChannelWidth ());
+
+  Time plcpHeaderDuration = WifiPhy::CalculatePlcpPreambleAndHeaderDuration (txVector)
+    - WifiPhy::GetPlcpPreambleDuration (txVector);
+  *headerPer = 0;
+  if (txVector.GetPreambleType () != WIFI_PREAMBLE_NONE)
+    {
+      *headerPer = 1 - CalculateChunkSuccessRate (snr, plcpHeaderDuration, WifiPhy::GetPlcpHeaderMode (txVector), txVector);
+    }
+  Time plcpPayloadDuration = duration - plcpHeaderDuration - WifiPhy::GetPlcpPreambleDuration (txVector);
+
+  struct SnrPer snrPer;
+  snrPer.snr = snr;
+  snrPer.per = 1 - CalculateChunkSuccessRate (snr, plcpPayloadDuration, event->GetPayloadMode (), txVector);
+  NS_LOG_DEBUG ("average snr(linear)=" << snr << ", header per=" << *headerPer << ", payload per=" << snrPer.per);
+  return snrPer;
+}
+
 void
 InterferenceHelper::EraseEvents (void)
 {
@@ -786,10 +832,33 @@ InterferenceHelper::EraseEvents (void)
   m_firstPower = 0;
 }
 
+bool
+InterferenceHelper::IsBefore (Time moment, const NiChanges::value_type &change)
+{
+  return moment < change.first;
+}
+
+bool
+InterferenceHelper::IsChangeBefore (const NiChanges::value_type &change, Time moment)
+{
+  return change.first < moment;
+}
+
 InterferenceHelper::NiChanges::const_iterator
 InterferenceHelper::GetNextPosition (Time moment) const
 {
-  return m_niChanges.upper_bound (moment);
+  return std::upper_bound (m_niChanges.begin (), m_niChanges.end (), moment, &InterferenceHelper::IsBefore);
+}
+
+InterferenceHelper::NiChanges::const_iterator
+InterferenceHelper::Find (Time moment) const
+{
+  auto it = std::lower_bound (m_niChanges.begin (), m_niChanges.end (), moment, &InterferenceHelper::IsChangeBefore);
+  if (it != m_niChanges.end () && it->first != moment)
+    {
+      return m_niChanges.end ();
+    }
+  return it;
 }
 
 InterferenceHelper::NiChanges::const_iterator
@@ -821,7 +890,7 @@ InterferenceHelper::NotifyRxEnd ()
   NS_LOG_FUNCTION (this);
   m_rxing = false;
   //Update m_firstPower for frame capture
-  auto it = m_niChanges.find (Simulator::Now ());
+  auto it = Find (Simulator::Now ());
   it--;
   m_firstPower = it->second.GetPower ();
 }
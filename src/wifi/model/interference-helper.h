@@ -24,6 +24,7 @@
 #include "ns3/nstime.h"
 #include "wifi-tx-vector.h"
 #include <map>
+#include <vector>
 
 namespace ns3 {
 
@@ -189,6 +190,20 @@ public:
    * \return struct of SNR and PER
    */
   struct InterferenceHelper::SnrPer CalculatePlcpHeaderSnrPer (Ptr<Event> event) const;
+  /**
+   * Calculate the SNIR averaged over the whole signal, i.e., for the
+   * time-weighted mean of the noise and interference power, and the error
+   * rates of the plcp header and of the plcp payload at this SNIR, with a
+   * single call to the error rate model each. The plcp header is considered
+   * to be sent in the mode returned by WifiPhy::GetPlcpHeaderMode.
+   *
+   * \param event the event corresponding to the first time the corresponding packet arrives
+   * \param headerPer the error rate of the plcp header, zero if the packet has none
+   *
+   * 
+eturn struct of the average SNR and the PER of the plcp payload
+   */
+  struct InterferenceHelper::SnrPer CalculateAverageSnrPer (Ptr<Event> event, double *headerPer) const;
 
   /**
    * Notify that RX has started.
@@ -244,9 +259,33 @@ private:
   };
 
   /**
-   * typedef for a multimap of NiChanges
+   * typedef for a vector of NiChanges, sorted by time. NiChanges occurring
+   * at the same time are kept in insertion order. A sorted vector is used
+   * rather than a multimap because only a few NiChanges are stored at a
+   * time (see AppendEvent) and they are mostly inserted at the end.
    */
-  typedef std::multimap<Time, NiChange> NiChanges;
+  typedef std::vector<std::pair<Time, NiChange> > NiChanges;
+
+  /**
+   * Compare a time with the time of a NiChange
+   *
+   * \param moment the time
+   * \param change the NiChange
+   * \return true if the time is before the NiChange
+   *
+   * This is the comparison used by std::upper_bound.
+   */
+  static bool IsBefore (Time moment, const NiChanges::value_type &change);
+  /**
+   * Compare the time of a NiChange with a time
+   *
+   * \param change the NiChange
+   * \param moment the time
+   * \return true if the NiChange is before the time
+   *
+   * This is the comparison used by std::lower_bound.
+   */
+  static bool IsChangeBefore (const NiChanges::value_type &change, Time moment);
 
   /**
    * Append the given Event.
@@ -336,6 +375,14 @@ private:
    * \returns an iterator to the list of NiChanges
    */
   NiChanges::const_iterator GetPreviousPosition (Time moment) const;
+  /**
+   * Returns an iterator to the first nichange that occurs at moment
+   *
+   * \param moment time to check for
+   * \returns an iterator to the list of NiChanges, or the end of the list
+   *          if no nichange occurs at moment
+   */
+  NiChanges::const_iterator Find (Time moment) const;
 
   /**
    * Add NiChange to the list at the appropriate position and
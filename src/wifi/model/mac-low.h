@@ -24,6 +24,7 @@
 #define MAC_LOW_H
 
 #include <map>
+#include <unordered_map>
 #include "ns3/object.h"
 #include "ns3/nstime.h"
 #include "channel-access-manager.h"
@@ -34,6 +35,7 @@
 #include "wifi-tx-vector.h"
 #include "block-ack-type.h"
 #include "wifi-mpdu-type.h"
+#include "wifi-utils.h"
 
 class TwoLevelAggregationTest;
 class AmpduAggregationTest;
@@ -942,11 +944,11 @@ private:
   typedef std::pair<Mac48Address, uint8_t> AgreementKey; //!< agreement key typedef
   typedef std::pair<BlockAckAgreement, std::list<BufferedPacket> > AgreementValue; //!< agreement value typedef
 
-  typedef std::map<AgreementKey, AgreementValue> Agreements; //!< agreements
-  typedef std::map<AgreementKey, AgreementValue>::iterator AgreementsI; //!< agreements iterator
+  typedef std::unordered_map<AgreementKey, AgreementValue, WifiAddressTidHash> Agreements; //!< agreements
+  typedef Agreements::iterator AgreementsI; //!< agreements iterator
 
-  typedef std::map<AgreementKey, BlockAckCache> BlockAckCaches; //!< block ack caches typedef
-  typedef std::map<AgreementKey, BlockAckCache>::iterator BlockAckCachesI; //!< block ack caches iterator typedef
+  typedef std::unordered_map<AgreementKey, BlockAckCache, WifiAddressTidHash> BlockAckCaches; //!< block ack caches typedef
+  typedef BlockAckCaches::iterator BlockAckCachesI; //!< block ack caches iterator typedef
 
   Agreements m_bAckAgreements; //!< block ack agreements
   BlockAckCaches m_bAckCaches; //!< block ack caches
@@ -35,6 +35,7 @@
  */
 
 #include <iomanip>
+#include <algorithm>
 #include "ns3/packet.h"
 #include "ns3/simulator.h"
 #include "ns3/log.h"
@@ -50,26 +51,6 @@ NS_LOG_COMPONENT_DEFINE ("MinstrelHtWifiManager");
 
 namespace ns3 {
 
-///MinstrelHtWifiRemoteStation structure
-struct MinstrelHtWifiRemoteStation : MinstrelWifiRemoteStation
-{
-  uint8_t m_sampleGroup;     //!< The group that the sample rate belongs to.
-
-  uint32_t m_sampleWait;      //!< How many transmission attempts to wait until a new sample.
-  uint32_t m_sampleTries;     //!< Number of sample tries after waiting sampleWait.
-  uint32_t m_sampleCount;     //!< Max number of samples per update interval.
-  uint32_t m_numSamplesSlow;  //!< Number of times a slow rate was sampled.
-
-  uint32_t m_avgAmpduLen;      //!< Average number of MPDUs in an A-MPDU.
-  uint32_t m_ampduLen;         //!< Number of MPDUs in an A-MPDU.
-  uint32_t m_ampduPacketCount; //!< Number of A-MPDUs transmitted.
-
-  McsGroupData m_groupsTable;  //!< Table of groups with stats.
-  bool m_isHt;                 //!< If the station is HT capable.
-
-  std::ofstream m_statsFile;   //!< File where statistics table is written.
-};
-
 NS_OBJECT_ENSURE_REGISTERED (MinstrelHtWifiManager);
 
 TypeId
@@ -402,6 +383,7 @@ MinstrelHtWifiManager::DoCreateStation (void) const
   station->m_avgAmpduLen = 1;
   station->m_ampduLen = 0;
   station->m_ampduPacketCount = 0;
+  station->m_numStatsUpdates = 0;
 
   // If the device supports HT
   if (HasHtSupported () || HasVhtSupported ())
@@ -527,9 +509,7 @@ MinstrelHtWifiManager::DoReportDataFailed (WifiRemoteStation *st)
     }
   else
     {
-      uint8_t rateId = GetRateId (station->m_txrate);
-      uint8_t groupId = GetGroupId (station->m_txrate);
-      station->m_groupsTable[groupId].m_ratesTable[rateId].numRateAttempt++; // Increment the attempts counter for the rate used.
+      AddRateAttempts (station, 0, 1); // Increment the attempts counter for the rate used.
       UpdateRate (station);
     }
 }
@@ -567,10 +547,7 @@ MinstrelHtWifiManager::DoReportDataOk (WifiRemoteStation *st, double ackSnr, Wif
     }
   else
     {
-      uint8_t rateId = GetRateId (station->m_txrate);
-      uint8_t groupId = GetGroupId (station->m_txrate);
-      station->m_groupsTable[groupId].m_ratesTable[rateId].numRateSuccess++;
-      station->m_groupsTable[groupId].m_ratesTable[rateId].numRateAttempt++;
+      AddRateAttempts (station, 1, 1);
 
       UpdatePacketCounters (station, 1, 0);
 
@@ -663,10 +640,7 @@ MinstrelHtWifiManager::DoReportAmpduTxStatus (WifiRemoteStation *st, uint8_t nSu
 
   UpdatePacketCounters (station, nSuccessfulMpdus, nFailedMpdus);
 
-  uint8_t rateId = GetRateId (station->m_txrate);
-  uint8_t groupId = GetGroupId (station->m_txrate);
-  station->m_groupsTable[groupId].m_ratesTable[rateId].numRateSuccess += nSuccessfulMpdus;
-  station->m_groupsTable[groupId].m_ratesTable[rateId].numRateAttempt += nSuccessfulMpdus + nFailedMpdus;
+  AddRateAttempts (station, nSuccessfulMpdus, nSuccessfulMpdus + nFailedMpdus);
 
   if (nSuccessfulMpdus == 0 && station->m_longRetry < CountRetries (station))
     {
@@ -692,6 +666,21 @@ MinstrelHtWifiManager::DoReportAmpduTxStatus (WifiRemoteStation *st, uint8_t nSu
     }
 }
 
+void
+MinstrelHtWifiManager::AddRateAttempts (MinstrelHtWifiRemoteStation *station, uint32_t nSuccess, uint32_t nAttempts)
+{
+  NS_LOG_FUNCTION (this << station << nSuccess << nAttempts);
+  uint8_t rateId = GetRateId (station->m_txrate);
+  uint8_t groupId = GetGroupId (station->m_txrate);
+  HtRateInfo &rate = station->m_groupsTable[groupId].m_ratesTable[rateId];
+  if (rate.numRateAttempt == 0 && nAttempts > 0)
+    {
+      station->m_attemptedRates.push_back (station->m_txrate);
+    }
+  rate.numRateSuccess += nSuccess;
+  rate.numRateAttempt += nAttempts;
+}
+
 void
 MinstrelHtWifiManager::UpdateRate (MinstrelHtWifiRemoteStation *station)
 {
@@ -1098,7 +1087,7 @@ MinstrelHtWifiManager::FindRate (MinstrelHtWifiRemoteStation *station)
            * Also do not sample if the probability is already higher than 95%
            * to avoid wasting airtime.
            */
-          HtRateInfo sampleRateInfo = station->m_groupsTable[sampleGroupId].m_ratesTable[sampleRateId];
+          const HtRateInfo &sampleRateInfo = station->m_groupsTable[sampleGroupId].m_ratesTable[sampleRateId];
 
           NS_LOG_DEBUG ("Use sample rate? MaxTpRate= " << station->m_maxTpRate << " CurrentRate= " << station->m_txrate <<
                         " SampleRate= " << sampleIdx << " SampleProb= " << sampleRateInfo.ewmaProb);
@@ -1143,7 +1132,7 @@ MinstrelHtWifiManager::FindRate (MinstrelHtWifiRemoteStation *station)
               else
                 {
                   station->m_numSamplesSlow++;
-                  if (sampleRateInfo.numSamplesSkipped >= 20 && station->m_numSamplesSlow <= 2)
+                  if (station->m_numStatsUpdates - sampleRateInfo.lastAttemptedUpdate >= 20 && station->m_numSamplesSlow <= 2)
                     {
                       /// Set flag that we are currently sampling.
                       station->m_isSampling = true;
@@ -1175,6 +1164,7 @@ MinstrelHtWifiManager::UpdateStats (MinstrelHtWifiRemoteStation *station)
   NS_LOG_FUNCTION (this << station);
 
   station->m_nextStatsUpdate = Simulator::Now () + m_updateStats;
+  station->m_numStatsUpdates++;
 
   station->m_numSamplesSlow = 0;
   station->m_sampleCount = 0;
@@ -1194,81 +1184,102 @@ MinstrelHtWifiManager::UpdateStats (MinstrelHtWifiRemoteStation *station)
   station->m_maxTpRate2 = GetLowestIndex (station);
   station->m_maxProbRate = GetLowestIndex (station);
 
-  /// Update throughput and EWMA for each rate inside each group.
+  /// (Re)Initialize the rate indexes of each group.
   for (uint8_t j = 0; j < m_numGroups; j++)
     {
       if (station->m_groupsTable[j].m_supported)
         {
           station->m_sampleCount++;
 
-          /* (re)Initialize group rate indexes */
           station->m_groupsTable[j].m_maxTpRate = GetLowestIndex (station, j);
           station->m_groupsTable[j].m_maxTpRate2 = GetLowestIndex (station, j);
           station->m_groupsTable[j].m_maxProbRate = GetLowestIndex (station, j);
+        }
+    }
 
-          for (uint8_t i = 0; i < m_numRates; i++)
-            {
-              if (station->m_groupsTable[j].m_ratesTable[i].supported)
-                {
-                  station->m_groupsTable[j].m_ratesTable[i].retryUpdated = false;
+  for (std::vector<uint16_t>::const_iterator it = station->m_retryUpdatedRates.begin (); it != station->m_retryUpdatedRates.end (); it++)
+    {
+      station->m_groupsTable[GetGroupId (*it)].m_ratesTable[GetRateId (*it)].retryUpdated = false;
+    }
+  station->m_retryUpdatedRates.clear ();
 
-                  NS_LOG_DEBUG (+i << " " << GetMcsSupported (station, station->m_groupsTable[j].m_ratesTable[i].mcsIndex) <<
-                                "\t attempt=" << station->m_groupsTable[j].m_ratesTable[i].numRateAttempt <<
-                                "\t success=" << station->m_groupsTable[j].m_ratesTable[i].numRateSuccess);
+  /// The rates without attempts during this interval only have their last counters reset.
+  for (std::vector<uint16_t>::const_iterator it = station->m_prevAttemptedRates.begin (); it != station->m_prevAttemptedRates.end (); it++)
+    {
+      HtRateInfo &rate = station->m_groupsTable[GetGroupId (*it)].m_ratesTable[GetRateId (*it)];
+      rate.prevNumRateSuccess = 0;
+      rate.prevNumRateAttempt = 0;
+    }
+  station->m_prevAttemptedRates.clear ();
 
-                  /// If we've attempted something.
-                  if (station->m_groupsTable[j].m_ratesTable[i].numRateAttempt > 0)
-                    {
-                      station->m_groupsTable[j].m_ratesTable[i].numSamplesSkipped = 0;
-                      /**
-                       * Calculate the probability of success.
-                       * Assume probability scales from 0 to 100.
-                       */
-                      tempProb = (100 * station->m_groupsTable[j].m_ratesTable[i].numRateSuccess) / station->m_groupsTable[j].m_ratesTable[i].numRateAttempt;
+  /// Update throughput and EWMA for each rate with attempts.
+  for (std::vector<uint16_t>::const_iterator it = station->m_attemptedRates.begin (); it != station->m_attemptedRates.end (); it++)
+    {
+      uint8_t j = GetGroupId (*it);
+      uint8_t i = GetRateId (*it);
+      HtRateInfo &rate = station->m_groupsTable[j].m_ratesTable[i];
+      if (!station->m_groupsTable[j].m_supported || !rate.supported)
+        {
+          continue;
+        }
 
-                      /// Bookkeeping.
-                      station->m_groupsTable[j].m_ratesTable[i].prob = tempProb;
+      NS_LOG_DEBUG (+i << " " << GetMcsSupported (station, rate.mcsIndex) <<
+                    "\t attempt=" << rate.numRateAttempt <<
+                    "\t success=" << rate.numRateSuccess);
 
-                      if (station->m_groupsTable[j].m_ratesTable[i].successHist == 0)
-                        {
-                          station->m_groupsTable[j].m_ratesTable[i].ewmaProb = tempProb;
-                        }
-                      else
-                        {
-                          station->m_groupsTable[j].m_ratesTable[i].ewmsdProb = CalculateEwmsd (station->m_groupsTable[j].m_ratesTable[i].ewmsdProb,
-                                                                                                tempProb, station->m_groupsTable[j].m_ratesTable[i].ewmaProb,
-                                                                                                m_ewmaLevel);
-                          /// EWMA probability
-                          tempProb = (tempProb * (100 - m_ewmaLevel) + station->m_groupsTable[j].m_ratesTable[i].ewmaProb * m_ewmaLevel)  / 100;
-                          station->m_groupsTable[j].m_ratesTable[i].ewmaProb = tempProb;
-                        }
+      rate.lastAttemptedUpdate = station->m_numStatsUpdates;
+      /**
+       * Calculate the probability of success.
+       * Assume probability scales from 0 to 100.
+       */
+      tempProb = (100 * rate.numRateSuccess) / rate.numRateAttempt;
 
-                      station->m_groupsTable[j].m_ratesTable[i].throughput = CalculateThroughput (station, j, i, tempProb);
+      /// Bookkeeping.
+      rate.prob = tempProb;
 
-                      station->m_groupsTable[j].m_ratesTable[i].successHist += station->m_groupsTable[j].m_ratesTable[i].numRateSuccess;
-                      station->m_groupsTable[j].m_ratesTable[i].attemptHist += station->m_groupsTable[j].m_ratesTable[i].numRateAttempt;
-                    }
-                  else
-                    {
-                      station->m_groupsTable[j].m_ratesTable[i].numSamplesSkipped++;
-                    }
+      if (rate.successHist == 0)
+        {
+          rate.ewmaProb = tempProb;
+        }
+      else
+        {
+          rate.ewmsdProb = CalculateEwmsd (rate.ewmsdProb, tempProb, rate.ewmaProb, m_ewmaLevel);
+          /// EWMA probability
+          tempProb = (tempProb * (100 - m_ewmaLevel) + rate.ewmaProb * m_ewmaLevel)  / 100;
+          rate.ewmaProb = tempProb;
+        }
 
-                  /// Bookkeeping.
-                  station->m_groupsTable[j].m_ratesTable[i].prevNumRateSuccess = station->m_groupsTable[j].m_ratesTable[i].numRateSuccess;
-                  station->m_groupsTable[j].m_ratesTable[i].prevNumRateAttempt = station->m_groupsTable[j].m_ratesTable[i].numRateAttempt;
-                  station->m_groupsTable[j].m_ratesTable[i].numRateSuccess = 0;
-                  station->m_groupsTable[j].m_ratesTable[i].numRateAttempt = 0;
+      rate.throughput = CalculateThroughput (station, j, i, tempProb);
 
-                  if (station->m_groupsTable[j].m_ratesTable[i].throughput != 0)
-                    {
-                      SetBestStationThRates (station, GetIndex (j, i));
-                      SetBestProbabilityRate (station, GetIndex (j, i));
-                    }
+      rate.successHist += rate.numRateSuccess;
+      rate.attemptHist += rate.numRateAttempt;
 
-                }
-            }
+      /// Bookkeeping.
+      rate.prevNumRateSuccess = rate.numRateSuccess;
+      rate.prevNumRateAttempt = rate.numRateAttempt;
+      rate.numRateSuccess = 0;
+      rate.numRateAttempt = 0;
+      station->m_prevAttemptedRates.push_back (*it);
+
+      std::vector<uint16_t>::iterator pos = std::lower_bound (station->m_ratesWithThroughput.begin (), station->m_ratesWithThroughput.end (), *it);
+      bool listed = (pos != station->m_ratesWithThroughput.end () && *pos == *it);
+      if (rate.throughput != 0 && !listed)
+        {
+          station->m_ratesWithThroughput.insert (pos, *it);
+        }
+      else if (rate.throughput == 0 && listed)
+        {
+          station->m_ratesWithThroughput.erase (pos);
         }
     }
+  station->m_attemptedRates.clear ();
+
+  /// Select the best rates, visiting the rates in increasing index order.
+  for (std::vector<uint16_t>::const_iterator it = station->m_ratesWithThroughput.begin (); it != station->m_ratesWithThroughput.end (); it++)
+    {
+      SetBestStationThRates (station, *it);
+      SetBestProbabilityRate (station, *it);
+    }
 
   //Try to sample all available rates during each interval.
   station->m_sampleCount *= 8;
@@ -1319,7 +1330,6 @@ void
 MinstrelHtWifiManager::SetBestProbabilityRate (MinstrelHtWifiRemoteStation *station, uint16_t index)
 {
   GroupInfo *group;
-  HtRateInfo rate;
   uint8_t tmpGroupId, tmpRateId;
   double tmpTh, tmpProb;
   uint8_t groupId, rateId;
@@ -1331,7 +1341,7 @@ MinstrelHtWifiManager::SetBestProbabilityRate (MinstrelHtWifiRemoteStation *stat
   groupId = GetGroupId (index);
   rateId = GetRateId (index);
   group = &station->m_groupsTable[groupId];
-  rate = group->m_ratesTable[rateId];
+  const HtRateInfo &rate = group->m_ratesTable[rateId];
 
   tmpGroupId = GetGroupId (station->m_maxProbRate);
   tmpRateId = GetRateId (station->m_maxProbRate);
@@ -1441,6 +1451,10 @@ MinstrelHtWifiManager::RateInit (MinstrelHtWifiRemoteStation *station)
   NS_LOG_FUNCTION (this << station);
 
   station->m_groupsTable = McsGroupData (m_numGroups);
+  station->m_attemptedRates.clear ();
+  station->m_prevAttemptedRates.clear ();
+  station->m_ratesWithThroughput.clear ();
+  station->m_retryUpdatedRates.clear ();
 
   /**
   * Initialize groups supported by the receiver.
@@ -1499,7 +1513,7 @@ MinstrelHtWifiManager::RateInit (MinstrelHtWifiRemoteStation *station)
                       station->m_groupsTable[groupId].m_ratesTable[rateId].ewmaProb = 0;
                       station->m_groupsTable[groupId].m_ratesTable[rateId].prevNumRateAttempt = 0;
                       station->m_groupsTable[groupId].m_ratesTable[rateId].prevNumRateSuccess = 0;
-                      station->m_groupsTable[groupId].m_ratesTable[rateId].numSamplesSkipped = 0;
+                      station->m_groupsTable[groupId].m_ratesTable[rateId].lastAttemptedUpdate = station->m_numStatsUpdates;
                       station->m_groupsTable[groupId].m_ratesTable[rateId].successHist = 0;
                       station->m_groupsTable[groupId].m_ratesTable[rateId].attemptHist = 0;
                       station->m_groupsTable[groupId].m_ratesTable[rateId].throughput = 0;
@@ -1547,6 +1561,10 @@ MinstrelHtWifiManager::CalculateRetransmits (MinstrelHtWifiRemoteStation *statio
   else
     {
       station->m_groupsTable[groupId].m_ratesTable[rateId].retryCount = 2;
+      if (!station->m_groupsTable[groupId].m_ratesTable[rateId].retryUpdated)
+        {
+          station->m_retryUpdatedRates.push_back (GetIndex (groupId, rateId));
+        }
       station->m_groupsTable[groupId].m_ratesTable[rateId].retryUpdated = true;
 
       dataTxTime = GetFirstMpduTxTime (groupId, GetMcsSupported (station, station->m_groupsTable[groupId].m_ratesTable[rateId].mcsIndex)) +
@@ -29,6 +29,8 @@
 #include "wifi-remote-station-manager.h"
 #include "minstrel-wifi-manager.h"
 
+class MinstrelHtTestManager;
+
 namespace ns3 {
 
 /**
@@ -61,7 +63,6 @@ struct McsGroup
  */
 typedef std::vector<McsGroup> MinstrelMcsGroups;
 
-struct MinstrelHtWifiRemoteStation;
 /**
  * A struct to contain all statistics information related to a data rate.
  */
@@ -89,7 +90,12 @@ struct HtRateInfo
   double ewmsdProb;             //!< Exponential weighted moving standard deviation of probability.
   uint32_t prevNumRateAttempt;  //!< Number of transmission attempts with previous rate.
   uint32_t prevNumRateSuccess;  //!< Number of successful frames transmitted with previous rate.
-  uint32_t numSamplesSkipped;   //!< Number of times this rate statistics were not updated because no attempts have been made.
+  /**
+   * Number of statistics updates of the station when attempts were last made at this rate.
+   * The number of times this rate statistics were not updated because no attempts have
+   * been made is the difference with the current number of statistics updates.
+   */
+  uint32_t lastAttemptedUpdate;
   uint64_t successHist;         //!< Aggregate of all transmission successes.
   uint64_t attemptHist;         //!< Aggregate of all transmission attempts.
   double throughput;            //!< Throughput of this rate (in pkts per second).
@@ -136,6 +142,31 @@ static const uint8_t MAX_VHT_GROUP_RATES = 10;   //!< Number of rates (or MCS) p
 static const uint8_t MAX_HT_WIDTH = 40;          //!< Maximal channel width.
 static const uint8_t MAX_VHT_WIDTH = 160;        //!< Maximal channel width.
 
+///MinstrelHtWifiRemoteStation structure
+struct MinstrelHtWifiRemoteStation : MinstrelWifiRemoteStation
+{
+  uint8_t m_sampleGroup;     //!< The group that the sample rate belongs to.
+
+  uint32_t m_sampleWait;      //!< How many transmission attempts to wait until a new sample.
+  uint32_t m_sampleTries;     //!< Number of sample tries after waiting sampleWait.
+  uint32_t m_sampleCount;     //!< Max number of samples per update interval.
+  uint32_t m_numSamplesSlow;  //!< Number of times a slow rate was sampled.
+
+  uint32_t m_avgAmpduLen;      //!< Average number of MPDUs in an A-MPDU.
+  uint32_t m_ampduLen;         //!< Number of MPDUs in an A-MPDU.
+  uint32_t m_ampduPacketCount; //!< Number of A-MPDUs transmitted.
+
+  McsGroupData m_groupsTable;  //!< Table of groups with stats.
+  uint32_t m_numStatsUpdates;  //!< Number of statistics updates so far.
+  std::vector<uint16_t> m_attemptedRates;      //!< Rates with attempts since the last statistics update.
+  std::vector<uint16_t> m_prevAttemptedRates;  //!< Rates with attempts during the previous statistics interval.
+  std::vector<uint16_t> m_ratesWithThroughput; //!< Rates with a non-zero throughput, in increasing index order.
+  std::vector<uint16_t> m_retryUpdatedRates;   //!< Rates whose retry count was updated since the last statistics update.
+  bool m_isHt;                 //!< If the station is HT capable.
+
+  std::ofstream m_statsFile;   //!< File where statistics table is written.
+};
+
 /**
  * \brief Implementation of Minstrel HT Rate Control Algorithm
  * \ingroup wifi
@@ -183,6 +214,8 @@ static const uint8_t MAX_VHT_WIDTH = 160;        //!< Maximal channel width.
 class MinstrelHtWifiManager : public WifiRemoteStationManager
 {
 public:
+  /// Allow test cases to access private members
+  friend class ::MinstrelHtTestManager;
   /**
    * \brief Get the type ID.
    * \return the object TypeId
@@ -323,6 +356,16 @@ private:
    */
   void UpdatePacketCounters (MinstrelHtWifiRemoteStation *station, uint8_t nSuccessfulMpdus, uint8_t nFailedMpdus);
 
+  /**
+   * Update the success and attempt counters of the rate in use, and keep
+   * track of the rates with attempts since the last statistics update.
+   *
+   * \param station the wifi remote station
+   * \param nSuccess the number of successful transmissions
+   * \param nAttempts the number of transmission attempts
+   */
+  void AddRateAttempts (MinstrelHtWifiRemoteStation *station, uint32_t nSuccess, uint32_t nAttempts);
+
   /**
    * Getting the next sample from Sample Table.
    *
@@ -349,6 +392,11 @@ private:
   /**
    * Updating the Minstrel Table every 1/10 seconds.
    *
+   * Only the statistics of the rates with attempts since the last update
+   * change, hence the other rates are not visited, and the best rates are
+   * selected among the rates with a non-zero throughput only. The result
+   * is the same as visiting all the rates in index order.
+   *
    * \param station the minstrel HT wifi remote station
    */
   void UpdateStats (MinstrelHtWifiRemoteStation *station);
@@ -19,7 +19,9 @@
  *          Sébastien Deronne <sebastien.deronne@gmail.com>
  */
 
+#include <map>
 #include "ns3/log.h"
+#include "ns3/boolean.h"
 #include "nist-error-rate-model.h"
 #include "dsss-error-rate-model.h"
 #include "wifi-phy.h"
@@ -37,11 +39,20 @@ NistErrorRateModel::GetTypeId (void)
     .SetParent<ErrorRateModel> ()
     .SetGroupName ("Wifi")
     .AddConstructor<NistErrorRateModel> ()
+    .AddAttribute ("Tabulated",
+                   "If true, the success rate of OFDM chunks is interpolated "
+                   "from tables of the success rate of a single bit, which are "
+                   "computed once per mode and shared by all the models. "
+                   "Otherwise, it is computed analytically for every chunk.",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&NistErrorRateModel::m_tabulated),
+                   MakeBooleanChecker ())
   ;
   return tid;
 }
 
 NistErrorRateModel::NistErrorRateModel ()
+  : m_tabulated (false)
 {
 }
 
@@ -277,6 +288,40 @@ double
 NistErrorRateModel::GetChunkSuccessRate (WifiMode mode, WifiTxVector txVector, double snr, uint64_t nbits) const
 {
   NS_LOG_FUNCTION (this << mode << txVector.GetMode () << snr << nbits);
+  if (m_tabulated
+      && mode.GetModulationClass () != WIFI_MOD_CLASS_DSSS
+      && mode.GetModulationClass () != WIFI_MOD_CLASS_HR_DSSS
+      && ErrorRateTable::IsInRange (snr))
+    {
+      return GetTable (mode, txVector).GetChunkSuccessRate (snr, nbits);
+    }
+  return CalculateChunkSuccessRate (mode, txVector, snr, nbits);
+}
+
+const ErrorRateTable &
+NistErrorRateModel::GetTable (WifiMode mode, WifiTxVector txVector) const
+{
+  typedef std::map<uint32_t, ErrorRateTable> Tables;
+  static Tables tables;
+  uint32_t key = mode.GetUid ();
+  Tables::const_iterator it = tables.find (key);
+  if (it == tables.end ())
+    {
+      NS_LOG_DEBUG ("Build error rate table for " << mode);
+      std::vector<double> successRates;
+      successRates.reserve (ErrorRateTable::GetNSamples ());
+      for (uint32_t i = 0; i < ErrorRateTable::GetNSamples (); i++)
+        {
+          successRates.push_back (CalculateChunkSuccessRate (mode, txVector, ErrorRateTable::GetSnr (i), 1));
+        }
+      it = tables.insert (std::make_pair (key, ErrorRateTable (successRates))).first;
+    }
+  return it->second;
+}
+
+double
+NistErrorRateModel::CalculateChunkSuccessRate (WifiMode mode, WifiTxVector txVector, double snr, uint64_t nbits) const
+{
   if (mode.GetModulationClass () == WIFI_MOD_CLASS_ERP_OFDM
       || mode.GetModulationClass () == WIFI_MOD_CLASS_OFDM
       || mode.GetModulationClass () == WIFI_MOD_CLASS_HT
@@ -22,6 +22,7 @@
 #define NIST_ERROR_RATE_MODEL_H
 
 #include "error-rate-model.h"
+#include "error-rate-table.h"
 
 namespace ns3 {
 
@@ -48,6 +49,28 @@ public:
 
 
 private:
+  /**
+   * Compute the success rate of a chunk with the analytic model.
+   *
+   * \param mode the Wi-Fi mode applicable to this chunk
+   * \param txVector TXVECTOR of the overall transmission
+   * \param snr the SNR of the chunk
+   * \param nbits the number of bits in this chunk
+   *
+   * \return probability of successfully receiving the chunk
+   */
+  double CalculateChunkSuccessRate (WifiMode mode, WifiTxVector txVector, double snr, uint64_t nbits) const;
+  /**
+   * Get the table of the success rate of a single bit for the given mode,
+   * creating it if needed. The tables are shared by all the instances of
+   * this model.
+   *
+   * \param mode the Wi-Fi mode
+   * \param txVector TXVECTOR of the overall transmission
+   *
+   * \return the table for the given mode
+   */
+  const ErrorRateTable & GetTable (WifiMode mode, WifiTxVector txVector) const;
   /**
    * Return the coded BER for the given p and b.
    *
@@ -167,6 +190,8 @@ private:
    */
   double GetFec1024QamBer (double snr, uint64_t nbits,
                            uint32_t bValue) const;
+
+  bool m_tabulated; //!< whether the success rate of OFDM chunks is interpolated from tables
 };
 
 } //namespace ns3
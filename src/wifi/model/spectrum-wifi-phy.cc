@@ -39,6 +39,9 @@ NS_LOG_COMPONENT_DEFINE ("SpectrumWifiPhy");
 
 NS_OBJECT_ENSURE_REGISTERED (SpectrumWifiPhy);
 
+/// Maximum number of Tx PSDs kept by a SpectrumWifiPhy
+static const std::size_t MAX_TX_PSD_CACHE_SIZE = 32;
+
 TypeId
 SpectrumWifiPhy::GetTypeId (void)
 {
@@ -74,6 +77,8 @@ SpectrumWifiPhy::DoDispose (void)
   NS_LOG_FUNCTION (this);
   m_channel = 0;
   m_wifiSpectrumPhyInterface = 0;
+  m_txPsdCache.clear ();
+  m_rxFilter = 0;
   WifiPhy::DoDispose ();
 }
 
@@ -140,6 +145,7 @@ SpectrumWifiPhy::ResetSpectrumModel (void)
   // Replace existing spectrum model with new one, and must call AddRx ()
   // on the SpectrumChannel to provide this new spectrum model to it
   m_rxSpectrumModel = WifiSpectrumValueHelper::GetSpectrumModel (GetFrequency (), channelWidth, GetBandBandwidth (), GetGuardBandwidth (channelWidth));
+  m_rxFilter = 0;
   m_channel->AddRx (m_wifiSpectrumPhyInterface);
 }
 
@@ -230,12 +236,10 @@ SpectrumWifiPhy::StartRx (Ptr<SpectrumSignalParameters> rxParams)
   // Integrate over our receive bandwidth (i.e., all that the receive
   // spectral mask representing our filtering allows) to find the
   // total energy apparent to the "demodulator".
-  uint16_t channelWidth = GetChannelWidth ();
-  Ptr<SpectrumValue> filter = WifiSpectrumValueHelper::CreateRfFilter (GetFrequency (), channelWidth, GetBandBandwidth (), GetGuardBandwidth (channelWidth));
-  SpectrumValue filteredSignal = (*filter) * (*receivedSignalPsd);
+  double filteredPowerW = GetFilteredPower (receivedSignalPsd);
   // Add receiver antenna gain
-  NS_LOG_DEBUG ("Signal power received (watts) before antenna gain: " << Integral (filteredSignal));
-  double rxPowerW = Integral (filteredSignal) * DbToRatio (GetRxGain ());
+  NS_LOG_DEBUG ("Signal power received (watts) before antenna gain: " << filteredPowerW);
+  double rxPowerW = filteredPowerW * DbToRatio (GetRxGain ());
   NS_LOG_DEBUG ("Signal power received after antenna gain: " << rxPowerW << " W (" << WToDbm (rxPowerW) << " dBm)");
 
   Ptr<WifiSpectrumSignalParameters> wifiRxParams = DynamicCast<WifiSpectrumSignalParameters> (rxParams);
@@ -314,6 +318,52 @@ SpectrumWifiPhy::GetTxPowerSpectralDensity (uint16_t centerFrequency, uint16_t c
   return v;
 }
 
+Ptr<SpectrumValue>
+SpectrumWifiPhy::GetCachedTxPowerSpectralDensity (uint16_t centerFrequency, uint16_t channelWidth, double txPowerW, WifiModulationClass modulationClass)
+{
+  NS_LOG_FUNCTION (this << centerFrequency << channelWidth << txPowerW << modulationClass);
+  TxPsdKey key = std::make_tuple (centerFrequency, channelWidth, modulationClass, txPowerW);
+  std::map<TxPsdKey, Ptr<SpectrumValue> >::const_iterator it = m_txPsdCache.find (key);
+  if (it != m_txPsdCache.end ())
+    {
+      return it->second;
+    }
+  Ptr<SpectrumValue> v = GetTxPowerSpectralDensity (centerFrequency, channelWidth, txPowerW, modulationClass);
+  if (m_txPsdCache.size () >= MAX_TX_PSD_CACHE_SIZE)
+    {
+      // e.g., the Tx power changes with every frame: start over rather than
+      // keeping the PSDs of all the powers used so far
+      m_txPsdCache.clear ();
+    }
+  m_txPsdCache.insert (std::make_pair (key, v));
+  return v;
+}
+
+double
+SpectrumWifiPhy::GetFilteredPower (Ptr<const SpectrumValue> psd)
+{
+  NS_LOG_FUNCTION (this << psd);
+  if (m_rxFilter == 0 || m_rxFilter->GetSpectrumModelUid () != psd->GetSpectrumModelUid ())
+    {
+      uint16_t channelWidth = GetChannelWidth ();
+      m_rxFilter = WifiSpectrumValueHelper::CreateRfFilter (GetFrequency (), channelWidth, GetBandBandwidth (), GetGuardBandwidth (channelWidth));
+    }
+  NS_ASSERT (m_rxFilter->GetSpectrumModelUid () == psd->GetSpectrumModelUid ());
+  // same as Integral ((*m_rxFilter) * (*psd)), without the temporary SpectrumValue
+  double powerW = 0;
+  Values::const_iterator fit = m_rxFilter->ConstValuesBegin ();
+  Values::const_iterator vit = psd->ConstValuesBegin ();
+  Bands::const_iterator bit = psd->ConstBandsBegin ();
+  while (vit != psd->ConstValuesEnd ())
+    {
+      powerW += ((*fit) * (*vit)) * (bit->fh - bit->fl);
+      ++fit;
+      ++vit;
+      ++bit;
+    }
+  return powerW;
+}
+
 uint16_t
 SpectrumWifiPhy::GetCenterFrequencyForChannelWidth (WifiTxVector txVector) const
 {
@@ -334,7 +384,7 @@ SpectrumWifiPhy::StartTx (Ptr<Packet> packet, WifiTxVector txVector, Time txDura
 {
   NS_LOG_DEBUG ("Start transmission: signal power before antenna gain=" << GetPowerDbm (txVector.GetTxPowerLevel ()) << "dBm");
   double txPowerWatts = DbmToW (GetPowerDbm (txVector.GetTxPowerLevel ()) + GetTxGain ());
-  Ptr<SpectrumValue> txPowerSpectrum = GetTxPowerSpectralDensity (GetCenterFrequencyForChannelWidth (txVector), txVector.GetChannelWidth (), txPowerWatts, txVector.GetMode ().GetModulationClass ());
+  Ptr<SpectrumValue> txPowerSpectrum = GetCachedTxPowerSpectralDensity (GetCenterFrequencyForChannelWidth (txVector), txVector.GetChannelWidth (), txPowerWatts, txVector.GetMode ().GetModulationClass ());
   Ptr<WifiSpectrumSignalParameters> txParams = Create<WifiSpectrumSignalParameters> ();
   txParams->duration = txDuration;
   txParams->psd = txPowerSpectrum;
@@ -29,7 +29,10 @@
 #include "ns3/antenna-model.h"
 #include "ns3/spectrum-channel.h"
 #include "ns3/spectrum-model.h"
+#include "ns3/spectrum-value.h"
 #include "wifi-phy.h"
+#include <map>
+#include <tuple>
 
 namespace ns3 {
 
@@ -203,6 +206,30 @@ private:
    * to the standard in use.
    */
   Ptr<SpectrumValue> GetTxPowerSpectralDensity (uint16_t centerFrequency, uint16_t channelWidth, double txPowerW, WifiModulationClass modulationClass) const;
+  /**
+   * \param centerFrequency center frequency (MHz)
+   * \param channelWidth channel width (MHz) of the channel for the current transmission
+   * \param txPowerW power in W to spread across the bands
+   * \param modulationClass the modulation class
+   * \return Ptr to SpectrumValue
+   *
+   * Return the Tx PSD computed by GetTxPowerSpectralDensity for the given
+   * parameters, which is only computed the first time it is needed. The same
+   * SpectrumValue is returned for all the transmissions using the same
+   * parameters, hence it must not be modified (the spectrum channels work
+   * on copies of the transmitted PSD). The cache is emptied when it is full,
+   * so that its size stays bounded when the Tx power varies (e.g., with
+   * power control).
+   */
+  Ptr<SpectrumValue> GetCachedTxPowerSpectralDensity (uint16_t centerFrequency, uint16_t channelWidth, double txPowerW, WifiModulationClass modulationClass);
+  /**
+   * \param psd the PSD of a received signal
+   * \return the power (W) of the signal within the receive filter, before antenna gain
+   *
+   * The RF filter is only recreated when the receive spectrum model changes,
+   * and the filtered PSD is integrated without being allocated.
+   */
+  double GetFilteredPower (Ptr<const SpectrumValue> psd);
 
   /**
    * Perform run-time spectrum model change
@@ -218,6 +245,11 @@ private:
   bool m_disableWifiReception;          //!< forces this Phy to fail to sync on any signal
   TracedCallback<bool, uint32_t, double, Time> m_signalCb; //!< Signal callback
 
+  /// center frequency, channel width, modulation class and power of a Tx PSD
+  typedef std::tuple<uint16_t, uint16_t, WifiModulationClass, double> TxPsdKey;
+  std::map<TxPsdKey, Ptr<SpectrumValue> > m_txPsdCache; //!< Tx PSDs already computed
+  Ptr<const SpectrumValue> m_rxFilter; //!< RF filter for the current receive spectrum model
+
 };
 
 } //namespace ns3
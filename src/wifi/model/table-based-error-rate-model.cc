@@ -0,0 +1,194 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <cmath>
+#include <fstream>
+#include <sstream>
+#include <algorithm>
+#include "ns3/log.h"
+#include "ns3/abort.h"
+#include "ns3/string.h"
+#include "ns3/uinteger.h"
+#include "ns3/pointer.h"
+#include "table-based-error-rate-model.h"
+#include "nist-error-rate-model.h"
+#include "wifi-tx-vector.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("TableBasedErrorRateModel");
+
+NS_OBJECT_ENSURE_REGISTERED (TableBasedErrorRateModel);
+
+TypeId
+TableBasedErrorRateModel::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::TableBasedErrorRateModel")
+    .SetParent<ErrorRateModel> ()
+    .SetGroupName ("Wifi")
+    .AddConstructor<TableBasedErrorRateModel> ()
+    .AddAttribute ("TableFile",
+                   "The name of the file to read the SNR to PER tables from, "
+                   "which replace the tables previously set. "
+                   "Each line has the format \"<mode> <SNR (dB)> <PER>\".",
+                   StringValue (""),
+                   MakeStringAccessor (&TableBasedErrorRateModel::SetTableFile,
+                                       &TableBasedErrorRateModel::GetTableFile),
+                   MakeStringChecker ())
+    .AddAttribute ("ReferenceSize",
+                   "The frame size (bytes) the PERs of the tables refer to.",
+                   UintegerValue (1500),
+                   MakeUintegerAccessor (&TableBasedErrorRateModel::m_referenceSize),
+                   MakeUintegerChecker<uint32_t> (1))
+    .AddAttribute ("FallbackErrorRateModel",
+                   "The error rate model of the modes without a table. "
+                   "A NistErrorRateModel is used if not set.",
+                   PointerValue (),
+                   MakePointerAccessor (&TableBasedErrorRateModel::m_fallback),
+                   MakePointerChecker<ErrorRateModel> ())
+  ;
+  return tid;
+}
+
+TableBasedErrorRateModel::TableBasedErrorRateModel ()
+  : m_referenceSize (1500),
+    m_fallback (CreateObject<NistErrorRateModel> ())
+{
+  NS_LOG_FUNCTION (this);
+}
+
+TableBasedErrorRateModel::~TableBasedErrorRateModel ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+void
+TableBasedErrorRateModel::SetTableFile (std::string fileName)
+{
+  NS_LOG_FUNCTION (this << fileName);
+  m_tableFile = fileName;
+  m_tables.clear ();
+  if (!fileName.empty ())
+    {
+      LoadTables (fileName);
+    }
+}
+
+std::string
+TableBasedErrorRateModel::GetTableFile (void) const
+{
+  return m_tableFile;
+}
+
+void
+TableBasedErrorRateModel::LoadTables (std::string fileName)
+{
+  NS_LOG_FUNCTION (this << fileName);
+  std::ifstream file (fileName.c_str ());
+  if (!file.is_open ())
+    {
+      NS_FATAL_ERROR ("Could not open the error rate table file " << fileName);
+    }
+  std::string line;
+  uint32_t lineNumber = 0;
+  while (std::getline (file, line))
+    {
+      lineNumber++;
+      std::istringstream iss (line);
+      std::string name;
+      if (!(iss >> name) || name[0] == '#')
+        {
+          continue;
+        }
+      double snrDb, per;
+      if (!(iss >> snrDb >> per) || per < 0 || per > 1)
+        {
+          NS_FATAL_ERROR ("Invalid line " << lineNumber << " in the error rate table file " << fileName);
+        }
+      AddPoint (WifiMode (name), snrDb, per);
+    }
+}
+
+bool
+TableBasedErrorRateModel::IsBelow (const Point &point, double snrDb)
+{
+  return point.snrDb < snrDb;
+}
+
+void
+TableBasedErrorRateModel::AddPoint (WifiMode mode, double snrDb, double per)
+{
+  NS_LOG_FUNCTION (this << mode << snrDb << per);
+  NS_ASSERT (per >= 0 && per <= 1);
+  uint32_t uid = mode.GetUid ();
+  if (uid >= m_tables.size ())
+    {
+      m_tables.resize (uid + 1);
+    }
+  std::vector<Point> &table = m_tables[uid];
+  Point point;
+  point.snrDb = snrDb;
+  point.per = per;
+  table.insert (std::lower_bound (table.begin (), table.end (), snrDb, &IsBelow), point);
+}
+
+bool
+TableBasedErrorRateModel::HasTable (WifiMode mode) const
+{
+  return mode.GetUid () < m_tables.size () && !m_tables[mode.GetUid ()].empty ();
+}
+
+double
+TableBasedErrorRateModel::GetPer (WifiMode mode, double snrDb) const
+{
+  NS_ASSERT (HasTable (mode));
+  const std::vector<Point> &table = m_tables[mode.GetUid ()];
+  std::vector<Point>::const_iterator high = std::lower_bound (table.begin (), table.end (), snrDb, &IsBelow);
+  if (high == table.begin ())
+    {
+      return high->per;
+    }
+  if (high == table.end ())
+    {
+      return table.back ().per;
+    }
+  std::vector<Point>::const_iterator low = high - 1;
+  return low->per + (snrDb - low->snrDb) * (high->per - low->per) / (high->snrDb - low->snrDb);
+}
+
+double
+TableBasedErrorRateModel::GetChunkSuccessRate (WifiMode mode, WifiTxVector txVector, double snr, uint64_t nbits) const
+{
+  NS_LOG_FUNCTION (this << mode << txVector.GetMode () << snr << nbits);
+  if (!HasTable (mode))
+    {
+      NS_ABORT_MSG_IF (m_fallback == 0, "No table for mode " << mode << " and no FallbackErrorRateModel");
+      return m_fallback->GetChunkSuccessRate (mode, txVector, snr, nbits);
+    }
+  if (nbits == 0)
+    {
+      return 1.0;
+    }
+  double per = GetPer (mode, 10.0 * std::log10 (snr));
+  if (per >= 1.0)
+    {
+      return 0.0;
+    }
+  // the chunk is a fraction nbits / L of a frame of the reference size
+  return std::exp (std::log1p (-per) * nbits / (m_referenceSize * 8.0));
+}
+
+} //namespace ns3
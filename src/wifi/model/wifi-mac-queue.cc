@@ -21,6 +21,7 @@
  *          Stefano Avallone <stavallo@unina.it>
  */
 
+#include <iterator>
 #include "ns3/simulator.h"
 #include "wifi-mac-queue.h"
 #include "qos-blocked-destinations.h"
@@ -74,20 +75,82 @@ WifiMacQueue::GetMaxDelay (void) const
   return m_maxDelay;
 }
 
-bool
-WifiMacQueue::TtlExceeded (ConstIterator &it)
+void
+WifiMacQueue::RemoveExpiredItems (void)
 {
   NS_LOG_FUNCTION (this);
-
-  if (Simulator::Now () > (*it)->GetTimeStamp () + m_maxDelay)
+  while (!m_expiryIndex.empty ()
+         && Simulator::Now () > m_expiryIndex.begin ()->first + m_maxDelay)
     {
       NS_LOG_DEBUG ("Removing packet that stayed in the queue for too long (" <<
-                    Simulator::Now () - (*it)->GetTimeStamp () << ")");
-      auto curr = it++;
-      DoRemove (curr);
-      return true;
+                    Simulator::Now () - m_expiryIndex.begin ()->first << ")");
+      RemoveAt (m_expiryIndex.begin ()->second);
     }
-  return false;
+}
+
+void
+WifiMacQueue::AddToIndexes (ConstIterator pos, bool atHead)
+{
+  NS_LOG_FUNCTION (this << *pos << atHead);
+  IndexEntries entries;
+  entries.expiry = m_expiryIndex.insert (std::make_pair ((*pos)->GetTimeStamp (), pos));
+  entries.qosData = (*pos)->GetHeader ().IsQosData ();
+  if (entries.qosData)
+    {
+      std::list<ConstIterator> &items = m_tidAndAddressIndex[std::make_pair ((*pos)->GetDestinationAddress (),
+                                                                             (*pos)->GetHeader ().GetQosTid ())];
+      entries.tidAndAddress = items.insert (atHead ? items.begin () : items.end (), pos);
+    }
+  bool inserted = m_indexEntries.insert (std::make_pair (PeekPointer (*pos), entries)).second;
+  NS_ASSERT_MSG (inserted, "The item is already in the queue");
+}
+
+void
+WifiMacQueue::RemoveFromIndexes (ConstIterator pos)
+{
+  NS_LOG_FUNCTION (this << *pos);
+  auto it = m_indexEntries.find (PeekPointer (*pos));
+  NS_ASSERT (it != m_indexEntries.end ());
+  m_expiryIndex.erase (it->second.expiry);
+  if (it->second.qosData)
+    {
+      auto itemsIt = m_tidAndAddressIndex.find (std::make_pair ((*pos)->GetDestinationAddress (),
+                                                                (*pos)->GetHeader ().GetQosTid ()));
+      NS_ASSERT (itemsIt != m_tidAndAddressIndex.end ());
+      itemsIt->second.erase (it->second.tidAndAddress);
+      if (itemsIt->second.empty ())
+        {
+          m_tidAndAddressIndex.erase (itemsIt);
+        }
+    }
+  m_indexEntries.erase (it);
+}
+
+Ptr<WifiMacQueueItem>
+WifiMacQueue::DequeueAt (ConstIterator pos)
+{
+  NS_LOG_FUNCTION (this);
+  RemoveFromIndexes (pos);
+  return DoDequeue (pos);
+}
+
+Ptr<WifiMacQueueItem>
+WifiMacQueue::RemoveAt (ConstIterator pos)
+{
+  NS_LOG_FUNCTION (this);
+  RemoveFromIndexes (pos);
+  return DoRemove (pos);
+}
+
+const std::list<WifiMacQueue::ConstIterator> *
+WifiMacQueue::GetTidAndAddressItems (uint8_t tid, Mac48Address dest) const
+{
+  auto it = m_tidAndAddressIndex.find (std::make_pair (dest, tid));
+  if (it == m_tidAndAddressIndex.end ())
+    {
+      return 0;
+    }
+  return &it->second;
 }
 
 bool
@@ -97,24 +160,21 @@ WifiMacQueue::Enqueue (Ptr<WifiMacQueueItem> item)
   NS_ASSERT_MSG (GetMaxSize ().GetUnit () == QueueSizeUnit::PACKETS,
                  "WifiMacQueues must be in packet mode");
 
-  // if the queue is full, remove the first stale packet (if any) encountered
-  // starting from the head of the queue, in order to make room for the new packet.
-  if (QueueBase::GetNPackets () == GetMaxSize ().GetValue ())
-    {
-      auto it = Head ();
-      while (it != Tail () && !TtlExceeded (it))
-        {
-          it++;
-        }
-    }
+  // remove the stale packets (if any) to make room for the new packet.
+  RemoveExpiredItems ();
 
   if (QueueBase::GetNPackets () == GetMaxSize ().GetValue () && m_dropPolicy == DROP_OLDEST)
     {
       NS_LOG_DEBUG ("Remove the oldest item in the queue");
-      DoRemove (Head ());
+      RemoveAt (Head ());
     }
 
-  return DoEnqueue (Tail (), item);
+  if (!DoEnqueue (Tail (), item))
+    {
+      return false;
+    }
+  AddToIndexes (std::prev (Tail ()), false);
+  return true;
 }
 
 bool
@@ -124,36 +184,31 @@ WifiMacQueue::PushFront (Ptr<WifiMacQueueItem> item)
   NS_ASSERT_MSG (GetMaxSize ().GetUnit () == QueueSizeUnit::PACKETS,
                  "WifiMacQueues must be in packet mode");
 
-  // if the queue is full, remove the first stale packet (if any) encountered
-  // starting from the head of the queue, in order to make room for the new packet.
-  if (QueueBase::GetNPackets () == GetMaxSize ().GetValue ())
-    {
-      auto it = Head ();
-      while (it != Tail () && !TtlExceeded (it))
-        {
-          it++;
-        }
-    }
+  // remove the stale packets (if any) to make room for the new packet.
+  RemoveExpiredItems ();
 
   if (QueueBase::GetNPackets () == GetMaxSize ().GetValue () && m_dropPolicy == DROP_OLDEST)
     {
       NS_LOG_DEBUG ("Remove the oldest item in the queue");
-      DoRemove (Head ());
+      RemoveAt (Head ());
     }
 
-  return DoEnqueue (Head (), item);
+  if (!DoEnqueue (Head (), item))
+    {
+      return false;
+    }
+  AddToIndexes (Head (), true);
+  return true;
 }
 
 Ptr<WifiMacQueueItem>
 WifiMacQueue::Dequeue (void)
 {
   NS_LOG_FUNCTION (this);
-  for (auto it = Head (); it != Tail (); )
+  RemoveExpiredItems ();
+  if (Head () != Tail ())
     {
-      if (!TtlExceeded (it))
-        {
-          return DoDequeue (it);
-        }
+      return DequeueAt (Head ());
     }
   NS_LOG_DEBUG ("The queue is empty");
   return 0;
@@ -163,17 +218,12 @@ Ptr<WifiMacQueueItem>
 WifiMacQueue::DequeueByAddress (Mac48Address dest)
 {
   NS_LOG_FUNCTION (this << dest);
-
-  for (auto it = Head (); it != Tail (); )
+  RemoveExpiredItems ();
+  for (auto it = Head (); it != Tail (); it++)
     {
-      if (!TtlExceeded (it))
+      if ((*it)->GetHeader ().IsData () && (*it)->GetDestinationAddress () == dest)
         {
-          if ((*it)->GetHeader ().IsData () && (*it)->GetDestinationAddress () == dest)
-            {
-              return DoDequeue (it);
-            }
-
-          it++;
+          return DequeueAt (it);
         }
     }
   NS_LOG_DEBUG ("The queue is empty");
@@ -184,18 +234,11 @@ Ptr<WifiMacQueueItem>
 WifiMacQueue::DequeueByTidAndAddress (uint8_t tid, Mac48Address dest)
 {
   NS_LOG_FUNCTION (this << dest);
-  for (auto it = Head (); it != Tail (); )
+  RemoveExpiredItems ();
+  const std::list<ConstIterator> *items = GetTidAndAddressItems (tid, dest);
+  if (items != 0)
     {
-      if (!TtlExceeded (it))
-        {
-          if ((*it)->GetHeader ().IsQosData () && (*it)->GetDestinationAddress () == dest
-              && (*it)->GetHeader ().GetQosTid () == tid)
-            {
-              return DoDequeue (it);
-            }
-
-          it++;
-        }
+      return DequeueAt (items->front ());
     }
   NS_LOG_DEBUG ("The queue is empty");
   return 0;
@@ -205,17 +248,13 @@ Ptr<WifiMacQueueItem>
 WifiMacQueue::DequeueFirstAvailable (const Ptr<QosBlockedDestinations> blockedPackets)
 {
   NS_LOG_FUNCTION (this);
-  for (auto it = Head (); it != Tail (); )
+  RemoveExpiredItems ();
+  for (auto it = Head (); it != Tail (); it++)
     {
-      if (!TtlExceeded (it))
+      if (!(*it)->GetHeader ().IsQosData ()
+          || !blockedPackets->IsBlocked ((*it)->GetHeader ().GetAddr1 (), (*it)->GetHeader ().GetQosTid ()))
         {
-          if (!(*it)->GetHeader ().IsQosData ()
-              || !blockedPackets->IsBlocked ((*it)->GetHeader ().GetAddr1 (), (*it)->GetHeader ().GetQosTid ()))
-            {
-              return DoDequeue (it);
-            }
-
-          it++;
+          return DequeueAt (it);
         }
     }
   NS_LOG_DEBUG ("The queue is empty");
@@ -243,18 +282,11 @@ Ptr<const WifiMacQueueItem>
 WifiMacQueue::PeekByTidAndAddress (uint8_t tid, Mac48Address dest)
 {
   NS_LOG_FUNCTION (this << dest);
-  for (auto it = Head (); it != Tail (); )
+  RemoveExpiredItems ();
+  const std::list<ConstIterator> *items = GetTidAndAddressItems (tid, dest);
+  if (items != 0)
     {
-      if (!TtlExceeded (it))
-        {
-          if ((*it)->GetHeader ().IsQosData () && (*it)->GetDestinationAddress () == dest
-              && (*it)->GetHeader ().GetQosTid () == tid)
-            {
-              return DoPeek (it);
-            }
-
-          it++;
-        }
+      return DoPeek (items->front ());
     }
   NS_LOG_DEBUG ("The queue is empty");
   return 0;
@@ -264,17 +296,13 @@ Ptr<const WifiMacQueueItem>
 WifiMacQueue::PeekFirstAvailable (const Ptr<QosBlockedDestinations> blockedPackets)
 {
   NS_LOG_FUNCTION (this);
-  for (auto it = Head (); it != Tail (); )
+  RemoveExpiredItems ();
+  for (auto it = Head (); it != Tail (); it++)
     {
-      if (!TtlExceeded (it))
+      if (!(*it)->GetHeader ().IsQosData ()
+          || !blockedPackets->IsBlocked ((*it)->GetHeader ().GetAddr1 (), (*it)->GetHeader ().GetQosTid ()))
         {
-          if (!(*it)->GetHeader ().IsQosData ()
-              || !blockedPackets->IsBlocked ((*it)->GetHeader ().GetAddr1 (), (*it)->GetHeader ().GetQosTid ()))
-            {
-              return DoPeek (it);
-            }
-
-          it++;
+          return DoPeek (it);
         }
     }
   NS_LOG_DEBUG ("The queue is empty");
@@ -285,13 +313,10 @@ Ptr<WifiMacQueueItem>
 WifiMacQueue::Remove (void)
 {
   NS_LOG_FUNCTION (this);
-
-  for (auto it = Head (); it != Tail (); )
+  RemoveExpiredItems ();
+  if (Head () != Tail ())
     {
-      if (!TtlExceeded (it))
-        {
-          return DoRemove (it);
-        }
+      return RemoveAt (Head ());
     }
   NS_LOG_DEBUG ("The queue is empty");
   return 0;
@@ -301,17 +326,13 @@ bool
 WifiMacQueue::Remove (Ptr<const Packet> packet)
 {
   NS_LOG_FUNCTION (this << packet);
-  for (auto it = Head (); it != Tail (); )
+  RemoveExpiredItems ();
+  for (auto it = Head (); it != Tail (); it++)
     {
-      if (!TtlExceeded (it))
+      if ((*it)->GetPacket () == packet)
         {
-          if ((*it)->GetPacket () == packet)
-            {
-              DoRemove (it);
-              return true;
-            }
-
-          it++;
+          RemoveAt (it);
+          return true;
         }
     }
   NS_LOG_DEBUG ("Packet " << packet << " not found in the queue");
@@ -322,19 +343,13 @@ uint32_t
 WifiMacQueue::GetNPacketsByAddress (Mac48Address dest)
 {
   NS_LOG_FUNCTION (this << dest);
-
+  RemoveExpiredItems ();
   uint32_t nPackets = 0;
-
-  for (auto it = Head (); it != Tail (); )
+  for (auto it = Head (); it != Tail (); it++)
     {
-      if (!TtlExceeded (it))
+      if ((*it)->GetHeader ().IsData () && (*it)->GetDestinationAddress () == dest)
         {
-          if ((*it)->GetHeader ().IsData () && (*it)->GetDestinationAddress () == dest)
-            {
-              nPackets++;
-            }
-
-          it++;
+          nPackets++;
         }
     }
   NS_LOG_DEBUG ("returns " << nPackets);
@@ -345,20 +360,9 @@ uint32_t
 WifiMacQueue::GetNPacketsByTidAndAddress (uint8_t tid, Mac48Address dest)
 {
   NS_LOG_FUNCTION (this << dest);
-  uint32_t nPackets = 0;
-  for (auto it = Head (); it != Tail (); )
-    {
-      if (!TtlExceeded (it))
-        {
-          if ((*it)->GetHeader ().IsQosData () && (*it)->GetDestinationAddress () == dest
-              && (*it)->GetHeader ().GetQosTid () == tid)
-            {
-              nPackets++;
-            }
-
-          it++;
-        }
-    }
+  RemoveExpiredItems ();
+  const std::list<ConstIterator> *items = GetTidAndAddressItems (tid, dest);
+  uint32_t nPackets = (items != 0 ? items->size () : 0);
   NS_LOG_DEBUG ("returns " << nPackets);
   return nPackets;
 }
@@ -367,16 +371,10 @@ bool
 WifiMacQueue::IsEmpty (void)
 {
   NS_LOG_FUNCTION (this);
-  for (auto it = Head (); it != Tail (); )
-    {
-      if (!TtlExceeded (it))
-        {
-          NS_LOG_DEBUG ("returns false");
-          return false;
-        }
-    }
-  NS_LOG_DEBUG ("returns true");
-  return true;
+  RemoveExpiredItems ();
+  bool empty = QueueBase::IsEmpty ();
+  NS_LOG_DEBUG ("returns " << empty);
+  return empty;
 }
 
 uint32_t
@@ -384,13 +382,7 @@ WifiMacQueue::GetNPackets (void)
 {
   NS_LOG_FUNCTION (this);
   // remove packets that stayed in the queue for too long
-  for (auto it = Head (); it != Tail (); )
-    {
-      if (!TtlExceeded (it))
-        {
-          it++;
-        }
-    }
+  RemoveExpiredItems ();
   return QueueBase::GetNPackets ();
 }
 
@@ -399,13 +391,7 @@ WifiMacQueue::GetNBytes (void)
 {
   NS_LOG_FUNCTION (this);
   // remove packets that stayed in the queue for too long
-  for (auto it = Head (); it != Tail (); )
-    {
-      if (!TtlExceeded (it))
-        {
-          it++;
-        }
-    }
+  RemoveExpiredItems ();
   return QueueBase::GetNBytes ();
 }
 
@@ -24,7 +24,11 @@
 #ifndef WIFI_MAC_QUEUE_H
 #define WIFI_MAC_QUEUE_H
 
+#include <list>
+#include <map>
+#include <unordered_map>
 #include "wifi-mac-queue-item.h"
+#include "wifi-utils.h"
 
 namespace ns3 {
 
@@ -44,6 +48,12 @@ class QosBlockedDestinations;
  * to verify whether or not it should be dropped. If
  * dot11EDCATableMSDULifetime has elapsed, it is dropped.
  * Otherwise, it is returned to the caller.
+ *
+ * The items are indexed by timestamp, so that every operation (except
+ * the const Peek) first drops all the items that stayed in the queue for
+ * too long without scanning the queue, and the QoS data frames are indexed
+ * by receiver address and TID, so that the per-(address, TID) operations
+ * do not scan the queue either.
  */
 class WifiMacQueue : public Queue<WifiMacQueueItem>
 {
@@ -220,17 +230,64 @@ public:
 
 private:
   /**
-   * Remove the item pointed to by the iterator <i>it</i> if it has been in the
-   * queue for too long. If the item is removed, the iterator is updated to
-   * point to the item that followed the erased one.
+   * Remove all the items that stayed in the queue for too long.
+   */
+  void RemoveExpiredItems (void);
+  /**
+   * Index the item pointed to by the iterator <i>pos</i>, which has just been
+   * inserted at the head or at the tail of the queue.
+   *
+   * \param pos an iterator pointing to the item
+   * \param atHead true if the item was inserted at the head of the queue
+   */
+  void AddToIndexes (ConstIterator pos, bool atHead);
+  /**
+   * Remove the item pointed to by the iterator <i>pos</i> from the indexes.
+   *
+   * \param pos an iterator pointing to the item
+   */
+  void RemoveFromIndexes (ConstIterator pos);
+  /**
+   * Dequeue the item pointed to by the iterator <i>pos</i>.
+   *
+   * \param pos an iterator pointing to the item
+   * \return the item
+   */
+  Ptr<WifiMacQueueItem> DequeueAt (ConstIterator pos);
+  /**
+   * Remove (and drop) the item pointed to by the iterator <i>pos</i>.
    *
-   * \param it an iterator pointing to the item
-   * \return true if the item is removed, false otherwise
+   * \param pos an iterator pointing to the item
+   * \return the item
+   */
+  Ptr<WifiMacQueueItem> RemoveAt (ConstIterator pos);
+  /**
+   * \param tid the given TID
+   * \param dest the given destination
+   * \return the QoS data frames having the given TID and receiver address,
+   *         in queue order, or 0 if there is none
    */
-  bool TtlExceeded (ConstIterator &it);
+  const std::list<ConstIterator> * GetTidAndAddressItems (uint8_t tid, Mac48Address dest) const;
+
+  /// the items indexed by timestamp
+  typedef std::multimap<Time, ConstIterator> ExpiryIndex;
+  /// the QoS data frames of each (receiver address, TID) pair, in queue order
+  typedef std::unordered_map<std::pair<Mac48Address, uint8_t>, std::list<ConstIterator>,
+                             WifiAddressTidHash> TidAndAddressIndex;
+
+  /// the entries of an item in the indexes
+  struct IndexEntries
+  {
+    ExpiryIndex::iterator expiry;                 //!< the entry in the expiry index
+    bool qosData;                                 //!< whether the item is in the TID and address index
+    std::list<ConstIterator>::iterator tidAndAddress; //!< the entry in the TID and address index
+  };
 
   Time m_maxDelay;                          //!< Time to live for packets in the queue
   DropPolicy m_dropPolicy;                  //!< Drop behavior of queue
+  ExpiryIndex m_expiryIndex;                //!< the items indexed by timestamp
+  TidAndAddressIndex m_tidAndAddressIndex;  //!< the QoS data frames indexed by receiver address and TID
+  std::unordered_map<const WifiMacQueueItem *, IndexEntries> m_indexEntries; //!< the index entries of each item
 
   NS_LOG_TEMPLATE_DECLARE;                  //!< redefinition of the log component
 };
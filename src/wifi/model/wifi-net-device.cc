@@ -24,6 +24,7 @@
 #include "ns3/pointer.h"
 #include "ns3/log.h"
 #include "ns3/node.h"
+#include "ns3/node-list.h"
 #include "ns3/net-device-queue-interface.h"
 #include "wifi-net-device.h"
 #include "wifi-phy.h"
@@ -261,6 +262,7 @@ void
 WifiNetDevice::SetAddress (Address address)
 {
   m_mac->SetAddress (Mac48Address::ConvertFrom (address));
+  NodeList::NotifyAddressChange (this);
 }
 
 Address
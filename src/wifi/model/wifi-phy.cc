@@ -304,6 +304,25 @@ WifiPhy::GetTypeId (void)
                    PointerValue (),
                    MakePointerAccessor (&WifiPhy::m_frameCaptureModel),
                    MakePointerChecker <FrameCaptureModel> ())
+    .AddAttribute ("TxDurationCacheSize",
+                   "The number of entries of the cache of the TX durations "
+                   "of the packets, keyed on the size, TXVECTOR, frequency and "
+                   "MPDU type. When two keys map to the same entry, the most "
+                   "recently computed duration replaces the other one. "
+                   "A size of zero disables the cache.",
+                   UintegerValue (256),
+                   MakeUintegerAccessor (&WifiPhy::GetTxDurationCacheSize,
+                                         &WifiPhy::SetTxDurationCacheSize),
+                   MakeUintegerChecker<uint32_t> ())
+    .AddAttribute ("LinkAbstraction",
+                   "If true, the PLCP header and the payload of a received frame "
+                   "are both decoded at the end of the frame, from the SNIR "
+                   "averaged over the frame, with a single call to the error "
+                   "rate model each (e.g., a TableBasedErrorRateModel), rather "
+                   "than chunk by chunk and at the end of the PLCP header.",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&WifiPhy::m_linkAbstraction),
+                   MakeBooleanChecker ())
     .AddTraceSource ("PhyTxBegin",
                      "Trace source indicating a packet "
                      "has begun transmitting over the channel medium",
@@ -349,6 +368,15 @@ WifiPhy::GetTypeId (void)
                      "in monitor mode to sniff all frames being transmitted",
                      MakeTraceSourceAccessor (&WifiPhy::m_phyMonitorSniffTxTrace),
                      "ns3::WifiPhy::MonitorSnifferTxTracedCallback")
+    .AddTraceSource ("TxDurationCacheHits",
+                     "Number of TX durations found in the cache",
+                     MakeTraceSourceAccessor (&WifiPhy::m_txDurationCacheHits),
+                     "ns3::TracedValueCallback::Uint64")
+    .AddTraceSource ("TxDurationCacheMisses",
+                     "Number of TX durations that were computed and "
+                     "inserted in the cache",
+                     MakeTraceSourceAccessor (&WifiPhy::m_txDurationCacheMisses),
+                     "ns3::TracedValueCallback::Uint64")
   ;
   return tid;
 }
@@ -372,6 +400,9 @@ WifiPhy::WifiPhy ()
     m_initialChannelNumber (0),
     m_totalAmpduSize (0),
     m_totalAmpduNumSymbols (0),
+    m_txDurationCacheHits (0),
+    m_txDurationCacheMisses (0),
+    m_linkAbstraction (false),
     m_currentEvent (0),
     m_wifiRadioEnergyModel (0)
 {
@@ -395,6 +426,7 @@ WifiPhy::DoDispose (void)
   m_wifiRadioEnergyModel = 0;
   m_deviceRateSet.clear ();
   m_deviceMcsSet.clear ();
+  m_txDurationCache.clear ();
 }
 
 void
@@ -2227,9 +2259,66 @@ WifiPhy::CalculatePlcpPreambleAndHeaderDuration (WifiTxVector txVector)
 Time
 WifiPhy::CalculateTxDuration (uint32_t size, WifiTxVector txVector, uint16_t frequency, MpduType mpdutype, uint8_t incFlag)
 {
-  Time duration = CalculatePlcpPreambleAndHeaderDuration (txVector)
+  // the duration of the last MPDU of an A-MPDU depends on the previous MPDUs
+  // and the durations of the other MPDUs of an A-MPDU are accumulated when
+  // incFlag is set, hence these durations cannot be cached
+  if (m_txDurationCache.empty ()
+      || mpdutype == LAST_MPDU_IN_AGGREGATE
+      || (mpdutype == MPDU_IN_AGGREGATE && incFlag == 1))
+    {
+      return CalculatePlcpPreambleAndHeaderDuration (txVector)
+             + GetPayloadDuration (size, txVector, frequency, mpdutype, incFlag);
+    }
+
+  uint64_t packedTxVector = PackTxVector (txVector);
+  uint64_t params = (static_cast<uint64_t> (1) << 63)
+    | (static_cast<uint64_t> (mpdutype) << 48)
+    | (static_cast<uint64_t> (frequency) << 32)
+    | size;
+  uint64_t hash = (packedTxVector ^ (params * 0x9e3779b97f4a7c15ULL)) * 0xff51afd7ed558ccdULL;
+  TxDurationCacheEntry &entry = m_txDurationCache[(hash >> 32) % m_txDurationCache.size ()];
+  if (entry.params == params && entry.txVector == packedTxVector)
+    {
+      m_txDurationCacheHits++;
+      return entry.duration;
+    }
+  m_txDurationCacheMisses++;
+  entry.txVector = packedTxVector;
+  entry.params = params;
+  entry.duration = CalculatePlcpPreambleAndHeaderDuration (txVector)
     + GetPayloadDuration (size, txVector, frequency, mpdutype, incFlag);
-  return duration;
+  return entry.duration;
+}
+
+uint64_t
+WifiPhy::PackTxVector (WifiTxVector txVector)
+{
+  uint32_t uid = txVector.GetMode ().GetUid ();
+  NS_ASSERT (uid <= 0xffff);
+  NS_ASSERT (txVector.GetNss () <= 0xf && txVector.GetNess () <= 0x7);
+  return static_cast<uint64_t> (uid)
+         | (static_cast<uint64_t> (txVector.GetPreambleType ()) << 16)
+         | (static_cast<uint64_t> (txVector.GetChannelWidth ()) << 24)
+         | (static_cast<uint64_t> (txVector.GetGuardInterval ()) << 40)
+         | (static_cast<uint64_t> (txVector.GetNss ()) << 56)
+         | (static_cast<uint64_t> (txVector.GetNess ()) << 60)
+         | (static_cast<uint64_t> (txVector.IsStbc ()) << 63);
+}
+
+void
+WifiPhy::SetTxDurationCacheSize (uint32_t size)
+{
+  NS_LOG_FUNCTION (this << size);
+  TxDurationCacheEntry empty;
+  empty.txVector = 0;
+  empty.params = 0;
+  m_txDurationCache.assign (size, empty);
+}
+
+uint32_t
+WifiPhy::GetTxDurationCacheSize (void) const
+{
+  return m_txDurationCache.size ();
 }
 
 Time
@@ -2545,7 +2634,21 @@ WifiPhy::EndReceive (Ptr<Packet> packet, WifiPreamble preamble, MpduType mpdutyp
   NS_ASSERT (event->GetEndTime () == Simulator::Now ());
 
   InterferenceHelper::SnrPer snrPer;
-  snrPer = m_interference.CalculatePlcpPayloadSnrPer (event);
+  if (m_linkAbstraction)
+    {
+      double headerPer;
+      snrPer = m_interference.CalculateAverageSnrPer (event, &headerPer);
+      if (preamble != WIFI_PREAMBLE_NONE && m_plcpSuccess && m_random->GetValue () <= headerPer)
+        {
+          NS_LOG_DEBUG ("drop packet because plcp preamble/header reception failed");
+          NotifyRxDrop (packet);
+          m_plcpSuccess = false;
+        }
+    }
+  else
+    {
+      snrPer = m_interference.CalculatePlcpPayloadSnrPer (event);
+    }
   m_interference.NotifyRxEnd ();
   m_currentEvent = 0;
 
@@ -3668,7 +3771,17 @@ WifiPhy::StartRx (Ptr<Packet> packet, WifiTxVector txVector, MpduType mpdutype,
       NotifyRxBegin (packet);
       m_interference.NotifyRxStart ();
 
-      if (preamble != WIFI_PREAMBLE_NONE)
+      if (preamble != WIFI_PREAMBLE_NONE && m_linkAbstraction)
+        {
+          // the PLCP header is decoded at the end of the frame, along with the payload
+          m_plcpSuccess = IsModeSupported (txVector.GetMode ()) || IsMcsSupported (txVector.GetMode ());
+          if (!m_plcpSuccess)
+            {
+              NS_LOG_DEBUG ("drop packet because it was sent using an unsupported mode (" << txVector.GetMode () << ")");
+              NotifyRxDrop (packet);
+            }
+        }
+      else if (preamble != WIFI_PREAMBLE_NONE)
         {
           NS_ASSERT (m_endPlcpRxEvent.IsExpired ());
           Time preambleAndHeaderDuration = CalculatePlcpPreambleAndHeaderDuration (txVector);
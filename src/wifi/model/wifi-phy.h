@@ -23,6 +23,7 @@
 #define WIFI_PHY_H
 
 #include "ns3/event-id.h"
+#include "ns3/traced-value.h"
 #include "wifi-mpdu-type.h"
 #include "wifi-phy-standard.h"
 #include "interference-helper.h"
@@ -1432,6 +1433,17 @@ public:
    * \param wifiRadioEnergyModel the wifi radio energy model
    */
   void SetWifiRadioEnergyModel (const Ptr<WifiRadioEnergyModel> wifiRadioEnergyModel);
+  /**
+   * Set the number of entries of the cache of the durations computed by
+   * CalculateTxDuration. A size of zero disables the cache.
+   *
+   * \param size the number of entries of the cache
+   */
+  void SetTxDurationCacheSize (uint32_t size);
+  /**
+   * \return the number of entries of the cache of the TX durations
+   */
+  uint32_t GetTxDurationCacheSize (void) const;
 
   /**
    * \return the channel width
@@ -1519,6 +1531,16 @@ private:
    * DoInitialize () is called.
    */
   void InitializeFrequencyChannelNumber (void);
+  /**
+   * Pack the parameters of a TXVECTOR that determine the TX duration of a
+   * packet (mode, preamble, channel width, guard interval, number of spatial
+   * streams and STBC) into a single integer.
+   *
+   * \param txVector the TXVECTOR
+   *
+   * \return the packed TXVECTOR
+   */
+  static uint64_t PackTxVector (WifiTxVector txVector);
   /**
    * Configure WifiPhy with appropriate channel frequency and
    * supported rates for 802.11a standard.
@@ -1784,9 +1806,26 @@ private:
   uint32_t m_totalAmpduSize;     //!< Total size of the previously transmitted MPDUs in an A-MPDU, used for the computation of the number of symbols needed for the last MPDU in the A-MPDU
   double m_totalAmpduNumSymbols; //!< Number of symbols previously transmitted for the MPDUs in an A-MPDU, used for the computation of the number of symbols needed for the last MPDU in the A-MPDU
 
+  /**
+   * An entry of the cache of the TX durations. The key of an entry is made
+   * of the packed TXVECTOR and of the size, frequency and MPDU type packed
+   * together; an entry whose packed parameters are zero is empty.
+   */
+  struct TxDurationCacheEntry
+  {
+    uint64_t txVector; //!< the packed TXVECTOR
+    uint64_t params;   //!< the packed size, frequency and MPDU type
+    Time duration;     //!< the TX duration
+  };
+
+  std::vector<TxDurationCacheEntry> m_txDurationCache; //!< direct-mapped cache of the TX durations
+  TracedValue<uint64_t> m_txDurationCacheHits;         //!< number of TX durations found in the cache
+  TracedValue<uint64_t> m_txDurationCacheMisses;       //!< number of TX durations computed and inserted in the cache
+
   Ptr<NetDevice>     m_device;   //!< Pointer to the device
   Ptr<MobilityModel> m_mobility; //!< Pointer to the mobility model
 
+  bool m_linkAbstraction;    //!< whether the frames are decoded at once at their end, from their average SNIR
   Ptr<Event> m_currentEvent; //!< Hold the current event
   Ptr<FrameCaptureModel> m_frameCaptureModel; //!< Frame capture model
   Ptr<WifiRadioEnergyModel> m_wifiRadioEnergyModel; //!< Wifi radio energy model
@@ -21,6 +21,7 @@
 #ifndef WIFI_REMOTE_STATION_MANAGER_H
 #define WIFI_REMOTE_STATION_MANAGER_H
 
+#include <unordered_map>
 #include "ns3/traced-callback.h"
 #include "ns3/object.h"
 #include "ns3/nstime.h"
@@ -28,6 +29,7 @@
 #include "ns3/mac48-address.h"
 #include "wifi-mode.h"
 #include "wifi-preamble.h"
+#include "wifi-utils.h"
 
 namespace ns3 {
 
@@ -1387,13 +1389,13 @@ private:
   uint32_t GetNFragments (const WifiMacHeader *header, Ptr<const Packet> packet);
 
   /**
-   * A vector of WifiRemoteStations
+   * The WifiRemoteStations of each remote station, one per TID
    */
-  typedef std::vector <WifiRemoteStation *> Stations;
+  typedef std::unordered_map <Mac48Address, std::vector<WifiRemoteStation *>, WifiAddressHash> Stations;
   /**
-   * A vector of WifiRemoteStationStates
+   * The WifiRemoteStationState of each remote station
    */
-  typedef std::vector <WifiRemoteStationState *> StationStates;
+  typedef std::unordered_map <Mac48Address, WifiRemoteStationState *, WifiAddressHash> StationStates;
 
   /**
    * This is a pointer to the WifiPhy associated with this
@@ -1424,8 +1426,8 @@ private:
   WifiModeList m_bssBasicRateSet; //!< basic rate set
   WifiModeList m_bssBasicMcsSet; //!< basic MCS set
 
-  StationStates m_states;  //!< States of known stations
-  Stations m_stations;     //!< Information for each known stations
+  StationStates m_states;  //!< States of known stations, indexed by address
+  Stations m_stations;     //!< Information for each known stations, indexed by address
 
   WifiMode m_defaultTxMode; //!< The default transmission mode
   WifiMode m_defaultTxMcs;   //!< The default transmission modulation-coding scheme (MCS)
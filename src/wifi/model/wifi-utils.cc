@@ -18,8 +18,10 @@
  * Author: Sébastien Deronne <sebastien.deronne@gmail.com>
  */
 
+#include <functional>
 #include "ns3/packet.h"
 #include "ns3/nstime.h"
+#include "ns3/mac48-address.h"
 #include "wifi-utils.h"
 #include "ctrl-headers.h"
 #include "wifi-mac-header.h"
@@ -158,4 +160,30 @@ GetSize (Ptr<const Packet> packet, const WifiMacHeader *hdr, bool isAmpdu)
   return size;
 }
 
+std::size_t
+WifiAddressHash::operator() (const Mac48Address &address) const
+{
+  uint8_t buffer[6];
+  address.CopyTo (buffer);
+  uint64_t value = 0;
+  for (uint8_t i = 0; i < 6; i++)
+    {
+      value = (value << 8) | buffer[i];
+    }
+  return std::hash<uint64_t> () (value);
+}
+
+std::size_t
+WifiAddressTidHash::operator() (const std::pair<Mac48Address, uint8_t> &key) const
+{
+  uint8_t buffer[6];
+  key.first.CopyTo (buffer);
+  uint64_t value = 0;
+  for (uint8_t i = 0; i < 6; i++)
+    {
+      value = (value << 8) | buffer[i];
+    }
+  return std::hash<uint64_t> () ((value << 8) | key.second);
+}
+
 } //namespace ns3
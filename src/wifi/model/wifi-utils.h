@@ -21,6 +21,8 @@
 #ifndef WIFI_UTILS_H
 #define WIFI_UTILS_H
 
+#include <cstddef>
+#include <utility>
 #include "block-ack-type.h"
 
 namespace ns3 {
@@ -29,6 +31,7 @@ class WifiMacHeader;
 class WifiMode;
 class Packet;
 class Time;
+class Mac48Address;
 
 /**
  * Convert from dBm to Watts.
@@ -133,6 +136,34 @@ void AddWifiMacTrailer (Ptr<Packet> packet);
  */
 uint32_t GetSize (Ptr<const Packet> packet, const WifiMacHeader *hdr, bool isAmpdu);
 
+/**
+ * \ingroup wifi
+ * Function object computing the hash of a MAC address, to index
+ * unordered containers by MAC address.
+ */
+struct WifiAddressHash
+{
+  /**
+   * \param address the MAC address
+   * \return the hash of the MAC address
+   */
+  std::size_t operator() (const Mac48Address &address) const;
+};
+
+/**
+ * \ingroup wifi
+ * Function object computing the hash of a (MAC address, TID) pair, to index
+ * unordered containers by MAC address and TID (e.g., block ack agreements).
+ */
+struct WifiAddressTidHash
+{
+  /**
+   * \param key the MAC address and the TID
+   * \return the hash of the MAC address and the TID
+   */
+  std::size_t operator() (const std::pair<Mac48Address, uint8_t> &key) const;
+};
+
 } // namespace ns3
 
 #endif /* WIFI_UTILS_H */
@@ -19,7 +19,10 @@
  *          Sébastien Deronne <sebastien.deronne@gmail.com>
  */
 
+#include <map>
+#include <tuple>
 #include "ns3/log.h"
+#include "ns3/boolean.h"
 #include "yans-error-rate-model.h"
 #include "dsss-error-rate-model.h"
 #include "wifi-utils.h"
@@ -38,11 +41,20 @@ YansErrorRateModel::GetTypeId (void)
     .SetParent<ErrorRateModel> ()
     .SetGroupName ("Wifi")
     .AddConstructor<YansErrorRateModel> ()
+    .AddAttribute ("Tabulated",
+                   "If true, the success rate of OFDM chunks is interpolated "
+                   "from tables of the success rate of a single bit, which are "
+                   "computed once per mode and shared by all the models. "
+                   "Otherwise, it is computed analytically for every chunk.",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&YansErrorRateModel::m_tabulated),
+                   MakeBooleanChecker ())
   ;
   return tid;
 }
 
 YansErrorRateModel::YansErrorRateModel ()
+  : m_tabulated (false)
 {
 }
 
@@ -183,6 +195,43 @@ double
 YansErrorRateModel::GetChunkSuccessRate (WifiMode mode, WifiTxVector txVector, double snr, uint64_t nbits) const
 {
   NS_LOG_FUNCTION (this << mode << txVector.GetMode () << snr << nbits);
+  if (m_tabulated
+      && mode.GetModulationClass () != WIFI_MOD_CLASS_DSSS
+      && mode.GetModulationClass () != WIFI_MOD_CLASS_HR_DSSS
+      && ErrorRateTable::IsInRange (snr))
+    {
+      return GetTable (mode, txVector).GetChunkSuccessRate (snr, nbits);
+    }
+  return CalculateChunkSuccessRate (mode, txVector, snr, nbits);
+}
+
+const ErrorRateTable &
+YansErrorRateModel::GetTable (WifiMode mode, WifiTxVector txVector) const
+{
+  // the PHY rate, hence the Eb/No, depends on the channel width, the guard
+  // interval and the number of spatial streams
+  typedef std::tuple<uint32_t, uint16_t, uint16_t, uint8_t> Key;
+  typedef std::map<Key, ErrorRateTable> Tables;
+  static Tables tables;
+  Key key = std::make_tuple (mode.GetUid (), txVector.GetChannelWidth (), txVector.GetGuardInterval (), txVector.GetNss ());
+  Tables::const_iterator it = tables.find (key);
+  if (it == tables.end ())
+    {
+      NS_LOG_DEBUG ("Build error rate table for " << mode);
+      std::vector<double> successRates;
+      successRates.reserve (ErrorRateTable::GetNSamples ());
+      for (uint32_t i = 0; i < ErrorRateTable::GetNSamples (); i++)
+        {
+          successRates.push_back (CalculateChunkSuccessRate (mode, txVector, ErrorRateTable::GetSnr (i), 1));
+        }
+      it = tables.insert (std::make_pair (key, ErrorRateTable (successRates))).first;
+    }
+  return it->second;
+}
+
+double
+YansErrorRateModel::CalculateChunkSuccessRate (WifiMode mode, WifiTxVector txVector, double snr, uint64_t nbits) const
+{
   if (mode.GetModulationClass () == WIFI_MOD_CLASS_ERP_OFDM
       || mode.GetModulationClass () == WIFI_MOD_CLASS_OFDM
       || mode.GetModulationClass () == WIFI_MOD_CLASS_HT
@@ -22,6 +22,7 @@
 #define YANS_ERROR_RATE_MODEL_H
 
 #include "error-rate-model.h"
+#include "error-rate-table.h"
 
 namespace ns3 {
 
@@ -65,6 +66,28 @@ public:
 
 
 private:
+  /**
+   * Compute the success rate of a chunk with the analytic model.
+   *
+   * \param mode the Wi-Fi mode applicable to this chunk
+   * \param txVector TXVECTOR of the overall transmission
+   * \param snr the SNR of the chunk
+   * \param nbits the number of bits in this chunk
+   *
+   * \return probability of successfully receiving the chunk
+   */
+  double CalculateChunkSuccessRate (WifiMode mode, WifiTxVector txVector, double snr, uint64_t nbits) const;
+  /**
+   * Get the table of the success rate of a single bit for the given mode,
+   * channel width and PHY rate, creating it if needed. The tables are
+   * shared by all the instances of this model.
+   *
+   * \param mode the Wi-Fi mode
+   * \param txVector TXVECTOR of the overall transmission
+   *
+   * \return the table for the given mode and TXVECTOR
+   */
+  const ErrorRateTable & GetTable (WifiMode mode, WifiTxVector txVector) const;
   /**
    * Return BER of BPSK with the given parameters.
    *
@@ -155,6 +178,8 @@ private:
                        uint64_t phyRate,
                        uint32_t m, uint32_t dfree,
                        uint32_t adFree, uint32_t adFreePlusOne) const;
+
+  bool m_tabulated; //!< whether the success rate of OFDM chunks is interpolated from tables
 };
 
 } //namespace ns3
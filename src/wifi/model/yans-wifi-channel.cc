@@ -22,6 +22,7 @@
 #include "ns3/simulator.h"
 #include "ns3/log.h"
 #include "ns3/pointer.h"
+#include "ns3/double.h"
 #include "ns3/net-device.h"
 #include "ns3/node.h"
 #include "ns3/propagation-loss-model.h"
@@ -30,6 +31,8 @@
 #include "yans-wifi-channel.h"
 #include "yans-wifi-phy.h"
 #include "wifi-utils.h"
+#include <algorithm>
+#include <cmath>
 
 namespace ns3 {
 
@@ -52,11 +55,32 @@ YansWifiChannel::GetTypeId (void)
                    PointerValue (),
                    MakePointerAccessor (&YansWifiChannel::m_delay),
                    MakePointerChecker<PropagationDelayModel> ())
+    .AddAttribute ("MaxRange",
+                   "The maximum distance (m) between a transmitter and the receivers "
+                   "the transmitted signals are delivered to. When it is non zero, "
+                   "the PHYs are indexed by position so that each transmission only "
+                   "considers the PHYs in the neighbourhood of the transmitter. "
+                   "It must be larger than the interference range of the PHYs, "
+                   "otherwise signals that would affect the receivers are lost. "
+                   "The default value (zero) delivers all signals to all the PHYs.",
+                   DoubleValue (0),
+                   MakeDoubleAccessor (&YansWifiChannel::m_maxRange),
+                   MakeDoubleChecker<double> (0))
+    .AddAttribute ("MaxLossDb",
+                   "The maximum loss (dB) for which transmitted signals are delivered "
+                   "to the receivers. Signals for which the PropagationLossModel "
+                   "returns a larger loss are not delivered. Note that the default "
+                   "value corresponds to delivering all signals.",
+                   DoubleValue (1.0e9),
+                   MakeDoubleAccessor (&YansWifiChannel::m_maxLossDb),
+                   MakeDoubleChecker<double> ())
   ;
   return tid;
 }
 
 YansWifiChannel::YansWifiChannel ()
+  : m_gridValid (false),
+    m_maxSpeed (0)
 {
   NS_LOG_FUNCTION (this);
 }
@@ -67,6 +91,25 @@ YansWifiChannel::~YansWifiChannel ()
   m_phyList.clear ();
 }
 
+void
+YansWifiChannel::DoDispose (void)
+{
+  NS_LOG_FUNCTION (this);
+  for (uint32_t i = 0; i < m_mobilities.size (); i++)
+    {
+      m_mobilities[i]->TraceDisconnectWithoutContext ("CourseChange",
+                                                      MakeBoundCallback (&YansWifiChannel::CourseChanged, this, i));
+    }
+  m_mobilities.clear ();
+  m_grid.clear ();
+  m_cells.clear ();
+  m_gridValid = false;
+  m_phyList.clear ();
+  m_loss = 0;
+  m_delay = 0;
+  Channel::DoDispose ();
+}
+
 void
 YansWifiChannel::SetPropagationLossModel (const Ptr<PropagationLossModel> loss)
 {
@@ -87,38 +130,81 @@ YansWifiChannel::Send (Ptr<YansWifiPhy> sender, Ptr<const Packet> packet, double
   NS_LOG_FUNCTION (this << sender << packet << txPowerDbm << duration.GetSeconds ());
   Ptr<MobilityModel> senderMobility = sender->GetMobility ();
   NS_ASSERT (senderMobility != 0);
-  for (PhyList::const_iterator i = m_phyList.begin (); i != m_phyList.end (); i++)
+  //For now don't account for inter channel interference nor channel bonding
+  uint8_t channelNumber = sender->GetChannelNumber ();
+  PhyList receivers;
+  if (m_maxRange > 0)
     {
-      if (sender != (*i))
+      std::vector<uint32_t> candidates;
+      GetCandidateReceivers (senderMobility->GetPosition (), candidates);
+      for (std::vector<uint32_t>::const_iterator i = candidates.begin (); i != candidates.end (); i++)
         {
-          //For now don't account for inter channel interference nor channel bonding
-          if ((*i)->GetChannelNumber () != sender->GetChannelNumber ())
-            {
-              continue;
-            }
-
-          Ptr<MobilityModel> receiverMobility = (*i)->GetMobility ()->GetObject<MobilityModel> ();
-          Time delay = m_delay->GetDelay (senderMobility, receiverMobility);
-          double rxPowerDbm = m_loss->CalcRxPower (txPowerDbm, senderMobility, receiverMobility);
-          NS_LOG_DEBUG ("propagation: txPower=" << txPowerDbm << "dbm, rxPower=" << rxPowerDbm << "dbm, " <<
-                        "distance=" << senderMobility->GetDistanceFrom (receiverMobility) << "m, delay=" << delay);
-          Ptr<Packet> copy = packet->Copy ();
-          Ptr<NetDevice> dstNetDevice = (*i)->GetDevice ();
-          uint32_t dstNode;
-          if (dstNetDevice == 0)
+          Ptr<YansWifiPhy> receiver = m_phyList[*i];
+          if (sender != receiver
+              && senderMobility->GetDistanceFrom (receiver->GetMobility ()) <= m_maxRange
+              && receiver->GetChannelNumber () == channelNumber)
             {
-              dstNode = 0xffffffff;
+              receivers.push_back (receiver);
             }
-          else
+        }
+    }
+  else
+    {
+      for (PhyList::const_iterator i = m_phyList.begin (); i != m_phyList.end (); i++)
+        {
+          if (sender != (*i) && (*i)->GetChannelNumber () == channelNumber)
             {
-              dstNode = dstNetDevice->GetNode ()->GetId ();
+              receivers.push_back (*i);
             }
-
-          Simulator::ScheduleWithContext (dstNode,
-                                          delay, &YansWifiChannel::Receive,
-                                          (*i), copy, rxPowerDbm, duration);
         }
     }
+  if (receivers.empty ())
+    {
+      return;
+    }
+
+  // compute the reception power at all the receivers at once
+  std::vector<Ptr<MobilityModel> > receiverMobilities;
+  receiverMobilities.reserve (receivers.size ());
+  for (PhyList::const_iterator i = receivers.begin (); i != receivers.end (); i++)
+    {
+      receiverMobilities.push_back ((*i)->GetMobility ()->GetObject<MobilityModel> ());
+    }
+  std::vector<double> rxPowersDbm;
+  m_loss->CalcRxPower (txPowerDbm, senderMobility, receiverMobilities, rxPowersDbm);
+  for (std::size_t i = 0; i < receivers.size (); i++)
+    {
+      SendTo (senderMobility, receivers[i], receiverMobilities[i], packet, txPowerDbm, rxPowersDbm[i], duration);
+    }
+}
+
+void
+YansWifiChannel::SendTo (Ptr<MobilityModel> senderMobility, Ptr<YansWifiPhy> receiver, Ptr<MobilityModel> receiverMobility,
+                         Ptr<const Packet> packet, double txPowerDbm, double rxPowerDbm, Time duration) const
+{
+  Time delay = m_delay->GetDelay (senderMobility, receiverMobility);
+  NS_LOG_DEBUG ("propagation: txPower=" << txPowerDbm << "dbm, rxPower=" << rxPowerDbm << "dbm, " <<
+                "distance=" << senderMobility->GetDistanceFrom (receiverMobility) << "m, delay=" << delay);
+  if (txPowerDbm - rxPowerDbm > m_maxLossDb)
+    {
+      NS_LOG_LOGIC ("dropping signal, loss " << txPowerDbm - rxPowerDbm << "dB above " << m_maxLossDb << "dB");
+      return;
+    }
+  Ptr<Packet> copy = packet->Copy ();
+  Ptr<NetDevice> dstNetDevice = receiver->GetDevice ();
+  uint32_t dstNode;
+  if (dstNetDevice == 0)
+    {
+      dstNode = 0xffffffff;
+    }
+  else
+    {
+      dstNode = dstNetDevice->GetNode ()->GetId ();
+    }
+
+  Simulator::ScheduleWithContext (dstNode,
+                                  delay, &YansWifiChannel::Receive,
+                                  receiver, copy, rxPowerDbm, duration);
 }
 
 void
@@ -145,6 +231,98 @@ YansWifiChannel::Add (Ptr<YansWifiPhy> phy)
 {
   NS_LOG_FUNCTION (this << phy);
   m_phyList.push_back (phy);
+  m_gridValid = false;
+}
+
+YansWifiChannel::Cell
+YansWifiChannel::GetCell (const Vector &position) const
+{
+  return Cell (static_cast<int64_t> (std::floor (position.x / m_maxRange)),
+               static_cast<int64_t> (std::floor (position.y / m_maxRange)));
+}
+
+void
+YansWifiChannel::UpdateGrid (void) const
+{
+  // A node may have drifted by at most m_maxSpeed * elapsed since its cell was computed;
+  // rebuild the grid once this bound exceeds half a cell, so that lookups stay local.
+  double elapsed = (Simulator::Now () - m_gridTime).GetSeconds ();
+  if (m_gridValid && m_maxSpeed * elapsed <= m_maxRange / 2)
+    {
+      return;
+    }
+  NS_LOG_FUNCTION (this);
+  m_grid.clear ();
+  m_cells.resize (m_phyList.size ());
+  m_gridTime = Simulator::Now ();
+  m_maxSpeed = 0;
+  m_gridValid = true;
+  for (uint32_t i = 0; i < m_phyList.size (); i++)
+    {
+      Ptr<MobilityModel> mobility = m_phyList[i]->GetMobility ();
+      NS_ASSERT (mobility != 0);
+      if (i == m_mobilities.size ())
+        {
+          m_mobilities.push_back (mobility);
+          mobility->TraceConnectWithoutContext ("CourseChange",
+                                                MakeBoundCallback (&YansWifiChannel::CourseChanged, this, i));
+        }
+      m_cells[i] = GetCell (mobility->GetPosition ());
+      m_grid[m_cells[i]].push_back (i);
+      m_maxSpeed = std::max (m_maxSpeed, mobility->GetVelocity ().GetLength ());
+    }
+}
+
+void
+YansWifiChannel::UpdateCell (uint32_t i) const
+{
+  Ptr<MobilityModel> mobility = m_mobilities[i];
+  Cell cell = GetCell (mobility->GetPosition ());
+  m_maxSpeed = std::max (m_maxSpeed, mobility->GetVelocity ().GetLength ());
+  if (cell == m_cells[i])
+    {
+      return;
+    }
+  Grid::iterator it = m_grid.find (m_cells[i]);
+  NS_ASSERT (it != m_grid.end ());
+  it->second.erase (std::find (it->second.begin (), it->second.end (), i));
+  if (it->second.empty ())
+    {
+      m_grid.erase (it);
+    }
+  m_grid[cell].push_back (i);
+  m_cells[i] = cell;
+}
+
+void
+YansWifiChannel::CourseChanged (const YansWifiChannel *channel, uint32_t i, Ptr<const MobilityModel> mobility)
+{
+  if (channel->m_gridValid)
+    {
+      channel->UpdateCell (i);
+    }
+}
+
+void
+YansWifiChannel::GetCandidateReceivers (const Vector &position, std::vector<uint32_t> &receivers) const
+{
+  UpdateGrid ();
+  double range = m_maxRange + m_maxSpeed * (Simulator::Now () - m_gridTime).GetSeconds ();
+  Cell min = GetCell (position - Vector (range, range, 0));
+  Cell max = GetCell (position + Vector (range, range, 0));
+  for (int64_t x = min.first; x <= max.first; x++)
+    {
+      for (int64_t y = min.second; y <= max.second; y++)
+        {
+          Grid::const_iterator it = m_grid.find (Cell (x, y));
+          if (it != m_grid.end ())
+            {
+              receivers.insert (receivers.end (), it->second.begin (), it->second.end ());
+            }
+        }
+    }
+  // deliver the signals in the same order as without the grid
+  std::sort (receivers.begin (), receivers.end ());
 }
 
 int64_t
@@ -19,8 +19,16 @@
  */
 
 #include "ns3/test.h"
+#include "ns3/simulator.h"
 #include "ns3/qos-utils.h"
 #include "ns3/ctrl-headers.h"
+#include "ns3/mgt-headers.h"
+#include "ns3/packet.h"
+#include "ns3/wifi-mac-queue.h"
+#include "ns3/mac-tx-middle.h"
+#include "ns3/yans-wifi-phy.h"
+#include "ns3/constant-rate-wifi-manager.h"
+#include "ns3/block-ack-manager.h"
 
 using namespace ns3;
 
@@ -306,6 +314,214 @@ CtrlBAckResponseHeaderTest::DoRun (void)
   NS_TEST_EXPECT_MSG_EQ (m_blockAckHdr.IsPacketReceived (80), false, "error in compressed bitmap");
 }
 
+/**
+ * \ingroup wifi-test
+ * \ingroup tests
+ *
+ * \brief Test for the retransmission queue of the block ack manager
+ *
+ * The packets 4090 to 1 are sent under block ack and the packets 4094 to 1,
+ * across the wrap of the sequence numbers, are lost. The lost packets must be
+ * found and removed from the retransmission queue by sequence number on both
+ * sides of the wrap, and the retransmission queue must be empty after the
+ * agreement is torn down, so that the same sequence numbers can be lost again
+ * under a new agreement.
+ */
+class BlockAckManagerRetryTest : public TestCase
+{
+public:
+  BlockAckManagerRetryTest ();
+private:
+  virtual void DoRun (void);
+  /**
+   * Set up a block ack agreement
+   * \param startingSeq the starting sequence number
+   */
+  void EstablishAgreement (uint16_t startingSeq);
+  /**
+   * Store the packets sent under block ack
+   * \param startingSeq the sequence number of the first packet
+   * \param nPackets the number of packets
+   */
+  void SendPackets (uint16_t startingSeq, uint16_t nPackets);
+  /**
+   * Receive a compressed block ack
+   * \param startingSeq the starting sequence number of the block ack
+   * \param nReceived the number of packets received from the starting sequence number on
+   */
+  void ReceiveBlockAck (uint16_t startingSeq, uint16_t nReceived);
+  /**
+   * Check the sequence numbers of the retransmission queue
+   * \param expected the sequence numbers expected in the retransmission queue
+   * \param absent sequence numbers expected not to be in the retransmission queue
+   */
+  void CheckRetries (std::list<uint16_t> expected, std::list<uint16_t> absent);
+  /**
+   * Callback invoked when the packets to a destination are blocked or unblocked
+   * \param recipient the recipient address
+   * \param tid the traffic ID
+   */
+  void BlockDestination (Mac48Address recipient, uint8_t tid);
+
+  Ptr<BlockAckManager> m_manager; ///< block ack manager
+  Mac48Address m_recipient;       ///< recipient address
+  uint8_t m_tid;                  ///< traffic ID
+};
+
+BlockAckManagerRetryTest::BlockAckManagerRetryTest ()
+  : TestCase ("Check the retransmission queue of the block ack manager across the wrap of the sequence numbers"),
+    m_recipient (Mac48Address ("00:00:00:00:00:02")),
+    m_tid (0)
+{
+}
+
+void
+BlockAckManagerRetryTest::BlockDestination (Mac48Address recipient, uint8_t tid)
+{
+}
+
+void
+BlockAckManagerRetryTest::EstablishAgreement (uint16_t startingSeq)
+{
+  MgtAddBaRequestHeader reqHdr;
+  reqHdr.SetImmediateBlockAck ();
+  reqHdr.SetTid (m_tid);
+  reqHdr.SetTimeout (0);
+  reqHdr.SetBufferSize (63);
+  reqHdr.SetStartingSequence (startingSeq);
+  m_manager->CreateAgreement (&reqHdr, m_recipient);
+
+  MgtAddBaResponseHeader respHdr;
+  respHdr.SetImmediateBlockAck ();
+  respHdr.SetTid (m_tid);
+  respHdr.SetTimeout (0);
+  respHdr.SetBufferSize (63);
+  StatusCode code;
+  code.SetSuccess ();
+  respHdr.SetStatusCode (code);
+  m_manager->UpdateAgreement (&respHdr, m_recipient);
+}
+
+void
+BlockAckManagerRetryTest::SendPackets (uint16_t startingSeq, uint16_t nPackets)
+{
+  for (uint16_t i = 0; i < nPackets; i++)
+    {
+      WifiMacHeader hdr;
+      hdr.SetType (WIFI_MAC_QOSDATA);
+      hdr.SetAddr1 (m_recipient);
+      hdr.SetQosTid (m_tid);
+      hdr.SetQosAckPolicy (WifiMacHeader::BLOCK_ACK);
+      hdr.SetSequenceNumber ((startingSeq + i) % 4096);
+      m_manager->StorePacket (Create<Packet> (100), hdr, Simulator::Now ());
+    }
+}
+
+void
+BlockAckManagerRetryTest::ReceiveBlockAck (uint16_t startingSeq, uint16_t nReceived)
+{
+  CtrlBAckResponseHeader blockAck;
+  blockAck.SetType (COMPRESSED_BLOCK_ACK);
+  blockAck.SetTidInfo (m_tid);
+  blockAck.SetStartingSequence (startingSeq);
+  for (uint16_t i = 0; i < nReceived; i++)
+    {
+      blockAck.SetReceivedPacket ((startingSeq + i) % 4096);
+    }
+  m_manager->NotifyGotBlockAck (&blockAck, m_recipient, 0, WifiMode (), 0);
+}
+
+void
+BlockAckManagerRetryTest::CheckRetries (std::list<uint16_t> expected, std::list<uint16_t> absent)
+{
+  NS_TEST_EXPECT_MSG_EQ (m_manager->GetNRetryNeededPackets (m_recipient, m_tid), expected.size (),
+                         "Unexpected number of packets to retransmit");
+  NS_TEST_EXPECT_MSG_EQ (m_manager->GetSeqNumOfNextRetryPacket (m_recipient, m_tid),
+                         (expected.empty () ? 4096 : expected.front ()),
+                         "Unexpected next packet to retransmit");
+  for (std::list<uint16_t>::const_iterator it = expected.begin (); it != expected.end (); it++)
+    {
+      NS_TEST_EXPECT_MSG_EQ (m_manager->AlreadyExists (*it, m_recipient, m_tid), true,
+                             "Packet " << *it << " should be in the retransmission queue");
+    }
+  for (std::list<uint16_t>::const_iterator it = absent.begin (); it != absent.end (); it++)
+    {
+      NS_TEST_EXPECT_MSG_EQ (m_manager->AlreadyExists (*it, m_recipient, m_tid), false,
+                             "Packet " << *it << " should not be in the retransmission queue");
+    }
+}
+
+void
+BlockAckManagerRetryTest::DoRun (void)
+{
+  Ptr<YansWifiPhy> phy = CreateObject<YansWifiPhy> ();
+  phy->ConfigureStandard (WIFI_PHY_STANDARD_80211a);
+  Ptr<WifiRemoteStationManager> stationManager = CreateObject<ConstantRateWifiManager> ();
+  stationManager->SetupPhy (phy);
+  m_manager = CreateObject<BlockAckManager> ();
+  m_manager->SetWifiRemoteStationManager (stationManager);
+  m_manager->SetTxMiddle (Create<MacTxMiddle> ());
+  m_manager->SetQueue (CreateObject<WifiMacQueue> ());
+  m_manager->SetMaxPacketDelay (Seconds (10));
+  m_manager->SetBlockAckType (COMPRESSED_BLOCK_ACK);
+  m_manager->SetBlockDestinationCallback (MakeCallback (&BlockAckManagerRetryTest::BlockDestination, this));
+  m_manager->SetUnblockDestinationCallback (MakeCallback (&BlockAckManagerRetryTest::BlockDestination, this));
+
+  // packets 4090 to 1 are sent and packets 4094 to 1 are lost
+  EstablishAgreement (4090);
+  SendPackets (4090, 8);
+  ReceiveBlockAck (4090, 4);
+  std::list<uint16_t> expected;
+  expected.push_back (4094);
+  expected.push_back (4095);
+  expected.push_back (0);
+  expected.push_back (1);
+  std::list<uint16_t> absent;
+  absent.push_back (4093);
+  absent.push_back (2);
+  CheckRetries (expected, absent);
+
+  // a packet after the wrap is removed by sequence number
+  NS_TEST_EXPECT_MSG_EQ (m_manager->RemovePacket (m_tid, m_recipient, 0), true, "Packet 0 should have been removed");
+  NS_TEST_EXPECT_MSG_EQ (m_manager->RemovePacket (m_tid, m_recipient, 0), false, "Packet 0 should have been removed already");
+  expected.remove (0);
+  absent.push_back (0);
+  CheckRetries (expected, absent);
+
+  // the retransmission of packet 4094 is acknowledged
+  ReceiveBlockAck (4094, 1);
+  expected.remove (4094);
+  absent.push_back (4094);
+  CheckRetries (expected, absent);
+
+  // packet 4095 is retransmitted, across the wrap from packet 1
+  WifiMacHeader hdr;
+  Ptr<const Packet> packet = m_manager->GetNextPacket (hdr, true);
+  NS_TEST_ASSERT_MSG_NE (packet, 0, "A packet should have been retransmitted");
+  NS_TEST_EXPECT_MSG_EQ (hdr.GetSequenceNumber (), 4095, "Packet 4095 should have been retransmitted first");
+  expected.remove (4095);
+  absent.push_back (4095);
+  CheckRetries (expected, absent);
+
+  // the agreement is reset, and the same sequence numbers are lost again
+  m_manager->DestroyAgreement (m_recipient, m_tid);
+  CheckRetries (std::list<uint16_t> (), expected);
+  EstablishAgreement (4095);
+  SendPackets (4095, 3);
+  ReceiveBlockAck (4095, 0);
+  expected.clear ();
+  expected.push_back (4095);
+  expected.push_back (0);
+  expected.push_back (1);
+  CheckRetries (expected, std::list<uint16_t> ());
+
+  m_manager->Dispose ();
+  m_manager = 0;
+  stationManager->Dispose ();
+  phy->Dispose ();
+  Simulator::Destroy ();
+}
+
 /**
  * \ingroup wifi-test
  * \ingroup tests
@@ -324,6 +540,7 @@ BlockAckTestSuite::BlockAckTestSuite ()
   AddTestCase (new PacketBufferingCaseA, TestCase::QUICK);
   AddTestCase (new PacketBufferingCaseB, TestCase::QUICK);
   AddTestCase (new CtrlBAckResponseHeaderTest, TestCase::QUICK);
+  AddTestCase (new BlockAckManagerRetryTest, TestCase::QUICK);
 }
 
 static BlockAckTestSuite g_blockAckTestSuite; ///< the test suite
@@ -625,6 +625,22 @@ ChannelAccessManagerTest::DoRun (void)
   AddTxEvt (8, 1);
   AddAccessRequest (14, 2, 14, 0);
   EndTest ();
+  // Check that the backoff is resumed after a transmission which started
+  // while receiving inside SIFS, i.e., that the end of that reception is
+  // taken into account from the start of the transmission:
+  //  10     20   21   23   24     27      28         30
+  //  |  rx  |    | rx | tx | sifs | aifsn | backoff  | tx |
+  //     |
+  //    12 request access. backoff slots: 2
+  //
+  StartTest (1, 3, 10);
+  AddDcfState (1);
+  AddRxOkEvt (10, 10);
+  AddAccessRequest (12, 1, 30, 0);
+  ExpectCollision (12, 2, 0); // 2 slots
+  AddRxInsideSifsEvt (21, 10);
+  AddTxEvt (23, 1);
+  EndTest ();
   // The test below mainly intends to test the case where the medium
   // becomes busy in the middle of a backoff slot: the backoff counter
   // must not be decremented for this backoff slot. This is the case
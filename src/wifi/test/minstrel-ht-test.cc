@@ -0,0 +1,267 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/node.h"
+#include "ns3/boolean.h"
+#include "ns3/wifi-net-device.h"
+#include "ns3/yans-wifi-channel.h"
+#include "ns3/yans-wifi-phy.h"
+#include "ns3/adhoc-wifi-mac.h"
+#include "ns3/minstrel-ht-wifi-manager.h"
+#include "ns3/ht-capabilities.h"
+#include "ns3/constant-position-mobility-model.h"
+#include "ns3/simulator.h"
+#include "ns3/test.h"
+
+using namespace ns3;
+
+/**
+ * \ingroup wifi-test
+ * \ingroup tests
+ *
+ * \brief MinstrelHtWifiManager giving access to the statistics of its station
+ */
+class MinstrelHtTestManager : public MinstrelHtWifiManager
+{
+public:
+  MinstrelHtTestManager ()
+    : m_station (0)
+  {
+  }
+
+  mutable MinstrelHtWifiRemoteStation *m_station; //!< the last created station
+
+private:
+  WifiRemoteStation * DoCreateStation (void) const
+  {
+    m_station = static_cast<MinstrelHtWifiRemoteStation *> (MinstrelHtWifiManager::DoCreateStation ());
+    return m_station;
+  }
+};
+
+/**
+ * \ingroup wifi-test
+ * \ingroup tests
+ *
+ * \brief MinstrelHt statistics test
+ *
+ * A MinstrelHt station is fed with a fixed pattern of feedback, depending
+ * on the MCS in use, first for single MPDUs and then for A-MPDUs. The
+ * EWMA, EWMSD and throughput of the rates which have been attempted are
+ * then compared with the values obtained with the implementation which
+ * updated the statistics of every rate at each interval.
+ */
+class MinstrelHtStatsTest : public TestCase
+{
+public:
+  MinstrelHtStatsTest ();
+
+  virtual void DoRun (void);
+
+private:
+  /**
+   * Transmit a packet and report its feedback to the manager
+   * \param ampdu whether the packet is an A-MPDU
+   */
+  void SendPacket (bool ampdu);
+  /**
+   * \param mcs the MCS value
+   * \return whether the next MPDU sent with the given MCS is successful
+   */
+  bool IsSuccessful (uint8_t mcs);
+
+  Ptr<MinstrelHtTestManager> m_manager; //!< the manager
+  Mac48Address m_remote;                //!< the address of the remote station
+  WifiMacHeader m_header;               //!< the header of the packets
+  Ptr<Packet> m_packet;                 //!< the packet
+  uint32_t m_nMpdus;                    //!< the number of MPDUs sent so far
+};
+
+MinstrelHtStatsTest::MinstrelHtStatsTest ()
+  : TestCase ("MinstrelHt statistics"),
+    m_nMpdus (0)
+{
+}
+
+bool
+MinstrelHtStatsTest::IsSuccessful (uint8_t mcs)
+{
+  // the success ratio of each MCS, in tenths
+  static const uint32_t successTenths[] = {10, 10, 9, 9, 7, 5, 2, 0};
+  return (m_nMpdus++ % 10) < successTenths[mcs];
+}
+
+void
+MinstrelHtStatsTest::SendPacket (bool ampdu)
+{
+  WifiTxVector txVector = m_manager->GetDataTxVector (m_remote, &m_header, m_packet);
+  if (ampdu)
+    {
+      uint8_t nSuccessful = 0;
+      uint8_t nFailed = 0;
+      for (uint8_t i = 0; i < 8; i++)
+        {
+          if (IsSuccessful (txVector.GetMode ().GetMcsValue ()))
+            {
+              nSuccessful++;
+            }
+          else
+            {
+              nFailed++;
+            }
+        }
+      m_manager->ReportAmpduTxStatus (m_remote, 0, nSuccessful, nFailed, 20, 20);
+      return;
+    }
+  while (true)
+    {
+      if (IsSuccessful (txVector.GetMode ().GetMcsValue ()))
+        {
+          m_manager->ReportDataOk (m_remote, &m_header, 20, txVector.GetMode (), 20, m_packet->GetSize ());
+          return;
+        }
+      m_manager->ReportDataFailed (m_remote, &m_header, m_packet->GetSize ());
+      if (!m_manager->NeedRetransmission (m_remote, &m_header, m_packet))
+        {
+          m_manager->ReportFinalDataFailed (m_remote, &m_header, m_packet->GetSize ());
+          return;
+        }
+      txVector = m_manager->GetDataTxVector (m_remote, &m_header, m_packet);
+    }
+}
+
+void
+MinstrelHtStatsTest::DoRun (void)
+{
+  Ptr<YansWifiChannel> channel = CreateObject<YansWifiChannel> ();
+  Ptr<AdhocWifiMac> mac = CreateObject<AdhocWifiMac> ();
+  mac->ConfigureStandard (WIFI_PHY_STANDARD_80211n_5GHZ);
+  Ptr<WifiNetDevice> dev = CreateObject<WifiNetDevice> ();
+  Ptr<YansWifiPhy> phy = CreateObject<YansWifiPhy> ();
+  phy->SetChannel (channel);
+  phy->SetDevice (dev);
+  phy->SetMobility (CreateObject<ConstantPositionMobilityModel> ());
+  phy->ConfigureStandard (WIFI_PHY_STANDARD_80211n_5GHZ);
+  phy->SetAttribute ("ShortGuardEnabled", BooleanValue (true));
+  m_manager = CreateObject<MinstrelHtTestManager> ();
+  m_manager->AssignStreams (1);
+  Ptr<Node> node = CreateObject<Node> ();
+  mac->SetAddress (Mac48Address::Allocate ());
+  dev->SetMac (mac);
+  dev->SetPhy (phy);
+  dev->SetRemoteStationManager (m_manager);
+  node->AddDevice (dev);
+  m_manager->Initialize ();
+
+  m_remote = Mac48Address::Allocate ();
+  HtCapabilities htCapabilities;
+  htCapabilities.SetHtSupported (1);
+  htCapabilities.SetShortGuardInterval20 (1);
+  for (uint8_t i = 0; i < 8; i++)
+    {
+      htCapabilities.SetRxMcsBitmask (i);
+    }
+  m_manager->AddStationHtCapabilities (m_remote, htCapabilities);
+  m_header.SetType (WIFI_MAC_QOSDATA);
+  m_header.SetQosTid (0);
+  m_header.SetAddr1 (m_remote);
+  m_packet = Create<Packet> (1000);
+
+  // 1 s of single MPDUs, then 1 s of A-MPDUs, that is 20 statistics updates
+  for (uint32_t i = 0; i < 2000; i++)
+    {
+      Simulator::Schedule (MilliSeconds (i), &MinstrelHtStatsTest::SendPacket, this, i >= 1000);
+    }
+  Simulator::Run ();
+
+  /// Statistics of a rate
+  struct RateStats
+  {
+    uint8_t groupId;   //!< the group
+    uint8_t rateId;    //!< the rate in the group
+    double ewmaProb;   //!< the EWMA of the success probability
+    double ewmsdProb;  //!< the EWMSD of the success probability
+    double throughput; //!< the throughput
+  };
+  // obtained with the implementation updating the statistics of every rate
+  const RateStats expected[] = {
+    {0, 0, 100, 0, 59354.734892076609},
+    {0, 3, 100, 0, 221633.38882376702},
+    {0, 4, 72.680261611938477, 13.555493256577488, 257077.7901998765},
+    {0, 5, 53.777587890625, 16.361116360344376, 243295.66812324131},
+    {0, 6, 24.279439389705658, 21.36653740441238, 121107.74942739683},
+    {0, 7, 0, 0, 0},
+    {4, 0, 100, 0, 65776.203046753726},
+    {4, 3, 100, 0, 243856.83977792773},
+    {4, 4, 70.102747168391943, 9.3108446293058122, 271667.63743050449},
+    {4, 5, 50.191986083984375, 26.668769908608137, 247820.05038158718},
+    {4, 6, 14.405519485473633, 11.544713947401258, 78278.104034525008},
+    {4, 7, 0, 0, 0}
+  };
+  const std::size_t nExpected = sizeof (expected) / sizeof (expected[0]);
+
+  MinstrelHtWifiRemoteStation *station = m_manager->m_station;
+  NS_TEST_ASSERT_MSG_NE (station, 0, "No station was created");
+  std::size_t n = 0;
+  for (uint8_t groupId = 0; groupId < station->m_groupsTable.size (); groupId++)
+    {
+      const GroupInfo &group = station->m_groupsTable[groupId];
+      if (!group.m_supported)
+        {
+          continue;
+        }
+      for (uint8_t rateId = 0; rateId < group.m_ratesTable.size (); rateId++)
+        {
+          const HtRateInfo &rate = group.m_ratesTable[rateId];
+          if (rate.attemptHist == 0)
+            {
+              continue;
+            }
+          NS_TEST_ASSERT_MSG_LT (n, nExpected, "Unexpected attempts in group " << +groupId << " rate " << +rateId);
+          NS_TEST_EXPECT_MSG_EQ (+groupId, +expected[n].groupId, "Unexpected group");
+          NS_TEST_EXPECT_MSG_EQ (+rateId, +expected[n].rateId, "Unexpected rate in group " << +groupId);
+          NS_TEST_EXPECT_MSG_EQ (rate.ewmaProb, expected[n].ewmaProb, "Unexpected EWMA of group " << +groupId << " rate " << +rateId);
+          NS_TEST_EXPECT_MSG_EQ (rate.ewmsdProb, expected[n].ewmsdProb, "Unexpected EWMSD of group " << +groupId << " rate " << +rateId);
+          NS_TEST_EXPECT_MSG_EQ (rate.throughput, expected[n].throughput, "Unexpected throughput of group " << +groupId << " rate " << +rateId);
+          n++;
+        }
+    }
+  NS_TEST_EXPECT_MSG_EQ (n, nExpected, "Unexpected number of attempted rates");
+
+  Simulator::Destroy ();
+  dev->Dispose ();
+  m_manager = 0;
+}
+
+/**
+ * \ingroup wifi-test
+ * \ingroup tests
+ *
+ * \brief MinstrelHt Test Suite
+ */
+class MinstrelHtTestSuite : public TestSuite
+{
+public:
+  MinstrelHtTestSuite ();
+};
+
+MinstrelHtTestSuite::MinstrelHtTestSuite ()
+  : TestSuite ("wifi-minstrel-ht", UNIT)
+{
+  AddTestCase (new MinstrelHtStatsTest, TestCase::QUICK);
+}
+
+static MinstrelHtTestSuite g_minstrelHtTestSuite; ///< the test suite
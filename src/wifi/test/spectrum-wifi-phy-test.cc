@@ -22,12 +22,20 @@
 #include "ns3/wifi-spectrum-value-helper.h"
 #include "ns3/spectrum-wifi-phy.h"
 #include "ns3/nist-error-rate-model.h"
+#include "ns3/table-based-error-rate-model.h"
 #include "ns3/wifi-mac-header.h"
 #include "ns3/wifi-mac-trailer.h"
 #include "ns3/wifi-phy-tag.h"
 #include "ns3/wifi-spectrum-signal-parameters.h"
 #include "ns3/wifi-phy-listener.h"
 #include "ns3/log.h"
+#include "ns3/multi-model-spectrum-channel.h"
+#include "ns3/spectrum-converter.h"
+#include "ns3/propagation-loss-model.h"
+#include "ns3/mobility-helper.h"
+#include "ns3/simple-net-device.h"
+#include "ns3/boolean.h"
+#include "ns3/wifi-utils.h"
 
 using namespace ns3;
 
@@ -308,6 +316,276 @@ SpectrumWifiPhyListenerTest::DoRun (void)
   delete m_listener;
 }
 
+/**
+ * \ingroup wifi-test
+ * \ingroup tests
+ *
+ * \brief Spectrum Wifi Phy Multi Model Test
+ *
+ * A 40 MHz SpectrumWifiPhy transmits 20 MHz and 40 MHz frames several times
+ * to a 20 MHz SpectrumWifiPhy over a MultiModelSpectrumChannel, hence the
+ * transmitted PSDs are converted to the spectrum model of the receiver. The
+ * power of each received signal must match the power computed from scratch,
+ * whether or not the channel reuses the PSD conversions.
+ */
+class SpectrumWifiPhyMultiModelTest : public TestCase
+{
+public:
+  /**
+   * Constructor
+   *
+   * \param cachePsdConversions the value of the CachePsdConversions attribute of the channel
+   */
+  SpectrumWifiPhyMultiModelTest (bool cachePsdConversions);
+  virtual ~SpectrumWifiPhyMultiModelTest ();
+private:
+  virtual void DoRun (void);
+  /**
+   * Send a packet from the transmitter
+   * \param channelWidth the channel width (MHz) of the transmission
+   */
+  void Send (uint16_t channelWidth);
+  /**
+   * Callback for the SignalArrival trace of the receiver
+   * \param wifi whether the signal is a Wi-Fi signal
+   * \param senderNodeId the node ID of the sender
+   * \param rxPowerDbm the received power (dBm)
+   * \param duration the duration of the signal
+   */
+  void SignalArrival (bool wifi, uint32_t senderNodeId, double rxPowerDbm, Time duration);
+  /**
+   * Compute the expected power at the receiver, without any cache
+   * \param channelWidth the channel width (MHz) of the transmission
+   * \return the expected received power (dBm)
+   */
+  double GetExpectedRxPowerDbm (uint16_t channelWidth) const;
+
+  bool m_cachePsdConversions;          ///< whether the channel reuses the PSD conversions
+  Ptr<SpectrumWifiPhy> m_txPhy;        ///< transmitter
+  Ptr<SpectrumWifiPhy> m_rxPhy;        ///< receiver
+  Ptr<PropagationLossModel> m_loss;    ///< propagation loss model
+  std::vector<double> m_rxPowersDbm;   ///< powers of the received signals
+  std::vector<uint16_t> m_txWidths;    ///< channel widths of the transmitted signals
+};
+
+SpectrumWifiPhyMultiModelTest::SpectrumWifiPhyMultiModelTest (bool cachePsdConversions)
+  : TestCase (std::string ("SpectrumWifiPhy test of received powers over a MultiModelSpectrumChannel")
+              + (cachePsdConversions ? " reusing PSD conversions" : "")),
+    m_cachePsdConversions (cachePsdConversions)
+{
+}
+
+SpectrumWifiPhyMultiModelTest::~SpectrumWifiPhyMultiModelTest ()
+{
+}
+
+void
+SpectrumWifiPhyMultiModelTest::Send (uint16_t channelWidth)
+{
+  WifiTxVector txVector = WifiTxVector (WifiPhy::GetHtMcs0 (), 0, WIFI_PREAMBLE_HT_MF, 800, 1, 1, 0, channelWidth, false, false);
+  m_txWidths.push_back (channelWidth);
+  m_txPhy->SendPacket (Create<Packet> (1000), txVector);
+}
+
+void
+SpectrumWifiPhyMultiModelTest::SignalArrival (bool wifi, uint32_t senderNodeId, double rxPowerDbm, Time duration)
+{
+  m_rxPowersDbm.push_back (rxPowerDbm);
+}
+
+double
+SpectrumWifiPhyMultiModelTest::GetExpectedRxPowerDbm (uint16_t channelWidth) const
+{
+  uint16_t centerFrequency = FREQUENCY + (channelWidth - CHANNEL_WIDTH) / 2;
+  double txPowerW = DbmToW (m_txPhy->GetTxPowerStart ());
+  Ptr<SpectrumValue> txPsd = WifiSpectrumValueHelper::CreateHtOfdmTxPowerSpectralDensity (centerFrequency, channelWidth, txPowerW, channelWidth);
+  SpectrumConverter converter (txPsd->GetSpectrumModel (), m_rxPhy->GetRxSpectrumModel ());
+  Ptr<SpectrumValue> rxPsd = converter.Convert (txPsd);
+  double gainDb = m_loss->CalcRxPower (0, m_txPhy->GetMobility (), m_rxPhy->GetMobility ());
+  *rxPsd *= std::pow (10.0, gainDb / 10.0);
+  Ptr<SpectrumValue> filter = WifiSpectrumValueHelper::CreateRfFilter (FREQUENCY, CHANNEL_WIDTH, 312500, GUARD_WIDTH);
+  return WToDbm (Integral ((*filter) * (*rxPsd)));
+}
+
+void
+SpectrumWifiPhyMultiModelTest::DoRun (void)
+{
+  Ptr<MultiModelSpectrumChannel> channel = CreateObject<MultiModelSpectrumChannel> ();
+  channel->SetAttribute ("CachePsdConversions", BooleanValue (m_cachePsdConversions));
+  m_loss = CreateObject<FriisPropagationLossModel> ();
+  channel->AddPropagationLossModel (m_loss);
+
+  NodeContainer nodes;
+  nodes.Create (2);
+  MobilityHelper mobility;
+  Ptr<ListPositionAllocator> positionAlloc = CreateObject<ListPositionAllocator> ();
+  positionAlloc->Add (Vector (0.0, 0.0, 0.0));
+  positionAlloc->Add (Vector (10.0, 0.0, 0.0));
+  mobility.SetPositionAllocator (positionAlloc);
+  mobility.SetMobilityModel ("ns3::ConstantPositionMobilityModel");
+  mobility.Install (nodes);
+
+  Ptr<SpectrumWifiPhy> phys[2];
+  for (uint32_t i = 0; i < 2; i++)
+    {
+      Ptr<SimpleNetDevice> device = CreateObject<SimpleNetDevice> ();
+      nodes.Get (i)->AddDevice (device);
+      phys[i] = CreateObject<SpectrumWifiPhy> ();
+      phys[i]->CreateWifiSpectrumPhyInterface (device);
+      phys[i]->SetErrorRateModel (CreateObject<NistErrorRateModel> ());
+      phys[i]->SetChannel (channel);
+      phys[i]->SetDevice (device);
+      phys[i]->SetMobility (nodes.Get (i)->GetObject<MobilityModel> ());
+      phys[i]->ConfigureStandard (WIFI_PHY_STANDARD_80211n_5GHZ);
+    }
+  m_txPhy = phys[0];
+  m_txPhy->SetChannelWidth (2 * CHANNEL_WIDTH);
+  m_txPhy->SetFrequency (FREQUENCY + CHANNEL_WIDTH / 2);
+  m_rxPhy = phys[1];
+  m_rxPhy->SetChannelWidth (CHANNEL_WIDTH);
+  m_rxPhy->SetFrequency (FREQUENCY);
+  m_txPhy->Initialize ();
+  m_rxPhy->Initialize ();
+  m_rxPhy->TraceConnectWithoutContext ("SignalArrival", MakeCallback (&SpectrumWifiPhyMultiModelTest::SignalArrival, this));
+
+  for (uint32_t i = 0; i < 3; i++)
+    {
+      Simulator::Schedule (MilliSeconds (10 + 20 * i), &SpectrumWifiPhyMultiModelTest::Send, this, CHANNEL_WIDTH);
+      Simulator::Schedule (MilliSeconds (20 + 20 * i), &SpectrumWifiPhyMultiModelTest::Send, this, 2 * CHANNEL_WIDTH);
+    }
+  Simulator::Run ();
+
+  NS_TEST_ASSERT_MSG_EQ (m_rxPowersDbm.size (), 6, "Didn't receive right number of signals");
+  for (uint32_t i = 0; i < m_rxPowersDbm.size (); i++)
+    {
+      NS_TEST_EXPECT_MSG_EQ_TOL (m_rxPowersDbm[i], GetExpectedRxPowerDbm (m_txWidths[i]), 1e-9, "Unexpected power for signal " << i);
+    }
+  NS_TEST_EXPECT_MSG_EQ (m_rxPowersDbm[0], m_rxPowersDbm[4], "Same 20 MHz signals received with different powers");
+  NS_TEST_EXPECT_MSG_EQ (m_rxPowersDbm[1], m_rxPowersDbm[5], "Same 40 MHz signals received with different powers");
+
+  Simulator::Destroy ();
+}
+
+/**
+ * \ingroup wifi-test
+ * \ingroup tests
+ *
+ * \brief Spectrum Wifi Phy Link Abstraction Test
+ *
+ * A frame is hit by a short interferer of the same power in the middle of
+ * its payload, with an error rate table giving a PER of 1 below 10 dB and
+ * of 0 above. The frame is lost when its payload is decoded chunk by chunk,
+ * but received with the link abstraction, which decodes it from the SNIR
+ * averaged over the frame, without scheduling the end of the PLCP header.
+ */
+class SpectrumWifiPhyLinkAbstractionTest : public SpectrumWifiPhyBasicTest
+{
+public:
+  SpectrumWifiPhyLinkAbstractionTest ();
+  virtual ~SpectrumWifiPhyLinkAbstractionTest ();
+
+private:
+  virtual void DoRun (void);
+  /**
+   * Receive a frame hit by an interferer
+   * \param linkAbstraction the value of the LinkAbstraction attribute of the PHY
+   * \return the number of events executed
+   */
+  uint64_t ReceiveFrame (bool linkAbstraction);
+  /**
+   * Send a short interferer
+   * \param txPowerWatts the transmit power in watts
+   */
+  void SendInterferer (double txPowerWatts);
+  /**
+   * Receive success function
+   * \param p the packet
+   * \param snr the SNR
+   * \param txVector the transmit vector
+   */
+  void RxSuccess (Ptr<Packet> p, double snr, WifiTxVector txVector);
+  /**
+   * Receive failure function
+   * \param p the packet
+   * \param snr the SNR
+   */
+  void RxFailure (Ptr<Packet> p, double snr);
+
+  uint32_t m_countRxSuccess; ///< number of frames received successfully
+  uint32_t m_countRxFailure; ///< number of frames received with errors
+};
+
+SpectrumWifiPhyLinkAbstractionTest::SpectrumWifiPhyLinkAbstractionTest ()
+  : SpectrumWifiPhyBasicTest ("SpectrumWifiPhy test case decoding a frame with the link abstraction"),
+    m_countRxSuccess (0),
+    m_countRxFailure (0)
+{
+}
+
+SpectrumWifiPhyLinkAbstractionTest::~SpectrumWifiPhyLinkAbstractionTest ()
+{
+}
+
+void
+SpectrumWifiPhyLinkAbstractionTest::SendInterferer (double txPowerWatts)
+{
+  Ptr<SpectrumSignalParameters> params = MakeSignal (txPowerWatts);
+  params->duration = MicroSeconds (10);
+  m_phy->StartRx (params);
+}
+
+void
+SpectrumWifiPhyLinkAbstractionTest::RxSuccess (Ptr<Packet> p, double snr, WifiTxVector txVector)
+{
+  NS_LOG_FUNCTION (this << p << snr << txVector);
+  m_countRxSuccess++;
+}
+
+void
+SpectrumWifiPhyLinkAbstractionTest::RxFailure (Ptr<Packet> p, double snr)
+{
+  NS_LOG_FUNCTION (this << p << snr);
+  m_countRxFailure++;
+}
+
+uint64_t
+SpectrumWifiPhyLinkAbstractionTest::ReceiveFrame (bool linkAbstraction)
+{
+  SpectrumWifiPhyBasicTest::DoSetup ();
+  Ptr<TableBasedErrorRateModel> error = CreateObject<TableBasedErrorRateModel> ();
+  error->AddPoint (WifiPhy::GetOfdmRate6Mbps (), 9.9, 1);
+  error->AddPoint (WifiPhy::GetOfdmRate6Mbps (), 10, 0);
+  m_phy->SetErrorRateModel (error);
+  m_phy->SetAttribute ("LinkAbstraction", BooleanValue (linkAbstraction));
+  m_phy->SetReceiveOkCallback (MakeCallback (&SpectrumWifiPhyLinkAbstractionTest::RxSuccess, this));
+  m_phy->SetReceiveErrorCallback (MakeCallback (&SpectrumWifiPhyLinkAbstractionTest::RxFailure, this));
+  m_countRxSuccess = 0;
+  m_countRxFailure = 0;
+
+  double txPowerWatts = 0.010;
+  Simulator::Schedule (Seconds (1), &SpectrumWifiPhyLinkAbstractionTest::SendSignal, this, txPowerWatts);
+  Simulator::Schedule (Seconds (1) + MicroSeconds (500), &SpectrumWifiPhyLinkAbstractionTest::SendInterferer, this, txPowerWatts);
+  Simulator::Run ();
+  uint64_t events = Simulator::GetEventCount ();
+  Simulator::Destroy ();
+  m_phy->Dispose ();
+  m_phy = 0;
+  return events;
+}
+
+void
+SpectrumWifiPhyLinkAbstractionTest::DoRun (void)
+{
+  uint64_t events = ReceiveFrame (false);
+  NS_TEST_EXPECT_MSG_EQ (m_countRxSuccess, 0, "The frame should have been lost during the interferer");
+  NS_TEST_EXPECT_MSG_EQ (m_countRxFailure, 1, "The frame should have been lost during the interferer");
+
+  uint64_t abstractionEvents = ReceiveFrame (true);
+  NS_TEST_EXPECT_MSG_EQ (m_countRxSuccess, 1, "The frame should have been received at the average SNIR");
+  NS_TEST_EXPECT_MSG_EQ (m_countRxFailure, 0, "The frame should have been received at the average SNIR");
+  NS_TEST_EXPECT_MSG_EQ (events - abstractionEvents, 1, "The end of the PLCP header should not have been scheduled");
+}
+
 /**
  * \ingroup wifi-test
  * \ingroup tests
@@ -325,6 +603,9 @@ SpectrumWifiPhyTestSuite::SpectrumWifiPhyTestSuite ()
 {
   AddTestCase (new SpectrumWifiPhyBasicTest, TestCase::QUICK);
   AddTestCase (new SpectrumWifiPhyListenerTest, TestCase::QUICK);
+  AddTestCase (new SpectrumWifiPhyMultiModelTest (false), TestCase::QUICK);
+  AddTestCase (new SpectrumWifiPhyMultiModelTest (true), TestCase::QUICK);
+  AddTestCase (new SpectrumWifiPhyLinkAbstractionTest, TestCase::QUICK);
 }
 
 static SpectrumWifiPhyTestSuite spectrumWifiPhyTestSuite; ///< the test suite
@@ -22,6 +22,7 @@
 #include "ns3/log.h"
 #include "ns3/test.h"
 #include "ns3/yans-wifi-phy.h"
+#include "ns3/uinteger.h"
 
 using namespace ns3;
 
@@ -426,6 +427,117 @@ TxDurationTest::DoRun (void)
   NS_TEST_EXPECT_MSG_EQ (retval, true, "an 802.11ax duration failed");
 }
 
+/**
+ * \ingroup wifi-test
+ * \ingroup tests
+ *
+ * \brief Tx Duration Cache Test
+ *
+ * Check that the TX durations returned by a PHY with a (small) cache of the
+ * TX durations are the same as those returned by a PHY without cache.
+ */
+class TxDurationCacheTest : public TestCase
+{
+public:
+  TxDurationCacheTest ();
+  virtual ~TxDurationCacheTest ();
+  virtual void DoRun (void);
+
+private:
+  /**
+   * Update the number of cache hits
+   * \param oldValue the previous number of hits
+   * \param newValue the current number of hits
+   */
+  void CacheHits (uint64_t oldValue, uint64_t newValue);
+
+  uint64_t m_hits; //!< number of cache hits
+};
+
+TxDurationCacheTest::TxDurationCacheTest ()
+  : TestCase ("Wifi TX duration cache"),
+    m_hits (0)
+{
+}
+
+TxDurationCacheTest::~TxDurationCacheTest ()
+{
+}
+
+void
+TxDurationCacheTest::CacheHits (uint64_t oldValue, uint64_t newValue)
+{
+  m_hits = newValue;
+}
+
+void
+TxDurationCacheTest::DoRun (void)
+{
+  Ptr<YansWifiPhy> phy = CreateObject<YansWifiPhy> ();
+  phy->SetAttribute ("TxDurationCacheSize", UintegerValue (0));
+  Ptr<YansWifiPhy> cachedPhy = CreateObject<YansWifiPhy> ();
+  cachedPhy->SetAttribute ("TxDurationCacheSize", UintegerValue (16));
+  cachedPhy->TraceConnectWithoutContext ("TxDurationCacheHits", MakeCallback (&TxDurationCacheTest::CacheHits, this));
+
+  WifiTxVector txVectors[4];
+  txVectors[0].SetMode (WifiPhy::GetDsssRate11Mbps ());
+  txVectors[0].SetPreambleType (WIFI_PREAMBLE_SHORT);
+  txVectors[0].SetChannelWidth (22);
+  txVectors[1].SetMode (WifiPhy::GetErpOfdmRate54Mbps ());
+  txVectors[1].SetPreambleType (WIFI_PREAMBLE_LONG);
+  txVectors[1].SetChannelWidth (20);
+  txVectors[2].SetMode (WifiPhy::GetHtMcs7 ());
+  txVectors[2].SetPreambleType (WIFI_PREAMBLE_HT_MF);
+  txVectors[2].SetChannelWidth (40);
+  txVectors[2].SetGuardInterval (400);
+  txVectors[3] = txVectors[2];
+  txVectors[3].SetGuardInterval (800);
+  uint16_t frequencies[] = {CHANNEL_1_MHZ, CHANNEL_36_MHZ};
+
+  // each duration is requested twice in a row, hence it is found in the
+  // cache the second time, and again after all the other durations, which
+  // have evicted it by then
+  uint64_t lookups = 0;
+  for (uint32_t round = 0; round < 2; round++)
+    {
+      for (uint32_t size = 14; size < 1600; size += 97)
+        {
+          for (uint32_t i = 0; i < 4; i++)
+            {
+              for (uint32_t j = 0; j < 4; j++)
+                {
+                  NS_TEST_EXPECT_MSG_EQ (cachedPhy->CalculateTxDuration (size, txVectors[i], frequencies[j / 2]),
+                                         phy->CalculateTxDuration (size, txVectors[i], frequencies[j / 2]),
+                                         "Unexpected duration for size=" << size << " " << txVectors[i]);
+                  lookups++;
+                }
+              if (txVectors[i].GetMode ().GetModulationClass () == WIFI_MOD_CLASS_HT)
+                {
+                  NS_TEST_EXPECT_MSG_EQ (cachedPhy->CalculateTxDuration (size, txVectors[i], CHANNEL_1_MHZ, MPDU_IN_AGGREGATE, 0),
+                                         phy->CalculateTxDuration (size, txVectors[i], CHANNEL_1_MHZ, MPDU_IN_AGGREGATE, 0),
+                                         "Unexpected duration of an MPDU in an A-MPDU for size=" << size);
+                  lookups++;
+                }
+            }
+        }
+    }
+  NS_TEST_EXPECT_MSG_GT_OR_EQ (m_hits, lookups / 4, "The second request of each duration should hit the cache");
+  UintegerValue cacheSize;
+  cachedPhy->GetAttribute ("TxDurationCacheSize", cacheSize);
+  NS_TEST_EXPECT_MSG_EQ (cacheSize.Get (), 16, "Unexpected cache size");
+  NS_TEST_EXPECT_MSG_LT (m_hits, lookups, "The cache is too small to hold all the durations");
+
+  // the A-MPDU accounting of the cached PHY is not affected by the cache
+  WifiTxVector txVector = txVectors[2];
+  Time expected = phy->CalculateTxDuration (1000, txVector, CHANNEL_36_MHZ, MPDU_IN_AGGREGATE, 1);
+  NS_TEST_EXPECT_MSG_EQ (cachedPhy->CalculateTxDuration (1000, txVector, CHANNEL_36_MHZ, MPDU_IN_AGGREGATE, 1), expected,
+                         "Unexpected duration of the first MPDU of an A-MPDU");
+  txVector.SetPreambleType (WIFI_PREAMBLE_NONE);
+  expected = phy->CalculateTxDuration (500, txVector, CHANNEL_36_MHZ, LAST_MPDU_IN_AGGREGATE, 1);
+  NS_TEST_EXPECT_MSG_EQ (cachedPhy->CalculateTxDuration (500, txVector, CHANNEL_36_MHZ, LAST_MPDU_IN_AGGREGATE, 1), expected,
+                         "Unexpected duration of the last MPDU of an A-MPDU");
+}
+
 /**
  * \ingroup wifi-test
  * \ingroup tests
@@ -442,6 +554,7 @@ TxDurationTestSuite::TxDurationTestSuite ()
   : TestSuite ("devices-wifi-tx-duration", UNIT)
 {
   AddTestCase (new TxDurationTest, TestCase::QUICK);
+  AddTestCase (new TxDurationCacheTest, TestCase::QUICK);
 }
 
 static TxDurationTestSuite g_txDurationTestSuite; ///< the test suite
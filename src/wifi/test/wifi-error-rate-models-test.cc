@@ -19,10 +19,17 @@
  */
 
 #include <cmath>
+#include <fstream>
 #include "ns3/test.h"
 #include "ns3/nist-error-rate-model.h"
+#include "ns3/yans-error-rate-model.h"
 #include "ns3/dsss-error-rate-model.h"
+#include "ns3/table-based-error-rate-model.h"
 #include "ns3/wifi-tx-vector.h"
+#include "ns3/boolean.h"
+#include "ns3/string.h"
+#include "ns3/uinteger.h"
+#include "ns3/wifi-phy.h"
 
 using namespace ns3;
 
@@ -291,6 +298,175 @@ WifiErrorRateModelsTestCaseNist::DoRun (void)
   NS_TEST_ASSERT_MSG_EQ_TOL (ps, 0.999, 0.001, "Not equal within tolerance");
 }
 
+/**
+ * \ingroup wifi-test
+ * \ingroup tests
+ *
+ * \brief Wifi Error Rate Models Test Case Tabulated
+ *
+ * Check that the tabulated Nist and Yans error rate models match their
+ * analytic counterparts.
+ */
+class WifiErrorRateModelsTestCaseTabulated : public TestCase
+{
+public:
+  WifiErrorRateModelsTestCaseTabulated ();
+  virtual ~WifiErrorRateModelsTestCaseTabulated ();
+
+private:
+  virtual void DoRun (void);
+  /**
+   * Compare the tabulated and the analytic versions of a model
+   * \param analytic the model with the Tabulated attribute set to false
+   * \param tabulated the model with the Tabulated attribute set to true
+   */
+  void CompareModels (Ptr<ErrorRateModel> analytic, Ptr<ErrorRateModel> tabulated);
+};
+
+WifiErrorRateModelsTestCaseTabulated::WifiErrorRateModelsTestCaseTabulated ()
+  : TestCase ("WifiErrorRateModel test case tabulated")
+{
+}
+
+WifiErrorRateModelsTestCaseTabulated::~WifiErrorRateModelsTestCaseTabulated ()
+{
+}
+
+void
+WifiErrorRateModelsTestCaseTabulated::CompareModels (Ptr<ErrorRateModel> analytic, Ptr<ErrorRateModel> tabulated)
+{
+  const char *modes[] = {"OfdmRate6Mbps", "OfdmRate9Mbps", "OfdmRate12Mbps", "OfdmRate18Mbps",
+                         "OfdmRate24Mbps", "OfdmRate36Mbps", "OfdmRate48Mbps", "OfdmRate54Mbps",
+                         "HtMcs0", "HtMcs3", "HtMcs7", "VhtMcs8", "HeMcs11"};
+  uint64_t sizes[] = {8, 8 * 14, 8 * 1500, 8 * 65535};
+  for (uint32_t i = 0; i < sizeof (modes) / sizeof (modes[0]); i++)
+    {
+      WifiTxVector txVector;
+      txVector.SetMode (WifiMode (modes[i]));
+      txVector.SetChannelWidth (20);
+      txVector.SetNss (1);
+      // SNRs that are not on the sampling grid of the tables
+      for (double snr = -9.87; snr < 40; snr += 0.137)
+        {
+          for (uint32_t j = 0; j < sizeof (sizes) / sizeof (sizes[0]); j++)
+            {
+              double expected = analytic->GetChunkSuccessRate (txVector.GetMode (), txVector, std::pow (10.0, snr / 10.0), sizes[j]);
+              double ps = tabulated->GetChunkSuccessRate (txVector.GetMode (), txVector, std::pow (10.0, snr / 10.0), sizes[j]);
+              NS_TEST_ASSERT_MSG_EQ_TOL (ps, expected, 1e-3, "Tabulated success rate of " << modes[i] << " at "
+                                         << snr << " dB for " << sizes[j] << " bits not within tolerance");
+            }
+        }
+    }
+
+  // DSSS modes and SNRs out of the range of the tables are not tabulated
+  WifiTxVector txVector;
+  txVector.SetMode (WifiMode ("DsssRate11Mbps"));
+  txVector.SetChannelWidth (22);
+  double snr = std::pow (10.0, 0.4);
+  NS_TEST_ASSERT_MSG_EQ (tabulated->GetChunkSuccessRate (txVector.GetMode (), txVector, snr, 8000),
+                         analytic->GetChunkSuccessRate (txVector.GetMode (), txVector, snr, 8000),
+                         "DSSS success rate should not be tabulated");
+  txVector.SetMode (WifiMode ("OfdmRate6Mbps"));
+  txVector.SetChannelWidth (20);
+  snr = std::pow (10.0, -1.5);
+  NS_TEST_ASSERT_MSG_EQ (tabulated->GetChunkSuccessRate (txVector.GetMode (), txVector, snr, 8),
+                         analytic->GetChunkSuccessRate (txVector.GetMode (), txVector, snr, 8),
+                         "Success rate out of the range of the tables should not be tabulated");
+}
+
+void
+WifiErrorRateModelsTestCaseTabulated::DoRun (void)
+{
+  Ptr<NistErrorRateModel> nist = CreateObject<NistErrorRateModel> ();
+  Ptr<NistErrorRateModel> tabulatedNist = CreateObject<NistErrorRateModel> ();
+  tabulatedNist->SetAttribute ("Tabulated", BooleanValue (true));
+  CompareModels (nist, tabulatedNist);
+
+  Ptr<YansErrorRateModel> yans = CreateObject<YansErrorRateModel> ();
+  Ptr<YansErrorRateModel> tabulatedYans = CreateObject<YansErrorRateModel> ();
+  tabulatedYans->SetAttribute ("Tabulated", BooleanValue (true));
+  CompareModels (yans, tabulatedYans);
+}
+
+/**
+ * \ingroup wifi-test
+ * \ingroup tests
+ *
+ * \brief Table-based Error Rate Model Test Case
+ */
+class WifiErrorRateModelsTestCaseTableBased : public TestCase
+{
+public:
+  WifiErrorRateModelsTestCaseTableBased ();
+  virtual ~WifiErrorRateModelsTestCaseTableBased ();
+
+private:
+  virtual void DoRun (void);
+};
+
+WifiErrorRateModelsTestCaseTableBased::WifiErrorRateModelsTestCaseTableBased ()
+  : TestCase ("TableBasedErrorRateModel")
+{
+}
+
+WifiErrorRateModelsTestCaseTableBased::~WifiErrorRateModelsTestCaseTableBased ()
+{
+}
+
+void
+WifiErrorRateModelsTestCaseTableBased::DoRun (void)
+{
+  std::string fileName = CreateTempDirFilename ("error-rate-table.txt");
+  std::ofstream file (fileName.c_str ());
+  file << "# mode SNR(dB) PER" << std::endl
+       << "OfdmRate6Mbps 8 0" << std::endl
+       << std::endl
+       << "OfdmRate6Mbps 0 1" << std::endl
+       << "OfdmRate6Mbps 4 0.5" << std::endl;
+  file.close ();
+
+  Ptr<TableBasedErrorRateModel> model = CreateObject<TableBasedErrorRateModel> ();
+  model->SetAttribute ("TableFile", StringValue (fileName));
+  model->SetAttribute ("ReferenceSize", UintegerValue (1000));
+  WifiMode mode = WifiPhy::GetOfdmRate6Mbps ();
+  WifiTxVector txVector;
+  txVector.SetMode (mode);
+  double snr = std::pow (10.0, 0.2); // 2 dB
+
+  NS_TEST_EXPECT_MSG_EQ (model->HasTable (mode), true, "OfdmRate6Mbps should have a table");
+  NS_TEST_EXPECT_MSG_EQ_TOL (model->GetPer (mode, 2), 0.75, 1e-12, "PER should be interpolated");
+  NS_TEST_EXPECT_MSG_EQ_TOL (model->GetPer (mode, 6), 0.25, 1e-12, "PER should be interpolated");
+  NS_TEST_EXPECT_MSG_EQ (model->GetPer (mode, -5), 1, "PER should be clamped below the table");
+  NS_TEST_EXPECT_MSG_EQ (model->GetPer (mode, 20), 0, "PER should be clamped above the table");
+
+  // success rate of chunks of the reference size, half of it and twice of it
+  NS_TEST_EXPECT_MSG_EQ_TOL (model->GetChunkSuccessRate (mode, txVector, snr, 8000), 0.25, 1e-12, "Wrong chunk success rate");
+  NS_TEST_EXPECT_MSG_EQ_TOL (model->GetChunkSuccessRate (mode, txVector, snr, 4000), 0.5, 1e-12, "Wrong chunk success rate");
+  NS_TEST_EXPECT_MSG_EQ_TOL (model->GetChunkSuccessRate (mode, txVector, snr, 16000), 0.0625, 1e-12, "Wrong chunk success rate");
+  NS_TEST_EXPECT_MSG_EQ (model->GetChunkSuccessRate (mode, txVector, 0.5, 100), 0, "Chunk should be lost");
+  NS_TEST_EXPECT_MSG_EQ (model->GetChunkSuccessRate (mode, txVector, 100, 100000), 1, "Chunk should be received");
+
+  // the modes without a table are handled by the fallback model
+  Ptr<NistErrorRateModel> nist = CreateObject<NistErrorRateModel> ();
+  mode = WifiPhy::GetOfdmRate54Mbps ();
+  txVector.SetMode (mode);
+  NS_TEST_EXPECT_MSG_EQ (model->HasTable (mode), false, "OfdmRate54Mbps should not have a table");
+  NS_TEST_EXPECT_MSG_EQ (model->GetChunkSuccessRate (mode, txVector, std::pow (10.0, 1.8), 8000),
+                         nist->GetChunkSuccessRate (mode, txVector, std::pow (10.0, 1.8), 8000),
+                         "The fallback model should be used");
+
+  // setting the table file again replaces the tables
+  std::string otherFileName = CreateTempDirFilename ("other-error-rate-table.txt");
+  file.open (otherFileName.c_str ());
+  file << "OfdmRate54Mbps 20 0.1" << std::endl;
+  file.close ();
+  model->SetAttribute ("TableFile", StringValue (otherFileName));
+  NS_TEST_EXPECT_MSG_EQ (model->HasTable (mode), true, "OfdmRate54Mbps should have a table");
+  NS_TEST_EXPECT_MSG_EQ (model->HasTable (WifiPhy::GetOfdmRate6Mbps ()), false, "The previous tables should have been discarded");
+  model->SetAttribute ("TableFile", StringValue (""));
+  NS_TEST_EXPECT_MSG_EQ (model->HasTable (mode), false, "The tables should have been discarded");
+}
+
 /**
  * \ingroup wifi-test
  * \ingroup tests
@@ -308,6 +484,8 @@ WifiErrorRateModelsTestSuite::WifiErrorRateModelsTestSuite ()
 {
   AddTestCase (new WifiErrorRateModelsTestCaseDsss, TestCase::QUICK);
   AddTestCase (new WifiErrorRateModelsTestCaseNist, TestCase::QUICK);
+  AddTestCase (new WifiErrorRateModelsTestCaseTabulated, TestCase::QUICK);
+  AddTestCase (new WifiErrorRateModelsTestCaseTableBased, TestCase::QUICK);
 }
 
 static WifiErrorRateModelsTestSuite wifiErrorRateModelsTestSuite; ///< the test suite
@@ -30,6 +30,7 @@
 #include "ns3/propagation-loss-model.h"
 #include "ns3/yans-error-rate-model.h"
 #include "ns3/constant-position-mobility-model.h"
+#include "ns3/constant-velocity-mobility-model.h"
 #include "ns3/test.h"
 #include "ns3/pointer.h"
 #include "ns3/rng-seed-manager.h"
@@ -43,6 +44,7 @@
 #include "ns3/wifi-phy-tag.h"
 #include "ns3/yans-wifi-phy.h"
 #include "ns3/mgt-headers.h"
+#include "ns3/wifi-mac-queue.h"
 
 using namespace ns3;
 
@@ -1690,6 +1692,246 @@ StaWifiMacScanningTestCase::DoRun (void)
   }
 }
 
+//-----------------------------------------------------------------------------
+/**
+ * Make sure that a YansWifiChannel with a MaxRange only delivers signals
+ * to the PHYs within range, and keeps track of the nodes that move.
+ *
+ * The scenario considers a transmitter at the origin, a fixed receiver
+ * at 10 m, a receiver initially at 500 m that jumps to 20 m after 2s, and
+ * a receiver starting at 300 m and moving towards the transmitter at
+ * 100 m/s. The MaxRange is 100 m and the transmitter broadcasts a packet
+ * after 1s and after 3s.
+ */
+class YansWifiChannelMaxRangeTestCase : public TestCase
+{
+public:
+  YansWifiChannelMaxRangeTestCase ();
+  virtual void DoRun (void);
+
+private:
+  /**
+   * Callback invoked when a PHY starts receiving a packet
+   * \param context the index of the node
+   * \param packet the packet
+   */
+  void RxBegin (std::string context, Ptr<const Packet> packet);
+  /**
+   * Broadcast a packet
+   * \param device the transmitting device
+   */
+  void SendBroadcast (Ptr<NetDevice> device);
+
+  std::vector<uint32_t> m_rxCount; ///< number of packets received by each node
+};
+
+YansWifiChannelMaxRangeTestCase::YansWifiChannelMaxRangeTestCase ()
+  : TestCase ("Test the YansWifiChannel MaxRange attribute"),
+    m_rxCount (4, 0)
+{
+}
+
+void
+YansWifiChannelMaxRangeTestCase::RxBegin (std::string context, Ptr<const Packet> packet)
+{
+  m_rxCount[std::atoi (context.c_str ())]++;
+}
+
+void
+YansWifiChannelMaxRangeTestCase::SendBroadcast (Ptr<NetDevice> device)
+{
+  device->Send (Create<Packet> (100), device->GetBroadcast (), 1);
+}
+
+void
+YansWifiChannelMaxRangeTestCase::DoRun (void)
+{
+  NodeContainer nodes;
+  nodes.Create (4);
+
+  YansWifiPhyHelper phy = YansWifiPhyHelper::Default ();
+  // all signals are received with the same power, whatever the distance
+  YansWifiChannelHelper channelHelper;
+  channelHelper.SetPropagationDelay ("ns3::ConstantSpeedPropagationDelayModel");
+  channelHelper.AddPropagationLoss ("ns3::FixedRssLossModel", "Rss", DoubleValue (-50));
+  Ptr<YansWifiChannel> channel = channelHelper.Create ();
+  channel->SetAttribute ("MaxRange", DoubleValue (100));
+  phy.SetChannel (channel);
+
+  WifiHelper wifi;
+  wifi.SetStandard (WIFI_PHY_STANDARD_80211a);
+  wifi.SetRemoteStationManager ("ns3::ConstantRateWifiManager");
+  WifiMacHelper mac;
+  mac.SetType ("ns3::AdhocWifiMac");
+  NetDeviceContainer devices = wifi.Install (phy, mac, nodes);
+
+  Ptr<ConstantPositionMobilityModel> transmitter = CreateObject<ConstantPositionMobilityModel> ();
+  transmitter->SetPosition (Vector (0.0, 0.0, 0.0));
+  nodes.Get (0)->AggregateObject (transmitter);
+  Ptr<ConstantPositionMobilityModel> fixed = CreateObject<ConstantPositionMobilityModel> ();
+  fixed->SetPosition (Vector (10.0, 0.0, 0.0));
+  nodes.Get (1)->AggregateObject (fixed);
+  Ptr<ConstantPositionMobilityModel> jumping = CreateObject<ConstantPositionMobilityModel> ();
+  jumping->SetPosition (Vector (500.0, 0.0, 0.0));
+  nodes.Get (2)->AggregateObject (jumping);
+  Ptr<ConstantVelocityMobilityModel> moving = CreateObject<ConstantVelocityMobilityModel> ();
+  moving->SetPosition (Vector (300.0, 0.0, 0.0));
+  moving->SetVelocity (Vector (-100.0, 0.0, 0.0));
+  nodes.Get (3)->AggregateObject (moving);
+
+  for (uint32_t i = 0; i < devices.GetN (); i++)
+    {
+      std::ostringstream oss;
+      oss << i;
+      DynamicCast<WifiNetDevice> (devices.Get (i))->GetPhy ()->TraceConnect ("PhyRxBegin", oss.str (),
+                                                                             MakeCallback (&YansWifiChannelMaxRangeTestCase::RxBegin, this));
+    }
+
+  Simulator::Schedule (Seconds (1.0), &YansWifiChannelMaxRangeTestCase::SendBroadcast, this, devices.Get (0));
+  Simulator::Schedule (Seconds (2.0), &ConstantPositionMobilityModel::SetPosition, jumping, Vector (20.0, 0.0, 0.0));
+  Simulator::Schedule (Seconds (3.0), &YansWifiChannelMaxRangeTestCase::SendBroadcast, this, devices.Get (0));
+
+  Simulator::Stop (Seconds (4.0));
+  Simulator::Run ();
+  Simulator::Destroy ();
+
+  NS_TEST_ASSERT_MSG_EQ (m_rxCount[0], 0, "The transmitter should not receive anything");
+  NS_TEST_ASSERT_MSG_EQ (m_rxCount[1], 2, "The fixed receiver should receive both packets");
+  NS_TEST_ASSERT_MSG_EQ (m_rxCount[2], 1, "The jumping receiver should only receive the second packet");
+  NS_TEST_ASSERT_MSG_EQ (m_rxCount[3], 1, "The moving receiver should only receive the second packet");
+}
+
+/**
+ * \ingroup wifi-test
+ * \ingroup tests
+ *
+ * \brief Test the WifiMacQueue expiry and per-(address, TID) operations
+ *
+ * With a MaxDelay of 10 ms, three QoS data frames for two receivers are
+ * enqueued at 0 ms, then at 5 ms a frame is enqueued at the tail and
+ * another one is pushed at the head. At 5 ms, the per-(address, TID) counts
+ * and lookups must account for all the frames, with the frame pushed at
+ * the head first. At 12 ms, the frames enqueued at 0 ms must have been
+ * dropped, although they are behind a frame that has not expired.
+ */
+class WifiMacQueueTestCase : public TestCase
+{
+public:
+  WifiMacQueueTestCase ();
+  virtual void DoRun (void);
+
+private:
+  /**
+   * Enqueue a QoS data frame
+   * \param addr1 the receiver address
+   * \param tid the TID
+   * \param atHead whether to push the frame at the head of the queue
+   * \return the enqueued item
+   */
+  Ptr<WifiMacQueueItem> Enqueue (Mac48Address addr1, uint8_t tid, bool atHead);
+  /**
+   * Callback invoked when the queue drops an item
+   * \param item the dropped item
+   */
+  void Drop (Ptr<const WifiMacQueueItem> item);
+  /// Enqueue the frames at 5 ms and check the queue
+  void CheckBeforeExpiry (void);
+  /// Check the queue at 12 ms
+  void CheckAfterExpiry (void);
+
+  Ptr<WifiMacQueue> m_queue;     ///< the queue under test
+  Mac48Address m_addr1;          ///< the first receiver
+  Mac48Address m_addr2;          ///< the second receiver
+  Ptr<WifiMacQueueItem> m_head;  ///< the item pushed at the head of the queue
+  Ptr<WifiMacQueueItem> m_tail;  ///< the item enqueued at the tail at 5 ms
+  uint32_t m_drops;              ///< the number of dropped items
+};
+
+WifiMacQueueTestCase::WifiMacQueueTestCase ()
+  : TestCase ("Test the WifiMacQueue expiry and per-(address, TID) operations"),
+    m_addr1 (Mac48Address ("00:00:00:00:00:01")),
+    m_addr2 (Mac48Address ("00:00:00:00:00:02")),
+    m_drops (0)
+{
+}
+
+Ptr<WifiMacQueueItem>
+WifiMacQueueTestCase::Enqueue (Mac48Address addr1, uint8_t tid, bool atHead)
+{
+  WifiMacHeader hdr;
+  hdr.SetType (WIFI_MAC_QOSDATA);
+  hdr.SetAddr1 (addr1);
+  hdr.SetQosTid (tid);
+  Ptr<WifiMacQueueItem> item = Create<WifiMacQueueItem> (Create<Packet> (100), hdr);
+  if (atHead)
+    {
+      m_queue->PushFront (item);
+    }
+  else
+    {
+      m_queue->Enqueue (item);
+    }
+  return item;
+}
+
+void
+WifiMacQueueTestCase::Drop (Ptr<const WifiMacQueueItem> item)
+{
+  m_drops++;
+}
+
+void
+WifiMacQueueTestCase::CheckBeforeExpiry (void)
+{
+  m_tail = Enqueue (m_addr1, 0, false);
+  m_head = Enqueue (m_addr2, 0, true);
+
+  NS_TEST_EXPECT_MSG_EQ (m_queue->GetNPackets (), 6, "Unexpected number of packets");
+  NS_TEST_EXPECT_MSG_EQ (m_queue->GetNPacketsByTidAndAddress (0, m_addr1), 3, "Unexpected number of packets");
+  NS_TEST_EXPECT_MSG_EQ (m_queue->GetNPacketsByTidAndAddress (0, m_addr2), 2, "Unexpected number of packets");
+  NS_TEST_EXPECT_MSG_EQ (m_queue->GetNPacketsByTidAndAddress (5, m_addr1), 1, "Unexpected number of packets");
+  NS_TEST_EXPECT_MSG_EQ (m_queue->GetNPacketsByTidAndAddress (5, m_addr2), 0, "Unexpected number of packets");
+  NS_TEST_EXPECT_MSG_EQ (m_queue->PeekByTidAndAddress (0, m_addr2), m_head, "The frame pushed at the head should come first");
+  NS_TEST_EXPECT_MSG_EQ (m_queue->Peek (), m_head, "The frame pushed at the head should come first");
+
+  Ptr<WifiMacQueueItem> item = m_queue->DequeueByTidAndAddress (5, m_addr1);
+  NS_TEST_EXPECT_MSG_EQ ((item != 0 && item->GetHeader ().GetQosTid () == 5), true, "The frame of TID 5 should be dequeued");
+  NS_TEST_EXPECT_MSG_EQ (m_queue->GetNPacketsByTidAndAddress (5, m_addr1), 0, "Unexpected number of packets");
+  NS_TEST_EXPECT_MSG_EQ (m_queue->PeekByTidAndAddress (5, m_addr1), 0, "There should be no frame of TID 5 left");
+  NS_TEST_EXPECT_MSG_EQ (m_drops, 0, "No frame should have been dropped");
+}
+
+void
+WifiMacQueueTestCase::CheckAfterExpiry (void)
+{
+  NS_TEST_EXPECT_MSG_EQ (m_queue->PeekByTidAndAddress (0, m_addr1), m_tail, "The frames enqueued at 0 ms should have expired");
+  NS_TEST_EXPECT_MSG_EQ (m_drops, 3, "The frames enqueued at 0 ms should have been dropped");
+  NS_TEST_EXPECT_MSG_EQ (m_queue->GetNPackets (), 2, "Unexpected number of packets");
+  NS_TEST_EXPECT_MSG_EQ (m_queue->GetNPacketsByTidAndAddress (0, m_addr2), 1, "Unexpected number of packets");
+  NS_TEST_EXPECT_MSG_EQ (m_queue->Dequeue (), m_head, "The frame pushed at the head should be dequeued first");
+  NS_TEST_EXPECT_MSG_EQ (m_queue->Dequeue (), m_tail, "The frame enqueued at 5 ms should be dequeued last");
+  NS_TEST_EXPECT_MSG_EQ (m_queue->IsEmpty (), true, "The queue should be empty");
+  NS_TEST_EXPECT_MSG_EQ (m_queue->GetNPacketsByTidAndAddress (0, m_addr1), 0, "Unexpected number of packets");
+}
+
+void
+WifiMacQueueTestCase::DoRun (void)
+{
+  m_queue = CreateObject<WifiMacQueue> ();
+  m_queue->SetMaxDelay (MilliSeconds (10));
+  m_queue->TraceConnectWithoutContext ("Drop", MakeCallback (&WifiMacQueueTestCase::Drop, this));
+
+  Enqueue (m_addr1, 0, false);
+  Enqueue (m_addr2, 0, false);
+  Enqueue (m_addr1, 5, false);
+  Enqueue (m_addr1, 0, false);
+
+  Simulator::Schedule (MilliSeconds (5), &WifiMacQueueTestCase::CheckBeforeExpiry, this);
+  Simulator::Schedule (MilliSeconds (12), &WifiMacQueueTestCase::CheckAfterExpiry, this);
+  Simulator::Run ();
+  Simulator::Destroy ();
+}
+
 /**
  * \ingroup wifi-test
  * \ingroup tests
@@ -1715,6 +1957,8 @@ WifiTestSuite::WifiTestSuite ()
   AddTestCase (new Bug2483TestCase, TestCase::QUICK); //Bug 2483
   AddTestCase (new Bug2831TestCase, TestCase::QUICK); //Bug 2831
   AddTestCase (new StaWifiMacScanningTestCase, TestCase::QUICK); //Bug 2399
+  AddTestCase (new YansWifiChannelMaxRangeTestCase, TestCase::QUICK);
+  AddTestCase (new WifiMacQueueTestCase, TestCase::QUICK);
 }
 
 static WifiTestSuite g_wifiTestSuite; ///< the test suite
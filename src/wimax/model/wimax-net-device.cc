@@ -24,6 +24,7 @@
 #include "ns3/simulator.h"
 #include "ns3/callback.h"
 #include "ns3/node.h"
+#include "ns3/node-list.h"
 #include "ns3/packet.h"
 #include "wimax-net-device.h"
 #include "wimax-channel.h"
@@ -403,6 +404,7 @@ void
 WimaxNetDevice::SetAddress (Address address)
 {
   m_address = Mac48Address::ConvertFrom (address);
+  NodeList::NotifyAddressChange (this);
 }
 
 void
@@ -0,0 +1,570 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// This program benchmarks the packet subsystem, from micro-benchmarks of
+// the Packet, Buffer, tag and metadata operations up to full protocol
+// stack traversals, and produces machine-readable results that can be
+// compared against those of a previous run to detect regressions.
+//
+// Sample usage:
+//   ./waf --run 'bench-packet-suite --format=csv --output=base.csv'
+//   ./waf --run 'bench-packet-suite --baseline=base.csv --threshold=5'
+//
+// The wall clock has a resolution of a few milliseconds, hence the number
+// of packets ('n' for the micro-benchmarks, 'n-stack' for the full stack
+// traversals) must be large enough for each benchmark to run for a while.
+//
+// Packet metadata can only be enabled before the first packet is created,
+// hence the --metadata option applies to the whole run: the metadata state
+// is reported in the results so that runs with and without metadata can be
+// told apart. A baseline obtained with a different metadata setting or
+// number of packets is rejected.
+//
+// The full stack benchmarks only time the simulation, not the setup of
+// the topology.
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/internet-module.h"
+#include "ns3/point-to-point-module.h"
+#include "ns3/wifi-module.h"
+#include "ns3/mobility-module.h"
+#include "bench-packets.h"
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <map>
+#include <limits>
+#include <algorithm>
+#include <stdlib.h> // for exit ()
+
+using namespace ns3;
+
+static void
+benchCopy (uint32_t n)
+{
+  BenchHeader<20> ipv4;
+  BenchHeader<8> udp;
+  Ptr<Packet> p = Create<Packet> (1500);
+  p->AddHeader (udp);
+  p->AddHeader (ipv4);
+
+  for (uint32_t i = 0; i < n; i++)
+    {
+      // the copy shares the buffer of the original packet until it is
+      // modified
+      Ptr<Packet> c = p->Copy ();
+      c->AddHeader (ipv4);
+      c->RemoveHeader (ipv4);
+    }
+}
+
+static void
+benchFragmentReassembly (uint32_t n)
+{
+  BenchHeader<20> ipv4;
+  BenchHeader<8> udp;
+
+  for (uint32_t i = 0; i < n; i++)
+    {
+      Ptr<Packet> p = Create<Packet> (4000);
+      p->AddHeader (udp);
+
+      std::vector<Ptr<Packet> > fragments;
+      for (uint32_t offset = 0; offset < p->GetSize (); offset += 1480)
+        {
+          uint32_t length = std::min<uint32_t> (1480, p->GetSize () - offset);
+          Ptr<Packet> fragment = p->CreateFragment (offset, length);
+          fragment->AddHeader (ipv4);
+          fragments.push_back (fragment);
+        }
+
+      Ptr<Packet> reassembled = Create<Packet> ();
+      for (std::vector<Ptr<Packet> >::iterator j = fragments.begin (); j != fragments.end (); j++)
+        {
+          (*j)->RemoveHeader (ipv4);
+          reassembled->AddAtEnd (*j);
+        }
+      reassembled->RemoveHeader (udp);
+    }
+}
+
+static void
+benchByteTags (uint32_t n)
+{
+  BenchHeader<20> ipv4;
+  BenchTag<4> flowId;
+  BenchTag<12> seqTs;
+
+  for (uint32_t i = 0; i < n; i++)
+    {
+      Ptr<Packet> p = Create<Packet> (1000);
+      p->AddByteTag (flowId);
+      p->AddByteTag (seqTs);
+      p->AddHeader (ipv4);
+      p->FindFirstMatchingByteTag (flowId);
+      p->FindFirstMatchingByteTag (seqTs);
+      p->RemoveHeader (ipv4);
+      p->RemoveAllByteTags ();
+    }
+}
+
+static void
+benchPacketTags (uint32_t n)
+{
+  BenchTag<4> tag1;
+  BenchTag<12> tag2;
+  BenchTag<16> tag3;
+
+  for (uint32_t i = 0; i < n; i++)
+    {
+      Ptr<Packet> p = Create<Packet> (1000);
+      p->AddPacketTag (tag1);
+      p->AddPacketTag (tag2);
+      p->AddPacketTag (tag3);
+      p->PeekPacketTag (tag1);
+      p->PeekPacketTag (tag3);
+      p->RemovePacketTag (tag2);
+      p->RemovePacketTag (tag1);
+      p->RemovePacketTag (tag3);
+    }
+}
+
+static void
+benchHeaders (uint32_t n)
+{
+  BenchHeader<20> ipv4;
+  BenchHeader<8> udp;
+  BenchHeader<14> ethernet;
+
+  for (uint32_t i = 0; i < n; i++)
+    {
+      Ptr<Packet> p = Create<Packet> (1000);
+      p->AddHeader (udp);
+      p->AddHeader (ipv4);
+      p->AddHeader (ethernet);
+      p->RemoveHeader (ethernet);
+      p->RemoveHeader (ipv4);
+      p->RemoveHeader (udp);
+    }
+}
+
+static void
+benchBufferHeadroom (uint32_t n)
+{
+  BenchHeader<40> tunnel;
+
+  for (uint32_t i = 0; i < n; i++)
+    {
+      // deep encapsulation exceeds the headroom of the buffer, which
+      // must then be grown
+      Ptr<Packet> p = Create<Packet> (100);
+      for (uint32_t j = 0; j < 16; j++)
+        {
+          p->AddHeader (tunnel);
+        }
+      for (uint32_t j = 0; j < 16; j++)
+        {
+          p->RemoveHeader (tunnel);
+        }
+    }
+}
+
+/**
+ * Read and discard all the packets received by a socket
+ * \param socket the socket
+ */
+static void
+DrainSocket (Ptr<Socket> socket)
+{
+  while (socket->Recv ())
+    {
+    }
+}
+
+/**
+ * Send packets on a socket at regular intervals
+ * \param socket the socket
+ * \param remaining the number of packets still to send
+ * \param size the packet size
+ * \param interval the interval between packets
+ */
+static void
+SendPackets (Ptr<Socket> socket, uint32_t remaining, uint32_t size, Time interval)
+{
+  if (remaining == 0)
+    {
+      return;
+    }
+  socket->Send (Create<Packet> (size));
+  Simulator::Schedule (interval, &SendPackets, socket, remaining - 1, size, interval);
+}
+
+static void
+setupUdpIpv4PointToPoint (uint32_t n)
+{
+  NodeContainer nodes;
+  nodes.Create (2);
+
+  PointToPointHelper p2p;
+  p2p.SetDeviceAttribute ("DataRate", StringValue ("10Gbps"));
+  p2p.SetChannelAttribute ("Delay", StringValue ("1us"));
+  NetDeviceContainer devices = p2p.Install (nodes);
+
+  InternetStackHelper stack;
+  stack.Install (nodes);
+  Ipv4AddressHelper address;
+  address.SetBase ("10.1.1.0", "255.255.255.0");
+  Ipv4InterfaceContainer interfaces = address.Assign (devices);
+
+  Ptr<Socket> sink = Socket::CreateSocket (nodes.Get (1), UdpSocketFactory::GetTypeId ());
+  sink->Bind (InetSocketAddress (Ipv4Address::GetAny (), 9));
+  sink->SetRecvCallback (MakeCallback (&DrainSocket));
+
+  Ptr<Socket> source = Socket::CreateSocket (nodes.Get (0), UdpSocketFactory::GetTypeId ());
+  source->Connect (InetSocketAddress (interfaces.GetAddress (1), 9));
+  Simulator::Schedule (Seconds (0.1), &SendPackets, source, n, 1000, MicroSeconds (10));
+}
+
+/// Number of bytes that remain to be sent by the TCP benchmark
+static uint64_t g_tcpRemaining = 0;
+
+/**
+ * Keep the send buffer of a TCP socket full until all the data is sent
+ * \param socket the socket
+ * \param available the space available in the send buffer
+ */
+static void
+FillTcpBuffer (Ptr<Socket> socket, uint32_t available)
+{
+  while (g_tcpRemaining > 0 && available > 0)
+    {
+      uint32_t size = std::min<uint64_t> (g_tcpRemaining, available);
+      int sent = socket->Send (Create<Packet> (size));
+      if (sent <= 0)
+        {
+          break;
+        }
+      g_tcpRemaining -= sent;
+      available -= sent;
+    }
+  if (g_tcpRemaining == 0)
+    {
+      socket->Close ();
+    }
+}
+
+/**
+ * Set the receive callback of an accepted TCP connection
+ * \param socket the accepted socket
+ * \param from the address of the peer
+ */
+static void
+AcceptTcp (Ptr<Socket> socket, const Address &from)
+{
+  socket->SetRecvCallback (MakeCallback (&DrainSocket));
+}
+
+static void
+setupTcpIpv4Wifi (uint32_t n)
+{
+  NodeContainer nodes;
+  nodes.Create (2);
+
+  MobilityHelper mobility;
+  Ptr<ListPositionAllocator> positions = CreateObject<ListPositionAllocator> ();
+  positions->Add (Vector (0.0, 0.0, 0.0));
+  positions->Add (Vector (5.0, 0.0, 0.0));
+  mobility.SetPositionAllocator (positions);
+  mobility.SetMobilityModel ("ns3::ConstantPositionMobilityModel");
+  mobility.Install (nodes);
+
+  YansWifiChannelHelper channel = YansWifiChannelHelper::Default ();
+  YansWifiPhyHelper phy = YansWifiPhyHelper::Default ();
+  phy.SetChannel (channel.Create ());
+  WifiHelper wifi;
+  wifi.SetStandard (WIFI_PHY_STANDARD_80211a);
+  wifi.SetRemoteStationManager ("ns3::ConstantRateWifiManager",
+                                "DataMode", StringValue ("OfdmRate54Mbps"));
+  WifiMacHelper mac;
+  mac.SetType ("ns3::AdhocWifiMac");
+  NetDeviceContainer devices = wifi.Install (phy, mac, nodes);
+
+  InternetStackHelper stack;
+  stack.Install (nodes);
+  Ipv4AddressHelper address;
+  address.SetBase ("10.1.1.0", "255.255.255.0");
+  Ipv4InterfaceContainer interfaces = address.Assign (devices);
+
+  Ptr<Socket> sink = Socket::CreateSocket (nodes.Get (1), TcpSocketFactory::GetTypeId ());
+  sink->Bind (InetSocketAddress (Ipv4Address::GetAny (), 9));
+  sink->Listen ();
+  sink->SetAcceptCallback (MakeNullCallback<bool, Ptr<Socket>, const Address &> (),
+                           MakeCallback (&AcceptTcp));
+
+  g_tcpRemaining = static_cast<uint64_t> (n) * 1000;
+  Ptr<Socket> source = Socket::CreateSocket (nodes.Get (0), TcpSocketFactory::GetTypeId ());
+  source->SetAttribute ("SegmentSize", UintegerValue (1000));
+  source->Bind ();
+  source->Connect (InetSocketAddress (interfaces.GetAddress (1), 9));
+  source->SetSendCallback (MakeCallback (&FillTcpBuffer));
+
+  Simulator::Stop (Seconds (3600));
+}
+
+
+/// The results of a benchmark
+struct BenchResult
+{
+  std::string name;     //!< name of the benchmark
+  uint32_t n;           //!< number of items processed per iteration
+  uint64_t minMs;       //!< minimum wall clock time of an iteration
+  double itemsPerSec;   //!< items processed per second
+};
+
+/**
+ * Build the result of a benchmark
+ * \param name the name of the benchmark
+ * \param n the number of items processed per iteration
+ * \param minDelay the minimum wall clock time of an iteration
+ * \return the result
+ */
+static BenchResult
+makeResult (const std::string &name, uint32_t n, uint64_t minDelay)
+{
+  BenchResult result;
+  result.name = name;
+  result.n = n;
+  result.minMs = minDelay;
+  result.itemsPerSec = n * 1000.0 / std::max<uint64_t> (minDelay, 1);
+  return result;
+}
+
+static BenchResult
+runBench (void (*bench) (uint32_t), uint32_t n, uint32_t minIterations, const std::string &name)
+{
+  uint64_t minDelay = std::numeric_limits<uint64_t>::max ();
+  for (uint32_t i = 0; i < minIterations; i++)
+    {
+      SystemWallClockMs time;
+      time.Start ();
+      (*bench) (n);
+      uint64_t delay = time.End ();
+      minDelay = std::min (minDelay, delay);
+    }
+  return makeResult (name, n, minDelay);
+}
+
+/**
+ * Run a full stack benchmark, timing the simulation but not its setup
+ * \param setup the function creating the topology and scheduling the traffic
+ * \param n the number of packets
+ * \param minIterations the number of iterations to minimize the time over
+ * \param name the name of the benchmark
+ * \return the result
+ */
+static BenchResult
+runStackBench (void (*setup) (uint32_t), uint32_t n, uint32_t minIterations, const std::string &name)
+{
+  uint64_t minDelay = std::numeric_limits<uint64_t>::max ();
+  for (uint32_t i = 0; i < minIterations; i++)
+    {
+      (*setup) (n);
+      SystemWallClockMs time;
+      time.Start ();
+      Simulator::Run ();
+      uint64_t delay = time.End ();
+      Simulator::Destroy ();
+      minDelay = std::min (minDelay, delay);
+    }
+  return makeResult (name, n, minDelay);
+}
+
+/**
+ * Read the results of a previous run from its CSV output
+ * \param filename the name of the CSV file
+ * \param metadata whether packet metadata is enabled in this run
+ * \return the results indexed by benchmark name
+ *
+ * Exits with an error if the previous run used a different metadata setting.
+ */
+static std::map<std::string, BenchResult>
+ReadBaseline (const std::string &filename, bool metadata)
+{
+  std::map<std::string, BenchResult> baseline;
+  std::ifstream is (filename.c_str ());
+  if (!is.is_open ())
+    {
+      std::cerr << "Error-- cannot open baseline file " << filename << std::endl;
+      exit (1);
+    }
+  std::string line;
+  while (std::getline (is, line))
+    {
+      // benchmark,metadata,n,min_ms,items_per_s
+      std::vector<std::string> fields;
+      std::istringstream iss (line);
+      std::string field;
+      while (std::getline (iss, field, ','))
+        {
+          fields.push_back (field);
+        }
+      if (fields.size () != 5 || fields[0] == "benchmark")
+        {
+          continue;
+        }
+      if (fields[1] != (metadata ? "on" : "off"))
+        {
+          std::cerr << "Error-- baseline " << filename << " was run with metadata "
+                    << fields[1] << ", not " << (metadata ? "on" : "off") << std::endl;
+          exit (1);
+        }
+      BenchResult result;
+      result.name = fields[0];
+      result.n = atoi (fields[2].c_str ());
+      result.minMs = atoi (fields[3].c_str ());
+      result.itemsPerSec = atof (fields[4].c_str ());
+      baseline[result.name] = result;
+    }
+  return baseline;
+}
+
+int main (int argc, char *argv[])
+{
+  uint32_t n = 100000;
+  uint32_t nStack = 2000;
+  uint32_t minIterations = 1;
+  bool metadata = false;
+  std::string format = "text";
+  std::string output;
+  std::string baselineFile;
+  double threshold = 10.0;
+
+  CommandLine cmd;
+  cmd.Usage ("Benchmark suite of the packet subsystem");
+  cmd.AddValue ("n", "number of packets per micro-benchmark", n);
+  cmd.AddValue ("n-stack", "number of packets per full stack benchmark", nStack);
+  cmd.AddValue ("min-iterations", "number of subiterations to minimize iteration time over", minIterations);
+  cmd.AddValue ("metadata", "enable packet metadata (printing)", metadata);
+  cmd.AddValue ("format", "output format (text or csv)", format);
+  cmd.AddValue ("output", "file the results are written to (default: standard output)", output);
+  cmd.AddValue ("baseline", "CSV results of a previous run to compare against", baselineFile);
+  cmd.AddValue ("threshold", "slowdown (in percent) reported as a regression", threshold);
+  cmd.Parse (argc, argv);
+
+  if (n == 0 || nStack == 0 || minIterations == 0)
+    {
+      std::cerr << "Error-- the number of packets and iterations must be positive" << std::endl;
+      exit (1);
+    }
+  if (format != "text" && format != "csv")
+    {
+      std::cerr << "Error-- unknown output format " << format << std::endl;
+      exit (1);
+    }
+  if (metadata)
+    {
+      Packet::EnablePrinting ();
+    }
+
+  // read the baseline first to reject a different configuration early
+  std::map<std::string, BenchResult> baseline;
+  if (!baselineFile.empty ())
+    {
+      baseline = ReadBaseline (baselineFile, metadata);
+    }
+
+  std::vector<BenchResult> results;
+  results.push_back (runBench (&benchCopy, n, minIterations, "copy"));
+  results.push_back (runBench (&benchHeaders, n, minIterations, "headers"));
+  results.push_back (runBench (&benchFragmentReassembly, n, minIterations, "fragment-reassembly"));
+  results.push_back (runBench (&benchByteTags, n, minIterations, "byte-tags"));
+  results.push_back (runBench (&benchPacketTags, n, minIterations, "packet-tags"));
+  results.push_back (runBench (&benchBufferHeadroom, n, minIterations, "buffer-headroom"));
+  results.push_back (runStackBench (&setupUdpIpv4PointToPoint, nStack, minIterations, "udp-ipv4-p2p"));
+  results.push_back (runStackBench (&setupTcpIpv4Wifi, nStack, minIterations, "tcp-ipv4-wifi"));
+
+  std::ofstream file;
+  if (!output.empty ())
+    {
+      file.open (output.c_str ());
+      if (!file.is_open ())
+        {
+          std::cerr << "Error-- cannot open output file " << output << std::endl;
+          exit (1);
+        }
+    }
+  std::ostream &os = output.empty () ? std::cout : file;
+
+  if (format == "csv")
+    {
+      os << "benchmark,metadata,n,min_ms,items_per_s" << std::endl;
+    }
+  for (std::vector<BenchResult>::const_iterator i = results.begin (); i != results.end (); i++)
+    {
+      if (format == "csv")
+        {
+          os << i->name << "," << (metadata ? "on" : "off") << "," << i->n << ","
+             << i->minMs << "," << i->itemsPerSec << std::endl;
+        }
+      else
+        {
+          os << i->itemsPerSec << " packets/s"
+             << " (" << i->minMs << " ms elapsed)\t"
+             << i->name << std::endl;
+        }
+    }
+
+  if (baselineFile.empty ())
+    {
+      return 0;
+    }
+
+  // Compare against the baseline and exit with an error if any of the
+  // benchmarks is slower than allowed by the threshold.
+  // Benchmarks that ran too fast for the resolution of the wall clock
+  // are not compared.
+  bool regression = false;
+  for (std::vector<BenchResult>::const_iterator i = results.begin (); i != results.end (); i++)
+    {
+      std::map<std::string, BenchResult>::const_iterator it = baseline.find (i->name);
+      if (it == baseline.end ())
+        {
+          continue;
+        }
+      if (it->second.n != i->n)
+        {
+          std::cerr << "Error-- baseline " << baselineFile << " ran " << i->name << " with n="
+                    << it->second.n << ", not " << i->n << std::endl;
+          exit (1);
+        }
+      if (it->second.minMs == 0 || i->minMs == 0)
+        {
+          continue;
+        }
+      double change = 100.0 * (i->itemsPerSec - it->second.itemsPerSec) / it->second.itemsPerSec;
+      std::cerr << i->name << ": " << change << "% vs baseline";
+      if (change < -threshold)
+        {
+          std::cerr << " (REGRESSION)";
+          regression = true;
+        }
+      std::cerr << std::endl;
+    }
+  return regression ? 1 : 0;
+}
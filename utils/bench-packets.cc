@@ -26,6 +26,7 @@
 #include "ns3/system-wall-clock-ms.h"
 #include "ns3/packet.h"
 #include "ns3/packet-metadata.h"
+#include "bench-packets.h"
 #include <iostream>
 #include <sstream>
 #include <string>
@@ -35,166 +36,6 @@
 
 using namespace ns3;
 
-/// BenchHeader class used for benchmarking packet serialization/deserialization
-template <int N>
-class BenchHeader : public Header
-{
-public:
-  BenchHeader ();
-  /**
-   * Returns true if the header has been deserialized and the 
-   * deserialization was correct.  If Deserialize() has not yet been
-   * called on the header, will return false.
-   *
-   * \returns true if success, false if failed or if deserialization not tried
-   */
-  bool IsOk (void) const;
-
-  /**
-   * Register this type.
-   * \return The TypeId.
-   */
-  static TypeId GetTypeId (void);
-  virtual TypeId GetInstanceTypeId (void) const;
-  virtual void Print (std::ostream &os) const;
-  virtual uint32_t GetSerializedSize (void) const;
-  virtual void Serialize (Buffer::Iterator start) const;
-  virtual uint32_t Deserialize (Buffer::Iterator start);
-private:
-  /**
-   * Get type name function
-   * \returns the type name string
-   */
-  static std::string GetTypeName (void);
-  bool m_ok; ///< variable to track whether deserialization succeeded
-};
-
-template <int N>
-BenchHeader<N>::BenchHeader ()
-  : m_ok (false)
-{}
-
-template <int N>
-bool 
-BenchHeader<N>::IsOk (void) const
-{
-  return m_ok;
-}
-
-template <int N>
-std::string 
-BenchHeader<N>::GetTypeName (void)
-{
-  std::ostringstream oss;
-  oss << "ns3::BenchHeader<" << N << ">";
-  return oss.str ();
-}
-
-template <int N>
-TypeId 
-BenchHeader<N>::GetTypeId (void)
-{
-  static TypeId tid = TypeId (GetTypeName ().c_str ())
-    .SetParent<Header> ()
-    .SetGroupName ("Utils")
-    .HideFromDocumentation ()
-    .AddConstructor<BenchHeader <N> > ()
-    ;
-  return tid;
-}
-template <int N>
-TypeId 
-BenchHeader<N>::GetInstanceTypeId (void) const
-{
-  return GetTypeId ();
-}
-
-template <int N>
-void 
-BenchHeader<N>::Print (std::ostream &os) const
-{
-  NS_ASSERT (false);
-}
-template <int N>
-uint32_t 
-BenchHeader<N>::GetSerializedSize (void) const
-{
-  return N;
-}
-template <int N>
-void 
-BenchHeader<N>::Serialize (Buffer::Iterator start) const
-{
-  start.WriteU8 (N, N);
-}
-template <int N>
-uint32_t
-BenchHeader<N>::Deserialize (Buffer::Iterator start)
-{
-  m_ok = true;
-  for (int i = 0; i < N; i++)
-    {
-      if (start.ReadU8 () != N)
-        {
-          m_ok = false;
-        }
-    }
-  return N;
-}
-
-/// BenchTag class used for benchmarking packet serialization/deserialization
-template <int N>
-class BenchTag : public Tag
-{
-public:
-  /**
-   * Get the bench tag name.
-   * \return the name.
-   */
-  static std::string GetName (void) {
-    std::ostringstream oss;
-    oss << "anon::BenchTag<" << N << ">";
-    return oss.str ();
-  }
-  /**
-   * Register this type.
-   * \return The TypeId.
-   */
-  static TypeId GetTypeId (void) {
-    static TypeId tid = TypeId (GetName ().c_str ())
-      .SetParent<Tag> ()
-      .SetGroupName ("Utils")
-      .HideFromDocumentation ()
-      .AddConstructor<BenchTag<N> > ()
-      ;
-    return tid;
-  }
-  virtual TypeId GetInstanceTypeId (void) const {
-    return GetTypeId ();
-  }
-  virtual uint32_t GetSerializedSize (void) const {
-    return N;
-  }
-  virtual void Serialize (TagBuffer buf) const {
-    for (uint32_t i = 0; i < N; ++i)
-      {
-        buf.WriteU8 (N);
-      }
-  }
-  virtual void Deserialize (TagBuffer buf) {
-    for (uint32_t i = 0; i < N; ++i)
-      {
-        buf.ReadU8 ();
-      }
-  }
-  virtual void Print (std::ostream &os) const {
-    os << "N=" << N;
-  }
-  BenchTag ()
-    : Tag () {}
-};
-
-
 static void 
 benchD (uint32_t n)
 {
@@ -328,6 +169,43 @@ benchByteTags (uint32_t n)
     }
 }
 
+static void
+benchByteTagsFragment (uint32_t n)
+{
+  BenchHeader<25> ipv4;
+  BenchHeader<8> udp;
+  BenchTag<4> flowId;
+  BenchTag<12> seqTs;
+
+  for (uint32_t i = 0; i < n; i++)
+    {
+      Ptr<Packet> p = Create<Packet> (1000);
+      p->AddByteTag (flowId);
+      p->AddHeader (udp);
+      p->AddByteTag (seqTs);
+      p->AddHeader (ipv4);
+
+      // Fragments share the tags of the original packet and have to
+      // trim them when the fragment headers are added
+      Ptr<Packet> frag0 = p->CreateFragment (0, 500);
+      Ptr<Packet> frag1 = p->CreateFragment (500, 533);
+      frag0->AddHeader (ipv4);
+      frag1->AddHeader (ipv4);
+      frag0->AddPaddingAtEnd (4);
+      frag1->AddPaddingAtEnd (4);
+
+      // Reassembly
+      frag0->RemoveHeader (ipv4);
+      frag1->RemoveHeader (ipv4);
+      frag0->RemoveAtEnd (4);
+      frag1->RemoveAtEnd (4);
+      frag0->AddAtEnd (frag1);
+
+      frag0->FindFirstMatchingByteTag (seqTs);
+      frag0->FindFirstMatchingByteTag (flowId);
+    }
+}
+
 static uint64_t
 runBenchOneIteration (void (*bench) (uint32_t), uint32_t n)
 {
@@ -385,6 +263,7 @@ int main (int argc, char *argv[])
   runBench (&benchD, n, minIterations, "Intermixed add/remove headers and tags");
   runBench (&benchFragment, n, minIterations, "Fragmentation and concatenation");
   runBench (&benchByteTags, n, minIterations, "Benchmark byte tags");
+  runBench (&benchByteTagsFragment, n, minIterations, "Byte tags with fragmentation and reassembly");
 
   return 0;
 }
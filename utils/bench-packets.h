@@ -0,0 +1,176 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+
+#ifndef BENCH_PACKETS_H
+#define BENCH_PACKETS_H
+
+#include "ns3/header.h"
+#include "ns3/tag.h"
+#include <sstream>
+#include <string>
+
+// Headers and tags shared by the packet benchmark programs.
+
+namespace ns3 {
+
+/// BenchHeader class used for benchmarking packet serialization/deserialization
+template <int N>
+class BenchHeader : public Header
+{
+public:
+  BenchHeader ();
+  /**
+   * Returns true if the header has been deserialized and the 
+   * deserialization was correct.  If Deserialize() has not yet been
+   * called on the header, will return false.
+   *
+   * \returns true if success, false if failed or if deserialization not tried
+   */
+  bool IsOk (void) const;
+
+  /**
+   * Register this type.
+   * \return The TypeId.
+   */
+  static TypeId GetTypeId (void);
+  virtual TypeId GetInstanceTypeId (void) const;
+  virtual void Print (std::ostream &os) const;
+  virtual uint32_t GetSerializedSize (void) const;
+  virtual void Serialize (Buffer::Iterator start) const;
+  virtual uint32_t Deserialize (Buffer::Iterator start);
+private:
+  /**
+   * Get type name function
+   * \returns the type name string
+   */
+  static std::string GetTypeName (void);
+  bool m_ok; ///< variable to track whether deserialization succeeded
+};
+
+template <int N>
+BenchHeader<N>::BenchHeader ()
+  : m_ok (false)
+{}
+
+template <int N>
+bool 
+BenchHeader<N>::IsOk (void) const
+{
+  return m_ok;
+}
+
+template <int N>
+std::string 
+BenchHeader<N>::GetTypeName (void)
+{
+  std::ostringstream oss;
+  oss << "ns3::BenchHeader<" << N << ">";
+  return oss.str ();
+}
+
+template <int N>
+TypeId 
+BenchHeader<N>::GetTypeId (void)
+{
+  static TypeId tid = TypeId (GetTypeName ().c_str ())
+    .SetParent<Header> ()
+    .SetGroupName ("Utils")
+    .HideFromDocumentation ()
+    .AddConstructor<BenchHeader <N> > ()
+    ;
+  return tid;
+}
+template <int N>
+TypeId 
+BenchHeader<N>::GetInstanceTypeId (void) const
+{
+  return GetTypeId ();
+}
+
+template <int N>
+void 
+BenchHeader<N>::Print (std::ostream &os) const
+{
+  NS_ASSERT (false);
+}
+template <int N>
+uint32_t 
+BenchHeader<N>::GetSerializedSize (void) const
+{
+  return N;
+}
+template <int N>
+void 
+BenchHeader<N>::Serialize (Buffer::Iterator start) const
+{
+  start.WriteU8 (N, N);
+}
+template <int N>
+uint32_t
+BenchHeader<N>::Deserialize (Buffer::Iterator start)
+{
+  m_ok = true;
+  for (int i = 0; i < N; i++)
+    {
+      if (start.ReadU8 () != N)
+        {
+          m_ok = false;
+        }
+    }
+  return N;
+}
+
+/// BenchTag class used for benchmarking packet serialization/deserialization
+template <int N>
+class BenchTag : public Tag
+{
+public:
+  /**
+   * Get the bench tag name.
+   * \return the name.
+   */
+  static std::string GetName (void) {
+    std::ostringstream oss;
+    oss << "anon::BenchTag<" << N << ">";
+    return oss.str ();
+  }
+  /**
+   * Register this type.
+   * \return The TypeId.
+   */
+  static TypeId GetTypeId (void) {
+    static TypeId tid = TypeId (GetName ().c_str ())
+      .SetParent<Tag> ()
+      .SetGroupName ("Utils")
+      .HideFromDocumentation ()
+      .AddConstructor<BenchTag<N> > ()
+      ;
+    return tid;
+  }
+  virtual TypeId GetInstanceTypeId (void) const {
+    return GetTypeId ();
+  }
+  virtual uint32_t GetSerializedSize (void) const {
+    return N;
+  }
+  virtual void Serialize (TagBuffer buf) const {
+    for (uint32_t i = 0; i < N; ++i)
+      {
+        buf.WriteU8 (N);
+      }
+  }
+  virtual void Deserialize (TagBuffer buf) {
+    for (uint32_t i = 0; i < N; ++i)
+      {
+        buf.ReadU8 ();
+      }
+  }
+  virtual void Print (std::ostream &os) const {
+    os << "N=" << N;
+  }
+  BenchTag ()
+    : Tag () {}
+};
+
+} // namespace ns3
+
+#endif /* BENCH_PACKETS_H */